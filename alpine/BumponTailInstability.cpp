@@ -37,9 +37,9 @@
 
 #include <Kokkos_MathematicalConstants.hpp>
 #include <Kokkos_MathematicalFunctions.hpp>
-#include <Kokkos_Random.hpp>
 #include <chrono>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <set>
 #include <string>
@@ -53,108 +53,6 @@ constexpr unsigned Dim = 3;
 
 constexpr bool EnablePhaseDump = false;
 
-template <typename T>
-struct Newton1D {
-    double tol   = 1e-12;
-    int max_iter = 20;
-    double pi    = Kokkos::numbers::pi_v<double>;
-
-    T k, delta, u;
-
-    KOKKOS_INLINE_FUNCTION Newton1D() {}
-
-    KOKKOS_INLINE_FUNCTION Newton1D(const T& k_, const T& delta_, const T& u_)
-        : k(k_)
-        , delta(delta_)
-        , u(u_) {}
-
-    KOKKOS_INLINE_FUNCTION ~Newton1D() {}
-
-    KOKKOS_INLINE_FUNCTION T f(T& x) {
-        T F;
-        F = x + (delta * (Kokkos::sin(k * x) / k)) - u;
-        return F;
-    }
-
-    KOKKOS_INLINE_FUNCTION T fprime(T& x) {
-        T Fprime;
-        Fprime = 1 + (delta * Kokkos::cos(k * x));
-        return Fprime;
-    }
-
-    KOKKOS_FUNCTION
-    void solve(T& x) {
-        int iterations = 0;
-        while (iterations < max_iter && Kokkos::fabs(f(x)) > tol) {
-            x = x - (f(x) / fprime(x));
-            iterations += 1;
-        }
-    }
-};
-
-template <typename T, class GeneratorPool, unsigned Dim>
-struct generate_random {
-    using view_type  = typename ippl::detail::ViewType<T, 1>::view_type;
-    using value_type = typename T::value_type;
-    // Output View for the random numbers
-    view_type x, v;
-
-    // The GeneratorPool
-    GeneratorPool rand_pool;
-
-    value_type delta, sigma, muBulk, muBeam;
-    size_type nlocBulk;
-
-    T k, minU, maxU;
-
-    // Initialize all members
-    generate_random(view_type x_, view_type v_, GeneratorPool rand_pool_, value_type& delta_, T& k_,
-                    value_type& sigma_, value_type& muBulk_, value_type& muBeam_,
-                    size_type& nlocBulk_, T& minU_, T& maxU_)
-        : x(x_)
-        , v(v_)
-        , rand_pool(rand_pool_)
-        , delta(delta_)
-        , sigma(sigma_)
-        , muBulk(muBulk_)
-        , muBeam(muBeam_)
-        , nlocBulk(nlocBulk_)
-        , k(k_)
-        , minU(minU_)
-        , maxU(maxU_) {}
-
-    KOKKOS_INLINE_FUNCTION void operator()(const size_t i) const {
-        // Get a random number state from the pool for the active thread
-        typename GeneratorPool::generator_type rand_gen = rand_pool.get_state();
-
-        bool isBeam = (i >= nlocBulk);
-
-        value_type muZ = (value_type)(((!isBeam) * muBulk) + (isBeam * muBeam));
-
-        if constexpr (Dim > 1) {
-            for (unsigned d = 0; d < Dim - 1; ++d) {
-                x(i)[d] = rand_gen.drand(minU[d], maxU[d]);
-                v(i)[d] = rand_gen.normal(0.0, sigma);
-            }
-        }
-        v(i)[Dim - 1] = rand_gen.normal(muZ, sigma);
-
-        value_type u  = rand_gen.drand(minU[Dim - 1], maxU[Dim - 1]);
-        x(i)[Dim - 1] = u / (1 + delta);
-        Newton1D<value_type> solver(k[Dim - 1], delta, u);
-        solver.solve(x(i)[Dim - 1]);
-
-        // Give the state back, which will allow another thread to acquire it
-        rand_pool.free_state(rand_gen);
-    }
-};
-
-double CDF(const double& x, const double& delta, const double& k, const unsigned& dim) {
-    bool isDimZ = (dim == (Dim - 1));
-    double cdf  = x + (double)(isDimZ * ((delta / k) * std::sin(k * x)));
-    return cdf;
-}
-
 KOKKOS_FUNCTION
 double PDF(const Vector_t<double, Dim>& xvec, const double& delta,
            const Vector_t<double, Dim>& kw) {
@@ -254,8 +152,6 @@ int main(int argc, char* argv[]) {
         static IpplTimings::TimerRef mainTimer        = IpplTimings::getTimer("total");
         static IpplTimings::TimerRef particleCreation = IpplTimings::getTimer("particlesCreation");
         static IpplTimings::TimerRef dumpDataTimer    = IpplTimings::getTimer("dumpData");
-        static IpplTimings::TimerRef PTimer           = IpplTimings::getTimer("pushVelocity");
-        static IpplTimings::TimerRef RTimer           = IpplTimings::getTimer("pushPosition");
         static IpplTimings::TimerRef updateTimer      = IpplTimings::getTimer("update");
         static IpplTimings::TimerRef DummySolveTimer  = IpplTimings::getTimer("solveWarmup");
         static IpplTimings::TimerRef SolveTimer       = IpplTimings::getTimer("solve");
@@ -320,6 +216,8 @@ int main(int argc, char* argv[]) {
         }
         Vector_t<double, Dim> origin = rmin;
         const double dt              = std::min(.05, 0.5 * *std::min_element(hr.begin(), hr.end()));
+        // constant charge-to-mass ratio of -1 for all particles
+        ippl::ParticlePusher<ippl::Leapfrog<>> pusher({-1.0});
 
         const bool isAllPeriodic = true;
         Mesh_t<Dim> mesh(domain, hr, origin);
@@ -341,8 +239,6 @@ int main(int argc, char* argv[]) {
 
         P->initializeFields(mesh, FL);
 
-        bunch_type bunchBuffer(PL);
-
         P->initSolver();
         P->time_m                 = 0.0;
         P->loadbalancethreshold_m = std::atof(argv[arg++]);
@@ -372,7 +268,7 @@ int main(int argc, char* argv[]) {
             Kokkos::fence();
 
             P->initializeORB(FL, mesh);
-            P->repartition(FL, mesh, bunchBuffer, isFirstRepartition);
+            P->repartition(FL, mesh, isFirstRepartition);
             IpplTimings::stopTimer(domainDecomposition);
         }
 
@@ -382,35 +278,34 @@ int main(int argc, char* argv[]) {
         typedef ippl::detail::RegionLayout<double, Dim, Mesh_t<Dim>>::uniform_type RegionLayout_t;
         const RegionLayout_t& RLayout                           = PL.getRegionLayout();
         const typename RegionLayout_t::host_mirror_type Regions = RLayout.gethLocalRegions();
-        Vector_t<double, Dim> Nr, Dr, minU, maxU;
+        Vector_t<double, Dim> locrmin, locrmax;
         int myRank = ippl::Comm->rank();
         for (unsigned d = 0; d < Dim; ++d) {
-            Nr[d] = CDF(Regions(myRank)[d].max(), delta, kw[d], d)
-                    - CDF(Regions(myRank)[d].min(), delta, kw[d], d);
-            Dr[d]   = CDF(rmax[d], delta, kw[d], d) - CDF(rmin[d], delta, kw[d], d);
-            minU[d] = CDF(Regions(myRank)[d].min(), delta, kw[d], d);
-            maxU[d] = CDF(Regions(myRank)[d].max(), delta, kw[d], d);
+            locrmin[d] = Regions(myRank)[d].min();
+            locrmax[d] = Regions(myRank)[d].max();
         }
 
-        double factorConf = 1;
-        for (unsigned d = 0; d < Dim; d++) {
-            factorConf *= Nr[d] / Dr[d];
+        // positions are perturbed along the last dimension only; the bulk and the
+        // beam are Maxwellians that differ in the mean of the last velocity component
+        using PosDist_t = ippl::random::CosinePerturbation<double>;
+        using VelDist_t = ippl::random::Normal<double>;
+        Kokkos::Array<PosDist_t, Dim> posDist;
+        Kokkos::Array<VelDist_t, Dim> bulkDist, beamDist;
+        for (unsigned d = 0; d < Dim; ++d) {
+            posDist[d]  = {d == Dim - 1 ? delta : 0.0, kw[d]};
+            bulkDist[d] = {d == Dim - 1 ? muBulk : 0.0, sigma};
+            beamDist[d] = {d == Dim - 1 ? muBeam : 0.0, sigma};
         }
-        double factorVelBulk      = 1.0 - epsilon;
-        double factorVelBeam      = 1.0 - factorVelBulk;
-        size_type nlocBulk        = (size_type)(factorConf * factorVelBulk * totalP);
-        size_type nlocBeam        = (size_type)(factorConf * factorVelBeam * totalP);
-        size_type nloc            = nlocBulk + nlocBeam;
-        size_type Total_particles = 0;
-
-        MPI_Allreduce(&nloc, &Total_particles, 1, MPI_UNSIGNED_LONG, MPI_SUM,
-                      ippl::Comm->getCommunicator());
+        const double inf = std::numeric_limits<double>::infinity();
+        ippl::random::InverseTransformSampling<double, Dim, PosDist_t> posSampler(
+            posDist, rmin, rmax, 42);
+        ippl::random::InverseTransformSampling<double, Dim, VelDist_t> bulkSampler(
+            bulkDist, Vector_t<double, Dim>(-inf), Vector_t<double, Dim>(inf), 43);
+        ippl::random::InverseTransformSampling<double, Dim, VelDist_t> beamSampler(
+            beamDist, Vector_t<double, Dim>(-inf), Vector_t<double, Dim>(inf), 44);
 
-        int rest = (int)(totalP - Total_particles);
-
-        if (ippl::Comm->rank() < rest) {
-            ++nloc;
-        }
+        size_type nloc     = posSampler.setLocalRegion(locrmin, locrmax, totalP);
+        size_type nlocBulk = (size_type)((1.0 - epsilon) * nloc);
 
         P->create(nloc);
 
@@ -424,12 +319,10 @@ int main(int argc, char* argv[]) {
                              *std::max_element(rmax.begin(), rmax.end()));
         }
 
-        Kokkos::Random_XorShift64_Pool<> rand_pool64((size_type)(42 + 100 * ippl::Comm->rank()));
+        posSampler.generate(P->R, nloc);
+        bulkSampler.generate(P->P, nlocBulk);
+        beamSampler.generate(P->P, nloc - nlocBulk, nlocBulk);
 
-        Kokkos::parallel_for(
-            nloc, generate_random<Vector_t<double, Dim>, Kokkos::Random_XorShift64_Pool<>, Dim>(
-                      P->R.getView(), P->P.getView(), rand_pool64, delta, kw, sigma, muBulk, muBeam,
-                      nlocBulk, minU, maxU));
         Kokkos::fence();
         ippl::Comm->barrier();
         IpplTimings::stopTimer(particleCreation);
@@ -451,8 +344,6 @@ int main(int argc, char* argv[]) {
         P->runSolver();
         IpplTimings::stopTimer(SolveTimer);
 
-        P->gatherCIC();
-
         IpplTimings::startTimer(dumpDataTimer);
         P->dumpBumponTail();
         P->gatherStatistics(totalP);
@@ -466,27 +357,19 @@ int main(int argc, char* argv[]) {
             // Here, we assume a constant charge-to-mass ratio of -1 for
             // all the particles hence eliminating the need to store mass as
             // an attribute
-            // kick
-
-            IpplTimings::startTimer(PTimer);
-            P->P = P->P - 0.5 * dt * P->E;
-            IpplTimings::stopTimer(PTimer);
-
-            // drift
-            IpplTimings::startTimer(RTimer);
-            P->R = P->R + dt * P->P;
-            IpplTimings::stopTimer(RTimer);
+            // kick and drift
+            pusher.kickDrift(P->E_m, P->P, P->R, 0.5 * dt, dt);
 
             // Since the particles have moved spatially update them to correct processors
             IpplTimings::startTimer(updateTimer);
-            PL.update(*P, bunchBuffer);
+            PL.update(*P);
             IpplTimings::stopTimer(updateTimer);
 
             // Domain Decomposition
             if (P->balance(totalP, it + 1)) {
                 msg << "Starting repartition" << endl;
                 IpplTimings::startTimer(domainDecomposition);
-                P->repartition(FL, mesh, bunchBuffer, isFirstRepartition);
+                P->repartition(FL, mesh, isFirstRepartition);
                 IpplTimings::stopTimer(domainDecomposition);
                 // IpplTimings::startTimer(dumpDataTimer);
                 // P->dumpLocalDomains(FL, it+1);
@@ -501,13 +384,8 @@ int main(int argc, char* argv[]) {
             P->runSolver();
             IpplTimings::stopTimer(SolveTimer);
 
-            // gather E field
-            P->gatherCIC();
-
-            // kick
-            IpplTimings::startTimer(PTimer);
-            P->P = P->P - 0.5 * dt * P->E;
-            IpplTimings::stopTimer(PTimer);
+            // gather E field and kick
+            pusher.kick(P->E_m, P->P, P->R, 0.5 * dt);
 
             P->time_m += dt;
             IpplTimings::startTimer(dumpDataTimer);
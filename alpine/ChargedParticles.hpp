@@ -244,12 +244,7 @@ public:
 public:
     ParticleAttrib<double> q;                 // charge
     typename Base::particle_position_type P;  // particle velocity
-    typename Base::particle_position_type E;  // electric field at particle position
 
-    /*
-      This constructor is mandatory for all derived classes from
-      ParticleBase as the bunch buffer uses this
-    */
     ChargedParticles(PLayout& pl)
         : Base(pl) {
         registerAttributes();
@@ -287,15 +282,13 @@ public:
         // register the particle attributes
         this->addAttribute(q);
         this->addAttribute(P);
-        this->addAttribute(E);
     }
 
     ~ChargedParticles() {}
 
     void setupBCs() { setBCAllPeriodic(); }
 
-    void updateLayout(FieldLayout_t<Dim>& fl, Mesh_t<Dim>& mesh,
-                      ChargedParticles<PLayout, T, Dim>& buffer, bool& isFirstRepartition) {
+    void updateLayout(FieldLayout_t<Dim>& fl, Mesh_t<Dim>& mesh, bool& isFirstRepartition) {
         // Update local fields
         static IpplTimings::TimerRef tupdateLayout = IpplTimings::getTimer("updateLayout");
         IpplTimings::startTimer(tupdateLayout);
@@ -313,7 +306,7 @@ public:
         static IpplTimings::TimerRef tupdatePLayout = IpplTimings::getTimer("updatePB");
         IpplTimings::startTimer(tupdatePLayout);
         if (!isFirstRepartition) {
-            layout.update(*this, buffer);
+            layout.update(*this);
         }
         IpplTimings::stopTimer(tupdatePLayout);
     }
@@ -331,8 +324,7 @@ public:
         orb.initialize(fl, mesh, rho_m);
     }
 
-    void repartition(FieldLayout_t<Dim>& fl, Mesh_t<Dim>& mesh,
-                     ChargedParticles<PLayout, T, Dim>& buffer, bool& isFirstRepartition) {
+    void repartition(FieldLayout_t<Dim>& fl, Mesh_t<Dim>& mesh, bool& isFirstRepartition) {
         // Repartition the domains
         bool res = orb.binaryRepartition(this->R, fl, isFirstRepartition);
 
@@ -341,7 +333,7 @@ public:
             return;
         }
         // Update
-        this->updateLayout(fl, mesh, buffer, isFirstRepartition);
+        this->updateLayout(fl, mesh, isFirstRepartition);
         if constexpr (Dim == 2 || Dim == 3) {
             if (stype_m == "FFT") {
                 std::get<FFTSolver_t<T, Dim>>(solver_m).setRhs(rho_m);
@@ -411,8 +403,6 @@ public:
         ippl::Comm->barrier();
     }
 
-    void gatherCIC() { gather(this->E, E_m, this->R); }
-
     void scatterCIC(size_type totalP, unsigned int iteration, Vector_t<double, Dim>& hrField) {
         Inform m("scatter ");
 
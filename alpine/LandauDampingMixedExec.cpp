@@ -170,8 +170,6 @@ int main(int argc, char* argv[]) {
         static IpplTimings::TimerRef mainTimer        = IpplTimings::getTimer("total");
         static IpplTimings::TimerRef particleCreation = IpplTimings::getTimer("particlesCreation");
         static IpplTimings::TimerRef dumpDataTimer    = IpplTimings::getTimer("dumpData");
-        static IpplTimings::TimerRef PTimer           = IpplTimings::getTimer("pushVelocity");
-        static IpplTimings::TimerRef RTimer           = IpplTimings::getTimer("pushPosition");
         static IpplTimings::TimerRef updateTimer      = IpplTimings::getTimer("update");
         static IpplTimings::TimerRef DummySolveTimer  = IpplTimings::getTimer("solveWarmup");
         static IpplTimings::TimerRef SolveTimer       = IpplTimings::getTimer("solve");
@@ -228,8 +226,6 @@ int main(int argc, char* argv[]) {
 
         P->initializeFields(mesh, FL);
 
-        bunch_type bunchBuffer(PL);
-
         P->initSolver();
         P->time_m                 = 0.0;
         P->loadbalancethreshold_m = std::atof(argv[arg++]);
@@ -237,6 +233,8 @@ int main(int argc, char* argv[]) {
         LoggingPeriod = std::atoll(argv[arg++]);
         const double dt =
             std::min(.05, 0.5 * *std::min_element(hr.begin(), hr.end())) / LoggingPeriod;
+        // constant charge-to-mass ratio of -1 for all particles
+        ippl::ParticlePusher<ippl::Leapfrog<>> pusher({-1.0});
 
         bool isFirstRepartition;
 
@@ -263,7 +261,7 @@ int main(int argc, char* argv[]) {
             Kokkos::fence();
 
             P->initializeORB(FL, mesh);
-            P->repartition(FL, mesh, bunchBuffer, isFirstRepartition);
+            P->repartition(FL, mesh, isFirstRepartition);
             IpplTimings::stopTimer(domainDecomposition);
         }
 
@@ -326,9 +324,6 @@ int main(int argc, char* argv[]) {
 
         auto Eview = P->getEMirror();
 
-        // gather E field
-        P->gatherCIC();
-
         IpplTimings::startTimer(dumpDataTimer);
         P->dumpLandau(Eview);
         P->gatherStatistics(totalP);
@@ -343,28 +338,20 @@ int main(int argc, char* argv[]) {
             // Here, we assume a constant charge-to-mass ratio of -1 for
             // all the particles hence eliminating the need to store mass as
             // an attribute
-            // kick
-
-            IpplTimings::startTimer(PTimer);
-            P->P = P->P - 0.5 * dt * P->E;
-            IpplTimings::stopTimer(PTimer);
-
-            // drift
-            IpplTimings::startTimer(RTimer);
-            P->R = P->R + dt * P->P;
-            IpplTimings::stopTimer(RTimer);
+            // kick and drift
+            pusher.kickDrift(P->E_m, P->P, P->R, 0.5 * dt, dt);
             // P->R.print();
 
             // Since the particles have moved spatially update them to correct processors
             IpplTimings::startTimer(updateTimer);
-            PL.update(*P, bunchBuffer);
+            PL.update(*P);
             IpplTimings::stopTimer(updateTimer);
 
             // Domain Decomposition
             if (P->balance(totalP, it + 1)) {
                 msg << "Starting repartition" << endl;
                 IpplTimings::startTimer(domainDecomposition);
-                P->repartition(FL, mesh, bunchBuffer, isFirstRepartition);
+                P->repartition(FL, mesh, isFirstRepartition);
                 IpplTimings::stopTimer(domainDecomposition);
                 // IpplTimings::startTimer(dumpDataTimer);
                 // P->dumpLocalDomains(FL, it+1);
@@ -394,13 +381,8 @@ int main(int argc, char* argv[]) {
                 dumpThread = std::thread(dump);
             }
 
-            // gather E field
-            P->gatherCIC();
-
-            // kick
-            IpplTimings::startTimer(PTimer);
-            P->P = P->P - 0.5 * dt * P->E;
-            IpplTimings::stopTimer(PTimer);
+            // gather E field and kick
+            pusher.kick(P->E_m, P->P, P->R, 0.5 * dt);
 
             P->time_m += dt;
             msg << "Host reached end of time step: " << it + 1 << " time: " << P->time_m << endl;
@@ -39,9 +39,9 @@
 
 #include <Kokkos_MathematicalConstants.hpp>
 #include <Kokkos_MathematicalFunctions.hpp>
-#include <Kokkos_Random.hpp>
 #include <chrono>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <set>
 #include <string>
@@ -53,93 +53,6 @@
 
 constexpr unsigned Dim = 3;
 
-template <typename T>
-struct Newton1D {
-    double tol   = 1e-12;
-    int max_iter = 20;
-    T pi         = Kokkos::numbers::pi_v<T>;
-
-    T k, alpha, u;
-
-    KOKKOS_INLINE_FUNCTION Newton1D() {}
-
-    KOKKOS_INLINE_FUNCTION Newton1D(const T& k_, const T& alpha_, const T& u_)
-        : k(k_)
-        , alpha(alpha_)
-        , u(u_) {}
-
-    KOKKOS_INLINE_FUNCTION ~Newton1D() {}
-
-    KOKKOS_INLINE_FUNCTION T f(T& x) {
-        T F;
-        F = x + (alpha * (Kokkos::sin(k * x) / k)) - u;
-        return F;
-    }
-
-    KOKKOS_INLINE_FUNCTION T fprime(T& x) {
-        T Fprime;
-        Fprime = 1 + (alpha * Kokkos::cos(k * x));
-        return Fprime;
-    }
-
-    KOKKOS_FUNCTION
-    void solve(T& x) {
-        int iterations = 0;
-        while (iterations < max_iter && Kokkos::fabs(f(x)) > tol) {
-            x = x - (f(x) / fprime(x));
-            iterations += 1;
-        }
-    }
-};
-
-template <typename T, class GeneratorPool, unsigned Dim>
-struct generate_random {
-    using view_type  = typename ippl::detail::ViewType<T, 1>::view_type;
-    using value_type = typename T::value_type;
-    // Output View for the random numbers
-    view_type x, v;
-
-    // The GeneratorPool
-    GeneratorPool rand_pool;
-
-    value_type alpha;
-
-    T k, minU, maxU;
-
-    // Initialize all members
-    generate_random(view_type x_, view_type v_, GeneratorPool rand_pool_, value_type& alpha_, T& k_,
-                    T& minU_, T& maxU_)
-        : x(x_)
-        , v(v_)
-        , rand_pool(rand_pool_)
-        , alpha(alpha_)
-        , k(k_)
-        , minU(minU_)
-        , maxU(maxU_) {}
-
-    KOKKOS_INLINE_FUNCTION void operator()(const size_t i) const {
-        // Get a random number state from the pool for the active thread
-        typename GeneratorPool::generator_type rand_gen = rand_pool.get_state();
-
-        value_type u;
-        for (unsigned d = 0; d < Dim; ++d) {
-            u       = rand_gen.drand(minU[d], maxU[d]);
-            x(i)[d] = u / (1 + alpha);
-            Newton1D<value_type> solver(k[d], alpha, u);
-            solver.solve(x(i)[d]);
-            v(i)[d] = rand_gen.normal(0.0, 1.0);
-        }
-
-        // Give the state back, which will allow another thread to acquire it
-        rand_pool.free_state(rand_gen);
-    }
-};
-
-float CDF(const float& x, const float& alpha, const float& k) {
-    float cdf = x + (alpha / k) * std::sin(k * x);
-    return cdf;
-}
-
 KOKKOS_FUNCTION
 double PDF(const Vector_t<double, Dim>& xvec, const double& alpha, const Vector_t<double, Dim>& kw,
            const unsigned Dim) {
@@ -170,8 +83,6 @@ int main(int argc, char* argv[]) {
         static IpplTimings::TimerRef mainTimer        = IpplTimings::getTimer("total");
         static IpplTimings::TimerRef particleCreation = IpplTimings::getTimer("particlesCreation");
         static IpplTimings::TimerRef dumpDataTimer    = IpplTimings::getTimer("dumpData");
-        static IpplTimings::TimerRef PTimer           = IpplTimings::getTimer("pushVelocity");
-        static IpplTimings::TimerRef RTimer           = IpplTimings::getTimer("pushPosition");
         static IpplTimings::TimerRef updateTimer      = IpplTimings::getTimer("update");
         static IpplTimings::TimerRef DummySolveTimer  = IpplTimings::getTimer("solveWarmup");
         static IpplTimings::TimerRef SolveTimer       = IpplTimings::getTimer("solve");
@@ -210,6 +121,8 @@ int main(int argc, char* argv[]) {
         double Q = std::reduce(rmax.begin(), rmax.end(), -1., std::multiplies<double>());
         Vector_t<double, Dim> origin = rmin;
         const double dt              = 0.5 * hr[0];
+        // constant charge-to-mass ratio of -1 for all particles
+        ippl::ParticlePusher<ippl::Leapfrog<>> pusher({-1.0});
 
         const bool isAllPeriodic = true;
         Mesh_t<Dim> mesh(domain, hr, origin);
@@ -223,8 +136,6 @@ int main(int argc, char* argv[]) {
 
         P->initializeFields(mesh, FL);
 
-        bunch_type bunchBuffer(PL);
-
         P->initSolver();
         P->time_m                 = 0.0;
         P->loadbalancethreshold_m = std::atof(argv[arg++]);
@@ -254,7 +165,7 @@ int main(int argc, char* argv[]) {
             Kokkos::fence();
 
             P->initializeORB(FL, mesh);
-            P->repartition(FL, mesh, bunchBuffer, isFirstRepartition);
+            P->repartition(FL, mesh, isFirstRepartition);
             IpplTimings::stopTimer(domainDecomposition);
         }
 
@@ -264,35 +175,33 @@ int main(int argc, char* argv[]) {
         typedef ippl::detail::RegionLayout<float, Dim, Mesh_t<Dim>>::uniform_type RegionLayout_t;
         const RegionLayout_t& RLayout                           = PL.getRegionLayout();
         const typename RegionLayout_t::host_mirror_type Regions = RLayout.gethLocalRegions();
-        Vector_t<float, Dim> Nr, Dr, minU, maxU;
-        int myRank   = ippl::Comm->rank();
-        float factor = 1;
+        Vector_t<float, Dim> locrmin, locrmax;
+        int myRank = ippl::Comm->rank();
         for (unsigned d = 0; d < Dim; ++d) {
-            Nr[d] = CDF(Regions(myRank)[d].max(), alpha, kw[d])
-                    - CDF(Regions(myRank)[d].min(), alpha, kw[d]);
-            Dr[d]   = CDF(rmax[d], alpha, kw[d]) - CDF(rmin[d], alpha, kw[d]);
-            minU[d] = CDF(Regions(myRank)[d].min(), alpha, kw[d]);
-            maxU[d] = CDF(Regions(myRank)[d].max(), alpha, kw[d]);
-            factor *= Nr[d] / Dr[d];
+            locrmin[d] = Regions(myRank)[d].min();
+            locrmax[d] = Regions(myRank)[d].max();
         }
 
-        size_type nloc            = (size_type)(factor * totalP);
-        size_type Total_particles = 0;
-
-        MPI_Allreduce(&nloc, &Total_particles, 1, MPI_UNSIGNED_LONG, MPI_SUM,
-                      ippl::Comm->getCommunicator());
-
-        int rest = (int)(totalP - Total_particles);
-
-        if (ippl::Comm->rank() < rest) {
-            ++nloc;
+        // positions follow the perturbed density, velocities a Maxwellian
+        using PosDist_t = ippl::random::CosinePerturbation<float>;
+        using VelDist_t = ippl::random::Normal<float>;
+        Kokkos::Array<PosDist_t, Dim> posDist;
+        Kokkos::Array<VelDist_t, Dim> velDist;
+        for (unsigned d = 0; d < Dim; ++d) {
+            posDist[d] = {alpha, kw[d]};
+            velDist[d] = {0.0, 1.0};
         }
+        const float inf = std::numeric_limits<float>::infinity();
+        ippl::random::InverseTransformSampling<float, Dim, PosDist_t> posSampler(
+            posDist, rmin, rmax, 42);
+        ippl::random::InverseTransformSampling<float, Dim, VelDist_t> velSampler(
+            velDist, Vector_t<float, Dim>(-inf), Vector_t<float, Dim>(inf), 43);
+
+        size_type nloc = posSampler.setLocalRegion(locrmin, locrmax, totalP);
 
         P->create(nloc);
-        Kokkos::Random_XorShift64_Pool<> rand_pool64((size_type)(42 + 100 * ippl::Comm->rank()));
-        Kokkos::parallel_for(
-            nloc, generate_random<Vector_t<float, Dim>, Kokkos::Random_XorShift64_Pool<>, Dim>(
-                      P->R.getView(), P->P.getView(), rand_pool64, alpha, kw, minU, maxU));
+        posSampler.generate(P->R, nloc);
+        velSampler.generate(P->P, nloc);
 
         Kokkos::fence();
         ippl::Comm->barrier();
@@ -317,9 +226,6 @@ int main(int argc, char* argv[]) {
 
         auto Eview = P->getEMirror();
 
-        // gather E field
-        P->gatherCIC();
-
         IpplTimings::startTimer(dumpDataTimer);
         P->dumpLandau(Eview);
         P->gatherStatistics(totalP);
@@ -333,27 +239,19 @@ int main(int argc, char* argv[]) {
             // Here, we assume a constant charge-to-mass ratio of -1 for
             // all the particles hence eliminating the need to store mass as
             // an attribute
-            // kick
-
-            IpplTimings::startTimer(PTimer);
-            P->P = P->P - 0.5 * dt * P->E;
-            IpplTimings::stopTimer(PTimer);
-
-            // drift
-            IpplTimings::startTimer(RTimer);
-            P->R = P->R + dt * P->P;
-            IpplTimings::stopTimer(RTimer);
+            // kick and drift
+            pusher.kickDrift(P->E_m, P->P, P->R, 0.5 * dt, dt);
 
             // Since the particles have moved spatially update them to correct processors
             IpplTimings::startTimer(updateTimer);
-            PL.update(*P, bunchBuffer);
+            PL.update(*P);
             IpplTimings::stopTimer(updateTimer);
 
             // Domain Decomposition
             if (P->balance(totalP, it + 1)) {
                 msg << "Starting repartition" << endl;
                 IpplTimings::startTimer(domainDecomposition);
-                P->repartition(FL, mesh, bunchBuffer, isFirstRepartition);
+                P->repartition(FL, mesh, isFirstRepartition);
                 IpplTimings::stopTimer(domainDecomposition);
                 // IpplTimings::startTimer(dumpDataTimer);
                 // P->dumpLocalDomains(FL, it+1);
@@ -370,13 +268,8 @@ int main(int argc, char* argv[]) {
 
             P->updateEMirror(Eview);
 
-            // gather E field
-            P->gatherCIC();
-
-            // kick
-            IpplTimings::startTimer(PTimer);
-            P->P = P->P - 0.5 * dt * P->E;
-            IpplTimings::stopTimer(PTimer);
+            // gather E field and kick
+            pusher.kick(P->E_m, P->P, P->R, 0.5 * dt);
 
             P->time_m += dt;
             IpplTimings::startTimer(dumpDataTimer);
@@ -149,6 +149,36 @@ double PDF(const Vector_t<double, Dim>& xvec, const Vector_t<double, Dim>& mu,
     return pdf;
 }
 
+// Electric field of the trap electrodes
+struct TrapField {
+    double V0;
+    Vector_t<double, Dim> origin, length;
+
+    template <typename VectorType>
+    KOKKOS_INLINE_FUNCTION VectorType operator()(const VectorType& R, double /*time*/) const {
+        const double c = V0 / (2 * length[2] * length[2]);
+
+        VectorType E;
+        E[0] = -(R[0] - origin[0] - 0.5 * length[0]) * c;
+        E[1] = -(R[1] - origin[1] - 0.5 * length[1]) * c;
+        E[2] = 2 * (R[2] - origin[2] - 0.5 * length[2]) * c;
+        return E;
+    }
+};
+
+// Uniform magnetic field along z
+struct AxialField {
+    double Bz;
+
+    template <typename VectorType>
+    KOKKOS_INLINE_FUNCTION VectorType operator()(const VectorType& /*R*/,
+                                                 double /*time*/) const {
+        VectorType B(0);
+        B[2] = Bz;
+        return B;
+    }
+};
+
 const char* TestName = "PenningTrap";
 
 int main(int argc, char* argv[]) {
@@ -167,8 +197,6 @@ int main(int argc, char* argv[]) {
         static IpplTimings::TimerRef mainTimer        = IpplTimings::getTimer("total");
         static IpplTimings::TimerRef particleCreation = IpplTimings::getTimer("particlesCreation");
         static IpplTimings::TimerRef dumpDataTimer    = IpplTimings::getTimer("dumpData");
-        static IpplTimings::TimerRef PTimer           = IpplTimings::getTimer("pushVelocity");
-        static IpplTimings::TimerRef RTimer           = IpplTimings::getTimer("pushPosition");
         static IpplTimings::TimerRef updateTimer      = IpplTimings::getTimer("update");
         static IpplTimings::TimerRef DummySolveTimer  = IpplTimings::getTimer("solveWarmup");
         static IpplTimings::TimerRef SolveTimer       = IpplTimings::getTimer("Solve");
@@ -230,8 +258,6 @@ int main(int argc, char* argv[]) {
 
         P->initializeFields(mesh, FL);
 
-        bunch_type bunchBuffer(PL);
-
         P->initSolver();
         P->time_m                 = 0.0;
         P->loadbalancethreshold_m = std::atof(argv[7]);
@@ -265,7 +291,7 @@ int main(int argc, char* argv[]) {
             Kokkos::fence();
 
             P->initializeORB(FL, mesh);
-            P->repartition(FL, mesh, bunchBuffer, isFirstRepartition);
+            P->repartition(FL, mesh, isFirstRepartition);
             IpplTimings::stopTimer(domainDecomposition);
         }
 
@@ -324,66 +350,38 @@ int main(int argc, char* argv[]) {
         P->runSolver();
         IpplTimings::stopTimer(SolveTimer);
 
-        P->gatherCIC();
-
         IpplTimings::startTimer(dumpDataTimer);
         P->dumpData();
         P->gatherStatistics(totalP);
         // P->dumpLocalDomains(FL, 0);
         IpplTimings::stopTimer(dumpDataTimer);
 
-        double alpha = -0.5 * dt;
-        double DrInv = 1.0 / (1 + (std::pow((alpha * Bext), 2)));
+        // Boris push in the field of the electrodes and the axial magnetic field
+        using scheme_type = ippl::Boris<TrapField, AxialField>;
+        TrapField trapField{30 * length[2], origin, length};
+        ippl::ParticlePusher<scheme_type> pusher(scheme_type{-1.0, trapField, AxialField{Bext}});
+
         // begin main timestep loop
         msg << "Starting iterations ..." << endl;
         for (unsigned int it = 0; it < nt; it++) {
-            // Staggered Leap frog or Boris algorithm as per
+            // Kick-drift-kick with the Boris rotation as the kick, see e.g.
             // https://www.sciencedirect.com/science/article/pii/S2590055219300526
-            // eqns 4(a)-4(c). Note we don't use the Boris trick here and do
-            // the analytical matrix inversion which is not complex in this case.
             // Here, we assume a constant charge-to-mass ratio of -1 for
             // all the particles hence eliminating the need to store mass as
             // an attribute
-            // kick
-            IpplTimings::startTimer(PTimer);
-            auto Rview = P->R.getView();
-            auto Pview = P->P.getView();
-            auto Eview = P->E.getView();
-            double V0  = 30 * length[2];
-            Kokkos::parallel_for(
-                "Kick1", P->getLocalNum(), KOKKOS_LAMBDA(const size_t j) {
-                    double Eext_x =
-                        -(Rview(j)[0] - origin[0] - 0.5 * length[0]) * (V0 / (2 * Kokkos::pow(length[2], 2)));
-                    double Eext_y =
-                        -(Rview(j)[1] - origin[1] - 0.5 * length[1]) * (V0 / (2 * Kokkos::pow(length[2], 2)));
-                    double Eext_z =
-                        (Rview(j)[2] - origin[2] - 0.5 * length[2]) * (V0 / (Kokkos::pow(length[2], 2)));
-
-                    Eview(j)[0] += Eext_x;
-                    Eview(j)[1] += Eext_y;
-                    Eview(j)[2] += Eext_z;
-
-                    Pview(j)[0] += alpha * (Eview(j)[0] + Pview(j)[1] * Bext);
-                    Pview(j)[1] += alpha * (Eview(j)[1] - Pview(j)[0] * Bext);
-                    Pview(j)[2] += alpha * Eview(j)[2];
-                });
-            IpplTimings::stopTimer(PTimer);
-
-            // drift
-            IpplTimings::startTimer(RTimer);
-            P->R = P->R + dt * P->P;
-            IpplTimings::stopTimer(RTimer);
+            // kick and drift
+            pusher.kickDrift(P->E_m, P->P, P->R, 0.5 * dt, dt, P->time_m);
 
             // Since the particles have moved spatially update them to correct processors
             IpplTimings::startTimer(updateTimer);
-            PL.update(*P, bunchBuffer);
+            PL.update(*P);
             IpplTimings::stopTimer(updateTimer);
 
             // Domain Decomposition
             if (P->balance(totalP, it + 1)) {
                 msg << "Starting repartition" << endl;
                 IpplTimings::startTimer(domainDecomposition);
-                P->repartition(FL, mesh, bunchBuffer, isFirstRepartition);
+                P->repartition(FL, mesh, isFirstRepartition);
                 IpplTimings::stopTimer(domainDecomposition);
                 // IpplTimings::startTimer(dumpDataTimer);
                 // P->dumpLocalDomains(FL, it+1);
@@ -398,39 +396,8 @@ int main(int argc, char* argv[]) {
             P->runSolver();
             IpplTimings::stopTimer(SolveTimer);
 
-            // gather E field
-            P->gatherCIC();
-
-            // kick
-            IpplTimings::startTimer(PTimer);
-            auto R2view = P->R.getView();
-            auto P2view = P->P.getView();
-            auto E2view = P->E.getView();
-            Kokkos::parallel_for(
-                "Kick2", P->getLocalNum(), KOKKOS_LAMBDA(const size_t j) {
-                    double Eext_x =
-                        -(R2view(j)[0] - origin[0] - 0.5 * length[0]) * (V0 / (2 * Kokkos::pow(length[2], 2)));
-                    double Eext_y =
-                        -(R2view(j)[1] - origin[1] - 0.5 * length[1]) * (V0 / (2 * Kokkos::pow(length[2], 2)));
-                    double Eext_z =
-                        (R2view(j)[2] - origin[2] - 0.5 * length[2]) * (V0 / (Kokkos::pow(length[2], 2)));
-
-                    E2view(j)[0] += Eext_x;
-                    E2view(j)[1] += Eext_y;
-                    E2view(j)[2] += Eext_z;
-                    P2view(j)[0] = DrInv
-                                   * (P2view(j)[0]
-                                      + alpha
-                                            * (E2view(j)[0] + P2view(j)[1] * Bext
-                                               + alpha * Bext * E2view(j)[1]));
-                    P2view(j)[1] = DrInv
-                                   * (P2view(j)[1]
-                                      + alpha
-                                            * (E2view(j)[1] - P2view(j)[0] * Bext
-                                               - alpha * Bext * E2view(j)[0]));
-                    P2view(j)[2] += alpha * E2view(j)[2];
-                });
-            IpplTimings::stopTimer(PTimer);
+            // gather E field and kick
+            pusher.kick(P->E_m, P->P, P->R, 0.5 * dt, P->time_m + dt);
 
             P->time_m += dt;
             IpplTimings::startTimer(dumpDataTimer);
@@ -95,9 +95,7 @@ int main(int argc, char* argv[]) {
         static IpplTimings::TimerRef mainTimer        = IpplTimings::getTimer("total");
         static IpplTimings::TimerRef particleCreation = IpplTimings::getTimer("particlesCreation");
         static IpplTimings::TimerRef dumpDataTimer    = IpplTimings::getTimer("dumpData");
-        static IpplTimings::TimerRef PTimer           = IpplTimings::getTimer("pushVelocity");
         static IpplTimings::TimerRef temp             = IpplTimings::getTimer("randomMove");
-        static IpplTimings::TimerRef RTimer           = IpplTimings::getTimer("pushPosition");
         static IpplTimings::TimerRef updateTimer      = IpplTimings::getTimer("update");
         static IpplTimings::TimerRef DummySolveTimer  = IpplTimings::getTimer("solveWarmup");
         static IpplTimings::TimerRef SolveTimer       = IpplTimings::getTimer("solve");
@@ -127,6 +125,8 @@ int main(int argc, char* argv[]) {
         Vector_t<double, Dim> hr;
         Vector_t<double, Dim> origin = rmin;
         const double dt              = 1.0;
+        // constant charge-to-mass ratio of -1 for all particles
+        ippl::ParticlePusher<ippl::Leapfrog<>> pusher({-1.0});
 
         ippl::e_dim_tag decomp[Dim];
         for (unsigned d = 0; d < Dim; ++d) {
@@ -172,10 +172,8 @@ int main(int argc, char* argv[]) {
 
         P->initializeFields(mesh, FL);
 
-        bunch_type bunchBuffer(PL);
-
         IpplTimings::startTimer(updateTimer);
-        PL.update(*P, bunchBuffer);
+        PL.update(*P);
         IpplTimings::stopTimer(updateTimer);
 
         msg << "particles created and initial conditions assigned " << endl;
@@ -197,8 +195,6 @@ int main(int argc, char* argv[]) {
         P->runSolver();
         IpplTimings::stopTimer(SolveTimer);
 
-        P->gatherCIC();
-
         IpplTimings::startTimer(dumpDataTimer);
         P->dumpData();
         P->gatherStatistics(totalP);
@@ -213,9 +209,7 @@ int main(int argc, char* argv[]) {
             // all the particles hence eliminating the need to store mass as
             // an attribute
             // kick
-            IpplTimings::startTimer(PTimer);
-            P->P = P->P - 0.5 * dt * P->E;
-            IpplTimings::stopTimer(PTimer);
+            pusher.kick(P->E_m, P->P, P->R, 0.5 * dt);
 
             IpplTimings::startTimer(temp);
             Kokkos::parallel_for(
@@ -226,20 +220,18 @@ int main(int argc, char* argv[]) {
             IpplTimings::stopTimer(temp);
 
             // drift
-            IpplTimings::startTimer(RTimer);
-            P->R = P->R + dt * P->P;
-            IpplTimings::stopTimer(RTimer);
+            pusher.drift(P->P, P->R, dt);
 
             // Since the particles have moved spatially update them to correct processors
             IpplTimings::startTimer(updateTimer);
-            PL.update(*P, bunchBuffer);
+            PL.update(*P);
             IpplTimings::stopTimer(updateTimer);
 
             // Domain Decomposition
             if (P->balance(totalP, it + 1)) {
                 msg << "Starting repartition" << endl;
                 IpplTimings::startTimer(domainDecomposition);
-                P->repartition(FL, mesh, bunchBuffer, fromAnalyticDensity);
+                P->repartition(FL, mesh, fromAnalyticDensity);
                 IpplTimings::stopTimer(domainDecomposition);
             }
 
@@ -251,13 +243,8 @@ int main(int argc, char* argv[]) {
             P->runSolver();
             IpplTimings::stopTimer(SolveTimer);
 
-            // gather E field
-            P->gatherCIC();
-
-            // kick
-            IpplTimings::startTimer(PTimer);
-            P->P = P->P - 0.5 * dt * P->E;
-            IpplTimings::stopTimer(PTimer);
+            // gather E field and kick
+            pusher.kick(P->E_m, P->P, P->R, 0.5 * dt);
 
             P->time_m += dt;
             IpplTimings::startTimer(dumpDataTimer);
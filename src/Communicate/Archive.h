@@ -32,6 +32,19 @@
 
 namespace ippl {
     namespace detail {
+        /*!
+         * Type-erased description of an array, used to (de)serialize several
+         * arrays with different value types in one kernel
+         */
+        struct ByteView {
+            //! start of the array
+            char* data;
+            //! bytes per element
+            size_type size;
+            //! sum of the element sizes of all arrays preceding this one in a message
+            size_type offset;
+        };
+
         /*!
          * @file Archive.h
          * Serialize and desesrialize particle attributes.
@@ -65,6 +78,18 @@ namespace ippl {
             void serialize(const Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view,
                            size_type nsends);
 
+            /*!
+             * Serialize the elements selected by an index map from several arrays
+             * of arbitrary types in a single kernel; the data of each array is
+             * stored contiguously, one array after the other.
+             * @param views the arrays to take data from
+             * @param size the total number of bytes per element over all arrays
+             * @param hash indices of the elements to serialize
+             */
+            template <class... DescArgs, class... HashArgs>
+            void serialize(const Kokkos::View<ByteView*, DescArgs...>& views, size_type size,
+                           const Kokkos::View<int*, HashArgs...>& hash);
+
             /*!
              * Deserialize.
              * @param view to put data to
@@ -83,6 +108,19 @@ namespace ippl {
             template <typename T, unsigned Dim, class... ViewArgs>
             void deserialize(Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view, size_type nrecvs);
 
+            /*!
+             * Deserialize data written by the fused serialization into several
+             * arrays in a single kernel
+             * @param views the arrays to put data to; they must have room for
+             * offset + nrecvs elements
+             * @param size the total number of bytes per element over all arrays
+             * @param offset the index at which the first element is stored
+             * @param nrecvs the number of elements per array
+             */
+            template <class... DescArgs>
+            void deserialize(const Kokkos::View<ByteView*, DescArgs...>& views, size_type size,
+                             size_type offset, size_type nrecvs);
+
             /*!
              * @returns a pointer to the data of the buffer
              */
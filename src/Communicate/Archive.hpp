@@ -71,6 +71,32 @@ namespace ippl {
             writepos_m += Dim * size * nsends;
         }
 
+        template <class... Properties>
+        template <class... DescArgs, class... HashArgs>
+        void Archive<Properties...>::serialize(const Kokkos::View<ByteView*, DescArgs...>& views,
+                                               size_type size,
+                                               const Kokkos::View<int*, HashArgs...>& hash) {
+            using exec_space = typename Kokkos::View<int*, HashArgs...>::execution_space;
+
+            size_type nsends = hash.extent(0);
+            size_type nviews = views.extent(0);
+            if (nsends == 0 || nviews == 0) {
+                return;
+            }
+
+            using mdrange_t =
+                Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::IndexType<size_type>, exec_space>;
+            Kokkos::parallel_for(
+                "Archive::serialize()", mdrange_t({0, 0}, {(long int)nsends, (long int)nviews}),
+                KOKKOS_CLASS_LAMBDA(const size_type i, const size_type a) {
+                    const ByteView& v = views(a);
+                    std::memcpy(buffer_m.data() + writepos_m + nsends * v.offset + i * v.size,
+                                v.data + hash(i) * v.size, v.size);
+                });
+            Kokkos::fence();
+            writepos_m += size * nsends;
+        }
+
         template <class... Properties>
         template <typename T, class... ViewArgs>
         void Archive<Properties...>::deserialize(Kokkos::View<T*, ViewArgs...>& view,
@@ -114,5 +140,31 @@ namespace ippl {
             Kokkos::fence();
             readpos_m += Dim * size * nrecvs;
         }
+
+        template <class... Properties>
+        template <class... DescArgs>
+        void Archive<Properties...>::deserialize(const Kokkos::View<ByteView*, DescArgs...>& views,
+                                                 size_type size, size_type offset,
+                                                 size_type nrecvs) {
+            using exec_space = typename Kokkos::View<ByteView*, DescArgs...>::execution_space;
+
+            size_type nviews = views.extent(0);
+            if (nrecvs == 0 || nviews == 0) {
+                return;
+            }
+
+            using mdrange_t =
+                Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::IndexType<size_type>, exec_space>;
+            Kokkos::parallel_for(
+                "Archive::deserialize()", mdrange_t({0, 0}, {(long int)nrecvs, (long int)nviews}),
+                KOKKOS_CLASS_LAMBDA(const size_type i, const size_type a) {
+                    const ByteView& v = views(a);
+                    std::memcpy(v.data + (offset + i) * v.size,
+                                buffer_m.data() + readpos_m + nrecvs * v.offset + i * v.size,
+                                v.size);
+                });
+            Kokkos::fence();
+            readpos_m += size * nrecvs;
+        }
     }  // namespace detail
 }  // namespace ippl
@@ -16,8 +16,9 @@
 //   the requested size.
 //
 //   Currently, the buffer factory is used for application of periodic boundary
-//   conditions; halo cell exchange along faces, edges, and vertices; as well as
-//   exchanging particle data between ranks.
+//   conditions, for exchanging particle data between ranks and for the batched
+//   halo exchange of several fields (see HaloBatch). The halo exchange of a single
+//   field keeps its own persistent buffers (see HaloSchedule).
 //
 // Copyright (c) 2021 Paul Scherrer Institut, Villigen PSI, Switzerland
 // All rights reserved
@@ -33,12 +33,21 @@ namespace ippl {
         MPI_Finalize();
     }
 
-    void Communicate::irecv(int src, int tag, archive_type<>& ar, MPI_Request& request,
-                            size_type msize) {
+    void Communicate::sendInit(int dest, int tag, const void* buffer, size_type msize,
+                               MPI_Request& request) {
         if (msize > INT_MAX) {
             std::cerr << "Message size exceeds range of int" << std::endl;
             this->abort();
         }
-        MPI_Irecv(ar.getBuffer(), msize, MPI_BYTE, src, tag, comm_m, &request);
+        MPI_Send_init(buffer, msize, MPI_BYTE, dest, tag, comm_m, &request);
+    }
+
+    void Communicate::recvInit(int src, int tag, void* buffer, size_type msize,
+                               MPI_Request& request) {
+        if (msize > INT_MAX) {
+            std::cerr << "Message size exceeds range of int" << std::endl;
+            this->abort();
+        }
+        MPI_Recv_init(buffer, msize, MPI_BYTE, src, tag, comm_m, &request);
     }
 }  // namespace ippl
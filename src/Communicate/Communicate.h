@@ -126,9 +126,38 @@ namespace ippl {
         void isend(int dest, int tag, Buffer& buffer, Archive&, MPI_Request&, size_type nsends);
 
         /*!
-         * \warning Only works with default spaces!
+         * Send the data already serialized into an archive
+         * @param dest the destination rank
+         * @param tag the MPI tag
+         * @param ar the archive holding the message
+         * @param request the request of the non-blocking send
          */
-        void irecv(int src, int tag, archive_type<>&, MPI_Request&, size_type msize);
+        template <typename MemorySpace>
+        void isend(int dest, int tag, archive_type<MemorySpace>& ar, MPI_Request& request);
+
+        template <typename MemorySpace>
+        void irecv(int src, int tag, archive_type<MemorySpace>&, MPI_Request&, size_type msize);
+
+        /*!
+         * Create a persistent send request; the message is sent on every MPI_Start
+         * @param dest the destination rank
+         * @param tag the MPI tag
+         * @param buffer the message, which must not move while the request exists
+         * @param msize the size of the message in bytes
+         * @param request the persistent request, to be freed with MPI_Request_free
+         */
+        void sendInit(int dest, int tag, const void* buffer, size_type msize,
+                      MPI_Request& request);
+
+        /*!
+         * Create a persistent receive request; a message is received on every MPI_Start
+         * @param src the source rank
+         * @param tag the MPI tag
+         * @param buffer the receive buffer, which must not move while the request exists
+         * @param msize the size of the message in bytes
+         * @param request the persistent request, to be freed with MPI_Request_free
+         */
+        void recvInit(int src, int tag, void* buffer, size_type msize, MPI_Request& request);
 
         const MPI_Comm& getCommunicator() const noexcept { return comm_m; }
 
@@ -177,6 +206,26 @@ namespace ippl {
         buffer.serialize(ar, nsends);
         MPI_Isend(ar.getBuffer(), ar.getSize(), MPI_BYTE, dest, tag, comm_m, &request);
     }
+
+    template <typename MemorySpace>
+    void Communicate::isend(int dest, int tag, archive_type<MemorySpace>& ar,
+                            MPI_Request& request) {
+        if (ar.getSize() > INT_MAX) {
+            std::cerr << "Message size exceeds range of int" << std::endl;
+            this->abort();
+        }
+        MPI_Isend(ar.getBuffer(), ar.getSize(), MPI_BYTE, dest, tag, comm_m, &request);
+    }
+
+    template <typename MemorySpace>
+    void Communicate::irecv(int src, int tag, archive_type<MemorySpace>& ar, MPI_Request& request,
+                            size_type msize) {
+        if (msize > INT_MAX) {
+            std::cerr << "Message size exceeds range of int" << std::endl;
+            this->abort();
+        }
+        MPI_Irecv(ar.getBuffer(), msize, MPI_BYTE, src, tag, comm_m, &request);
+    }
 }  // namespace ippl
 
 #include "Communicate/Buffers.hpp"
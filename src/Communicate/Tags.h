@@ -40,6 +40,8 @@
 namespace ippl {
     namespace detail {
 #define HALO_TAG       100000
+#define HALO_SWEEP_TAG 150000
+#define HALO_BATCH_TAG 160000
 #define HALO_TAG_CYCLE 100000
     }  // namespace detail
 }  // namespace ippl
@@ -77,6 +79,7 @@ namespace ippl {
 #define P_SPATIAL_GHOST_TAG     56000
 #define P_SPATIAL_RANGE_TAG     57000
 #define P_RESET_ID_TAG          58000
+#define P_SPATIAL_COUNT_TAG     59000
 #define P_LAYOUT_CYCLE          1000
 
 // Tags for Ippl setup
@@ -108,6 +111,7 @@ namespace ippl {
 // Particle spatial layout
 #define IPPL_PARTICLE_SEND      9000
 #define IPPL_PARTICLE_RECV      10000
+#define IPPL_PARTICLE_SORT      11000
 
 // FFT Poisson Solver
 #define IPPL_SOLVER_SEND        13000
@@ -283,18 +283,18 @@ namespace ippl {
         const vector_type& origin = mesh.getOrigin();
         const vector_type invdx   = 1.0 / dx;
 
+        detail::StencilMap<CIC, Tf, Dim, vector_type> map{origin, invdx, lDom.first() - nghost};
+
+        const auto dead = r.getDeadMask();
         Kokkos::parallel_for(
             "ParticleAttrib::scatterR", r.getParticleCount(), KOKKOS_LAMBDA(const size_t idx) {
-                // Find nearest grid point
-                Vector<Tp, Dim> l      = (r(idx) - origin) * invdx + 0.5;
-                Vector<int, Dim> index = l;
-                Vector<Tf, Dim> whi    = l - index;
-                Vector<Tf, Dim> wlo    = 1.0 - whi;
-
-                Vector<size_t, Dim> args = index - lDom.first() + nghost;
+                if (detail::isDead(dead, idx)) {
+                    return;
+                }
+                const auto stencil = map(r(idx));
 
                 // Scatter
-                scatterToField(std::make_index_sequence<1 << Dim>{}, view, wlo, whi, args);
+                scatterToField(detail::stencil_sequence<CIC, Dim>{}, view, stencil);
             });
 
         bf_m.accumulateHalo();
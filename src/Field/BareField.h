@@ -139,8 +139,62 @@ namespace ippl {
 
         void fillHalo();
 
+        /*!
+         * Start filling the halo cells; the ghost layers must not be read before
+         * endFillHalo is called, but the owned cells can be
+         */
+        void beginFillHalo();
+
+        /*!
+         * Complete filling the halo cells started with beginFillHalo
+         */
+        void endFillHalo();
+
+        /*!
+         * @returns true if beginFillHalo was called without endFillHalo
+         */
+        bool isHaloPending() const { return halo_m.isPending(); }
+
         void accumulateHalo();
 
+        /*!
+         * @returns true if the halo cells and the boundary conditions are current,
+         * in which case the differential operators do not refresh them
+         */
+        bool isHaloValid() const { return halo_m.isValid(); }
+
+        /*!
+         * Mark the halo cells as outdated. This is done by operator=, the mutable
+         * getView, the halo exchanges and resizing; call it after writing to the
+         * data in any other way, e.g. through a view kept from an earlier getView.
+         */
+        void invalidateHalo() { halo_m.setValid(false); }
+
+        /*!
+         * @returns the number of halo refreshes done by the differential operators
+         * since the counters were last reset
+         */
+        detail::size_type getHaloRefreshCount() const { return halo_m.getRefreshCount(); }
+
+        /*!
+         * @returns the number of halo refreshes skipped by the differential
+         * operators because the halo cells were valid
+         */
+        detail::size_type getSkippedHaloRefreshCount() const {
+            return halo_m.getSkippedRefreshCount();
+        }
+
+        void resetHaloCounters() { halo_m.resetRefreshCounters(); }
+
+        /*!
+         * Select the communication pattern of the halo exchanges of this field,
+         * which defaults to ippl::defaultHaloExchange
+         * @param mode the pattern
+         */
+        void setHaloExchange(HaloExchange mode) { halo_m.setExchangeMode(mode); }
+
+        HaloExchange getHaloExchange() const { return halo_m.getExchangeMode(); }
+
         // Access to the layout.
         Layout_t& getLayout() const {
             PAssert(layout_m != 0);
@@ -165,6 +219,26 @@ namespace ippl {
         template <typename E, size_t N>
         BareField& operator=(const detail::Expression<E, N>& expr);
 
+        /*!
+         * Assign an expression on the interior of the local domain, i.e. on the
+         * points at least width cells away from its boundary. Together with
+         * assignBoundary, this is the same as operator=, but stencils of radius up
+         * to width can be computed on the interior before the halo cells are filled.
+         * @param expr is the expression
+         * @param width the width of the boundary shell
+         */
+        template <typename E, size_t N>
+        void assignInterior(const detail::Expression<E, N>& expr, int width);
+
+        /*!
+         * Assign an expression on the boundary shell of the local domain, i.e. on
+         * the points less than width cells away from its boundary.
+         * @param expr is the expression
+         * @param width the width of the boundary shell
+         */
+        template <typename E, size_t N>
+        void assignBoundary(const detail::Expression<E, N>& expr, int width);
+
         /*!
          * Assign another field.
          * @tparam Args... variadic template to specify an access index for
@@ -177,7 +251,11 @@ namespace ippl {
             return dview_m(args...);
         }
 
-        view_type& getView() { return dview_m; }
+        view_type& getView() {
+            // the caller may write to the data
+            invalidateHalo();
+            return dview_m;
+        }
 
         const view_type& getView() const { return dview_m; }
 
@@ -232,6 +310,16 @@ namespace ippl {
          */
         void setup();
 
+        using index_type = typename RangePolicy<Dim, execution_space>::index_type;
+
+        /*!
+         * Assign an expression on the index range [begin, end) of the view
+         */
+        template <typename E, size_t N>
+        void assignRange(const detail::Expression<E, N>& expr,
+                         const Kokkos::Array<index_type, Dim>& begin,
+                         const Kokkos::Array<index_type, Dim>& end);
+
         //! How the arrays are laid out.
         Layout_t* layout_m;
     };
@@ -240,5 +328,6 @@ namespace ippl {
 
 #include "Field/BareField.hpp"
 #include "Field/BareFieldOperations.hpp"
+#include "Field/HaloBatch.hpp"
 
 #endif
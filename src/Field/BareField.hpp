@@ -17,6 +17,7 @@
 //
 #include "Ippl.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <map>
 #include <utility>
@@ -83,15 +84,28 @@ namespace ippl {
     template <typename T, unsigned Dim, class... ViewArgs>
     template <typename... Args>
     void BareField<T, Dim, ViewArgs...>::resize(Args... args) {
+        invalidateHalo();
         Kokkos::resize(dview_m, args...);
     }
 
     template <typename T, unsigned Dim, class... ViewArgs>
     void BareField<T, Dim, ViewArgs...>::fillHalo() {
-        if (Comm->size() > 1) {
-            halo_m.fillHalo(dview_m, layout_m);
-        }
-        if (layout_m->isAllPeriodic_m) {
+        beginFillHalo();
+        endFillHalo();
+    }
+
+    template <typename T, unsigned Dim, class... ViewArgs>
+    void BareField<T, Dim, ViewArgs...>::beginFillHalo() {
+        // the boundary conditions are applied after the exchange, if at all
+        invalidateHalo();
+        halo_m.beginFillHalo(dview_m, layout_m);
+    }
+
+    template <typename T, unsigned Dim, class... ViewArgs>
+    void BareField<T, Dim, ViewArgs...>::endFillHalo() {
+        halo_m.endFillHalo(dview_m);
+        // the sweep fills the periodic serial dimensions itself
+        if (layout_m->isAllPeriodic_m && getHaloExchange() == HaloExchange::NEIGHBOR) {
             using Op = typename detail::HaloCells<T, Dim, ViewArgs...>::assign;
             halo_m.template applyPeriodicSerialDim<Op>(dview_m, layout_m, nghost_m);
         }
@@ -99,6 +113,12 @@ namespace ippl {
 
     template <typename T, unsigned Dim, class... ViewArgs>
     void BareField<T, Dim, ViewArgs...>::accumulateHalo() {
+        invalidateHalo();
+        if (getHaloExchange() == HaloExchange::SWEEP) {
+            // the sweep accumulates the periodic serial dimensions itself
+            halo_m.accumulateHalo(dview_m, layout_m);
+            return;
+        }
         if (Comm->size() > 1) {
             halo_m.accumulateHalo(dview_m, layout_m);
         }
@@ -110,6 +130,7 @@ namespace ippl {
 
     template <typename T, unsigned Dim, class... ViewArgs>
     BareField<T, Dim, ViewArgs...>& BareField<T, Dim, ViewArgs...>::operator=(T x) {
+        invalidateHalo();
         using index_array_type = typename RangePolicy<Dim, execution_space>::index_array_type;
         ippl::parallel_for(
             "BareField::operator=(T)", getRangePolicy(dview_m),
@@ -121,6 +142,7 @@ namespace ippl {
     template <typename E, size_t N>
     BareField<T, Dim, ViewArgs...>& BareField<T, Dim, ViewArgs...>::operator=(
         const detail::Expression<E, N>& expr) {
+        invalidateHalo();
         using capture_type     = detail::CapturedExpression<E, N>;
         capture_type expr_     = reinterpret_cast<const capture_type&>(expr);
         using index_array_type = typename RangePolicy<Dim, execution_space>::index_array_type;
@@ -132,6 +154,78 @@ namespace ippl {
         return *this;
     }
 
+    template <typename T, unsigned Dim, class... ViewArgs>
+    template <typename E, size_t N>
+    void BareField<T, Dim, ViewArgs...>::assignInterior(const detail::Expression<E, N>& expr,
+                                                        int width) {
+        Kokkos::Array<index_type, Dim> begin, end;
+        for (unsigned d = 0; d < Dim; ++d) {
+            begin[d] = nghost_m + width;
+            end[d]   = static_cast<index_type>(dview_m.extent(d)) - nghost_m - width;
+        }
+        assignRange(expr, begin, end);
+    }
+
+    template <typename T, unsigned Dim, class... ViewArgs>
+    template <typename E, size_t N>
+    void BareField<T, Dim, ViewArgs...>::assignBoundary(const detail::Expression<E, N>& expr,
+                                                        int width) {
+        // the owned cells and the interior
+        Kokkos::Array<index_type, Dim> lo, hi, ilo, ihi;
+        for (unsigned d = 0; d < Dim; ++d) {
+            lo[d]  = nghost_m;
+            hi[d]  = static_cast<index_type>(dview_m.extent(d)) - nghost_m;
+            ilo[d] = std::min<index_type>(lo[d] + width, hi[d]);
+            ihi[d] = std::max<index_type>(hi[d] - width, ilo[d]);
+        }
+
+        // The shell is split into a lower and an upper slab per dimension. The
+        // slabs of dimension d cover all owned points along the following
+        // dimensions but only interior points along the preceding ones, so they
+        // do not overlap.
+        for (unsigned d = 0; d < Dim; ++d) {
+            for (int upper = 0; upper < 2; ++upper) {
+                Kokkos::Array<index_type, Dim> begin, end;
+                for (unsigned d2 = 0; d2 < Dim; ++d2) {
+                    if (d2 < d) {
+                        begin[d2] = ilo[d2];
+                        end[d2]   = ihi[d2];
+                    } else if (d2 > d) {
+                        begin[d2] = lo[d2];
+                        end[d2]   = hi[d2];
+                    } else {
+                        begin[d2] = upper ? ihi[d2] : lo[d2];
+                        end[d2]   = upper ? hi[d2] : ilo[d2];
+                    }
+                }
+                assignRange(expr, begin, end);
+            }
+        }
+    }
+
+    template <typename T, unsigned Dim, class... ViewArgs>
+    template <typename E, size_t N>
+    void BareField<T, Dim, ViewArgs...>::assignRange(const detail::Expression<E, N>& expr,
+                                                     const Kokkos::Array<index_type, Dim>& begin,
+                                                     const Kokkos::Array<index_type, Dim>& end) {
+        for (unsigned d = 0; d < Dim; ++d) {
+            if (end[d] <= begin[d]) {
+                return;
+            }
+        }
+
+        invalidateHalo();
+        using capture_type     = detail::CapturedExpression<E, N>;
+        capture_type expr_     = reinterpret_cast<const capture_type&>(expr);
+        using index_array_type = typename RangePolicy<Dim, execution_space>::index_array_type;
+        ippl::parallel_for(
+            "BareField::assignRange(const Expression&)",
+            createRangePolicy<Dim, execution_space>(begin, end),
+            KOKKOS_CLASS_LAMBDA(const index_array_type& args) {
+                apply(dview_m, args) = apply(expr_, args);
+            });
+    }
+
     template <typename T, unsigned Dim, class... ViewArgs>
     void BareField<T, Dim, ViewArgs...>::write(std::ostream& out) const {
         Kokkos::fence();
@@ -61,6 +61,7 @@ namespace ippl {
         void updateLayout(Layout_t&, int nghost = 1);
 
         void setFieldBC(BConds_t& bc) {
+            this->invalidateHalo();
             bc_m = bc;
             bc_m.findBCNeighbors(*this);
         }
@@ -17,6 +17,67 @@
 //
 
 namespace ippl {
+    namespace detail {
+        /*!
+         * Fill the halo cells of a field and apply its boundary conditions before
+         * a stencil is applied to it. This is skipped if the field was not written
+         * since the last refresh, e.g. when several operators are applied to it.
+         * If a halo exchange of the field is pending, this is left to
+         * assignOverlapped.
+         * @param u field
+         */
+        template <typename Field>
+        void prepareStencil(Field& u) {
+            if (u.isHaloPending()) {
+                return;
+            }
+            auto& halo = u.getHalo();
+            halo.countRefresh(u.isHaloValid());
+            if (u.isHaloValid()) {
+                return;
+            }
+            u.fillHalo();
+            BConds<Field, Field::dim>& bcField = u.getFieldBC();
+            bcField.apply(u);
+            // applying the boundary conditions writes to the field
+            halo.setValid(true);
+        }
+    }  // namespace detail
+
+    /*!
+     * Assign a stencil expression of a field while the halo cells of the field
+     * are exchanged. The points whose stencils do not reach the halo are computed
+     * while the messages are in flight; then the exchange is completed, the
+     * boundary conditions are applied and the remaining boundary shell is computed.
+     * The result is the same as lhs = op(u), which is what is done if the halo
+     * cells of u are valid.
+     * @param lhs field to assign to
+     * @param u field the stencil is applied to
+     * @param op function returning the expression for u, e.g. a wrapper of laplace
+     */
+    template <typename FieldLHS, typename Field, class Op>
+    void assignOverlapped(FieldLHS& lhs, Field& u, const Op& op) {
+        const int width = u.getNghost();
+        auto& halo      = u.getHalo();
+
+        // nothing to overlap, op counts the skipped refresh
+        if (u.isHaloValid()) {
+            lhs = op(u);
+            return;
+        }
+        halo.countRefresh(false);
+
+        u.beginFillHalo();
+        auto expr = op(u);
+        lhs.assignInterior(expr, width);
+
+        u.endFillHalo();
+        BConds<Field, Field::dim>& bcField = u.getFieldBC();
+        bcField.apply(u);
+        halo.setValid(true);
+        lhs.assignBoundary(expr, width);
+    }
+
     /*!
      * User interface of gradient
      * @param u field
@@ -25,9 +86,7 @@ namespace ippl {
     detail::meta_grad<Field> grad(Field& u) {
         constexpr unsigned Dim = Field::dim;
 
-        u.fillHalo();
-        BConds<Field, Dim>& bcField = u.getFieldBC();
-        bcField.apply(u);
+        detail::prepareStencil(u);
 
         using mesh_type   = typename Field::Mesh_t;
         using vector_type = typename mesh_type::vector_type;
@@ -49,9 +108,7 @@ namespace ippl {
     detail::meta_div<Field> div(Field& u) {
         constexpr unsigned Dim = Field::dim;
 
-        u.fillHalo();
-        BConds<Field, Dim>& bcField = u.getFieldBC();
-        bcField.apply(u);
+        detail::prepareStencil(u);
 
         using mesh_type   = typename Field::Mesh_t;
         using vector_type = typename mesh_type::vector_type;
@@ -73,9 +130,7 @@ namespace ippl {
     detail::meta_laplace<Field> laplace(Field& u) {
         constexpr unsigned Dim = Field::dim;
 
-        u.fillHalo();
-        BConds<Field, Dim>& bcField = u.getFieldBC();
-        bcField.apply(u);
+        detail::prepareStencil(u);
 
         using mesh_type = typename Field::Mesh_t;
         mesh_type& mesh = u.get_mesh();
@@ -92,11 +147,7 @@ namespace ippl {
      */
     template <typename Field>
     detail::meta_curl<Field> curl(Field& u) {
-        constexpr unsigned Dim = Field::dim;
-
-        u.fillHalo();
-        BConds<Field, Dim>& bcField = u.getFieldBC();
-        bcField.apply(u);
+        detail::prepareStencil(u);
 
         using mesh_type = typename Field::Mesh_t;
         mesh_type& mesh = u.get_mesh();
@@ -119,9 +170,7 @@ namespace ippl {
     detail::meta_hess<Field> hess(Field& u) {
         constexpr unsigned Dim = Field::dim;
 
-        u.fillHalo();
-        BConds<Field, Dim>& bcField = u.getFieldBC();
-        bcField.apply(u);
+        detail::prepareStencil(u);
 
         using mesh_type   = typename Field::Mesh_t;
         using vector_type = typename mesh_type::vector_type;
@@ -0,0 +1,218 @@
+//
+// File HaloBatch
+//   Halo exchange of several fields in one set of messages.
+//
+//   Solvers and PIC loops often refresh several fields back to back. Exchanged
+//   separately, every field pays the latency of a full message round. The
+//   batched exchange sends the halo data of all fields to a neighbor in a single
+//   message, packed and unpacked by one kernel per neighbor.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "Utility/IpplException.h"
+
+#include "Communicate/Archive.h"
+#include "Communicate/Communicate.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * Pack or unpack the range of a message for several fields; the data of
+         * each field is stored contiguously, one field after the other.
+         * @param views the fields as arrays of bytes
+         * @param strides the strides of the field views, which are the same for all
+         * @param range the range of the message
+         * @param buffer the message
+         * @param pack true to copy the fields to the message, false for the reverse
+         */
+        template <unsigned Dim, class ExecSpace, class Views, class Bound>
+        void copyHaloBatch(const Views& views, const Kokkos::Array<size_type, Dim>& strides,
+                           const Bound& range, char* buffer, bool pack) {
+            Kokkos::Array<long, Dim> lo, extent;
+            for (unsigned d = 0; d < Dim; ++d) {
+                lo[d]     = range.lo[d];
+                extent[d] = range.hi[d] - range.lo[d];
+            }
+            const size_type n      = range.size();
+            const size_type nviews = views.extent(0);
+            if (n == 0) {
+                return;
+            }
+
+            using mdrange_t =
+                Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::IndexType<size_type>, ExecSpace>;
+            Kokkos::parallel_for(
+                pack ? "fillHalo::pack()" : "fillHalo::unpack()",
+                mdrange_t({0, 0}, {(long int)n, (long int)nviews}),
+                KOKKOS_LAMBDA(const size_type i, const size_type a) {
+                    // the first index runs fastest
+                    size_type l = i, index = 0;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        index += (lo[d] + l % extent[d]) * strides[d];
+                        l /= extent[d];
+                    }
+
+                    const ByteView& v = views(a);
+                    char* field       = v.data + index * v.size;
+                    char* message     = buffer + n * v.offset + i * v.size;
+                    if (pack) {
+                        std::memcpy(message, field, v.size);
+                    } else {
+                        std::memcpy(field, message, v.size);
+                    }
+                });
+        }
+    }  // namespace detail
+
+    /*!
+     * Fill the halo cells of several fields with one message per neighbor. The
+     * fields may have different value types but must share the layout and the
+     * number of ghost cells. The exchange always sends to all face, edge and
+     * vertex neighbors, whatever HaloExchange mode the fields use. The result is
+     * the same as calling fillHalo on each field.
+     * @param field the first field
+     * @param fields the other fields
+     */
+    template <class Field, class... Fields>
+    void fillHalo(Field& field, Fields&... fields) {
+        constexpr unsigned Dim = Field::dim;
+        using memory_space     = typename Field::memory_space;
+        using execution_space  = typename Field::execution_space;
+        using array_layout     = typename Field::view_type::array_layout;
+
+        static_assert(((Fields::dim == Dim) && ...), "The fields must have the same dimension.");
+        static_assert((std::is_same_v<typename Fields::memory_space, memory_space> && ...),
+                      "The fields must live in the same memory space.");
+        static_assert(
+            (std::is_same_v<typename Fields::view_type::array_layout, array_layout> && ...),
+            "The fields must have the same array layout.");
+
+        using Layout_t         = FieldLayout<Dim>;
+        const Layout_t& layout = field.getLayout();
+        const int nghost       = field.getNghost();
+        if (!((&fields.getLayout() == &layout && fields.getNghost() == nghost) && ...)) {
+            throw IpplException("ippl::fillHalo",
+                                "The fields must share the layout and the number of ghost cells.");
+        }
+        if (field.isHaloPending() || (fields.isHaloPending() || ...)) {
+            throw IpplException("ippl::fillHalo",
+                                "A halo exchange of one of the fields has not been finished.");
+        }
+
+        if (Comm->size() > 1) {
+            // the fields as arrays of bytes
+            std::vector<detail::ByteView> arrays;
+            auto addField = [&]<class F>(F& f) {
+                arrays.push_back({reinterpret_cast<char*>(f.getView().data()),
+                                  sizeof(typename F::value_type), 0});
+            };
+            addField(field);
+            (addField(fields), ...);
+
+            Kokkos::View<detail::ByteView*, memory_space> views("halo byte views", arrays.size());
+            auto views_host = Kokkos::create_mirror_view(views);
+            size_type size  = 0;
+            for (unsigned j = 0; j < arrays.size(); j++) {
+                views_host(j)        = arrays[j];
+                views_host(j).offset = size;
+                size += views_host(j).size;
+            }
+            Kokkos::deep_copy(views, views_host);
+
+            Kokkos::Array<size_type, Dim> strides;
+            for (unsigned d = 0; d < Dim; ++d) {
+                strides[d] = field.getView().stride(d);
+            }
+
+            using neighbor_list = typename Layout_t::neighbor_list;
+            using range_list    = typename Layout_t::neighbor_range_list;
+            using bound_type    = typename Layout_t::bound_type;
+            using buffer_type   = Communicate::buffer_type<memory_space>;
+
+            const neighbor_list& neighbors = layout.getNeighbors();
+            const range_list &sendRanges   = layout.getNeighborsSendRange(),
+                             &recvRanges   = layout.getNeighborsRecvRange();
+
+            // the receives first, then the sends, completed by one MPI_Waitall
+            std::vector<MPI_Request> requests;
+            std::vector<buffer_type> recvBuffers;
+            std::vector<bound_type> recvBounds;
+
+            constexpr size_t cubeCount = detail::countHypercubes(Dim) - 1;
+            for (size_t index = 0; index < cubeCount; index++) {
+                int tag = HALO_BATCH_TAG + Layout_t::getMatchingIndex(index);
+                for (size_t i = 0; i < neighbors[index].size(); i++) {
+                    const bound_type& range = recvRanges[index][i];
+                    size_type nrecvs        = range.size() * size;
+
+                    buffer_type buf = Comm->getBuffer<memory_space>(
+                        IPPL_HALO_RECV + i * cubeCount + index, nrecvs);
+
+                    requests.emplace_back();
+                    MPI_Irecv(buf->getBuffer(), nrecvs, MPI_BYTE, neighbors[index][i], tag,
+                              Comm->getCommunicator(), &requests.back());
+
+                    recvBuffers.push_back(buf);
+                    recvBounds.push_back(range);
+                }
+            }
+            const size_t nrecvs = requests.size();
+
+            std::vector<buffer_type> sendBuffers;
+            for (size_t index = 0; index < cubeCount; index++) {
+                for (size_t i = 0; i < neighbors[index].size(); i++) {
+                    const bound_type& range = sendRanges[index][i];
+                    buffer_type buf         = Comm->getBuffer<memory_space>(
+                        IPPL_HALO_SEND + i * cubeCount + index, range.size() * size);
+                    detail::copyHaloBatch<Dim, execution_space>(views, strides, range,
+                                                                buf->getBuffer(), true);
+                    sendBuffers.push_back(buf);
+                }
+            }
+            Kokkos::fence();
+
+            size_t n = 0;
+            for (size_t index = 0; index < cubeCount; index++) {
+                int tag = HALO_BATCH_TAG + index;
+                for (size_t i = 0; i < neighbors[index].size(); i++, n++) {
+                    requests.emplace_back();
+                    MPI_Isend(sendBuffers[n]->getBuffer(), sendRanges[index][i].size() * size,
+                              MPI_BYTE, neighbors[index][i], tag, Comm->getCommunicator(),
+                              &requests.back());
+                }
+            }
+
+            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+            for (size_t r = 0; r < nrecvs; ++r) {
+                detail::copyHaloBatch<Dim, execution_space>(views, strides, recvBounds[r],
+                                                            recvBuffers[r]->getBuffer(), false);
+            }
+            Kokkos::fence();
+        }
+
+        if (layout.isAllPeriodic_m) {
+            auto applyPeriodic = [&]<class F>(F& f) {
+                using Op = typename F::halo_type::assign;
+                f.getHalo().template applyPeriodicSerialDim<Op>(f.getView(), &layout, nghost);
+            };
+            applyPeriodic(field);
+            (applyPeriodic(fields), ...);
+        }
+    }
+}  // namespace ippl
@@ -19,15 +19,34 @@
 #define IPPL_HALO_CELLS_H
 
 #include <array>
+#include <memory>
+#include <mpi.h>
+#include <vector>
 
 #include "Types/IpplTypes.h"
 #include "Types/ViewTypes.h"
 
 #include "Communicate/Archive.h"
+#include "Field/HaloSchedule.h"
 #include "FieldLayout/FieldLayout.h"
 #include "Index/NDIndex.h"
 
 namespace ippl {
+    /*!
+     * The communication pattern of halo exchanges
+     */
+    enum class HaloExchange {
+        // one message to every face, edge and vertex neighbor
+        NEIGHBOR,
+        // one dimension after the other, with messages to face neighbors only;
+        // the edges and vertices are forwarded through the faces
+        SWEEP
+    };
+
+    // the pattern of fields that do not select one (--halo-exchange)
+    // use inlining to avoid multiple definitions
+    inline HaloExchange defaultHaloExchange = HaloExchange::NEIGHBOR;
+
     namespace detail {
         /*!
          * Helper class to send / receive field data.
@@ -79,6 +98,61 @@ namespace ippl {
              */
             void fillHalo(view_type&, const Layout_t* layout);
 
+            /*!
+             * Start sending internal data to halo cells: post the receives and send
+             * the data to the neighbors. The halo cells must not be read and no other
+             * halo exchange of this field may be started before endFillHalo is called.
+             * @param view the original field data
+             * @param layout the field layout storing the domain decomposition
+             */
+            void beginFillHalo(view_type& view, const Layout_t* layout);
+
+            /*!
+             * Complete an exchange started with beginFillHalo. In the SWEEP mode,
+             * only the first dimension is exchanged in the background.
+             * @param view the original field data
+             */
+            void endFillHalo(view_type& view);
+
+            /*!
+             * @returns true if an exchange was started but not completed
+             */
+            bool isPending() const { return state_m->active; }
+
+            /*!
+             * @returns true if the halo cells and the boundary conditions of the field
+             * are current, i.e. the field was not written since they were refreshed
+             */
+            bool isValid() const { return state_m->valid; }
+
+            void setValid(bool valid) { state_m->valid = valid; }
+
+            /*!
+             * Count a refresh of the halo cells before a stencil is applied
+             * @param skipped true if the halo cells were valid and nothing was done
+             */
+            void countRefresh(bool skipped) {
+                ++(skipped ? state_m->skippedRefreshes : state_m->refreshes);
+            }
+
+            size_type getRefreshCount() const { return state_m->refreshes; }
+
+            size_type getSkippedRefreshCount() const { return state_m->skippedRefreshes; }
+
+            void resetRefreshCounters() {
+                state_m->refreshes        = 0;
+                state_m->skippedRefreshes = 0;
+            }
+
+            /*!
+             * Select the communication pattern of the exchanges. In the SWEEP mode,
+             * the periodic serial dimensions are filled as part of the exchange.
+             * @param mode the pattern
+             */
+            void setExchangeMode(HaloExchange mode) { mode_m = mode; }
+
+            HaloExchange getExchangeMode() const { return mode_m; }
+
             /*!
              * Pack the field data to be sent into a contiguous array.
              * @param range the bounds of the subdomain to be sent
@@ -131,6 +205,14 @@ namespace ippl {
             template <typename Op>
             void applyPeriodicSerialDim(view_type& view, const Layout_t* layout, const int nghost);
 
+            /*!
+             * Apply the periodic boundary conditions of one serial dimension.
+             * @param d the dimension
+             */
+            template <typename Op>
+            void applyPeriodicSerialDim(view_type& view, const Layout_t* layout, const int nghost,
+                                        unsigned d);
+
         private:
             /*!
              * Exchange the data of halo cells.
@@ -143,6 +225,55 @@ namespace ippl {
             template <class Op>
             void exchangeBoundaries(view_type& view, const Layout_t* layout, SendOrder order);
 
+            /*!
+             * Start the receives and send the data of halo cells.
+             * @param view is the original field data
+             * @param layout the field layout storing the domain decomposition
+             * @param order the data send orientation
+             */
+            void beginExchange(view_type& view, const Layout_t* layout, SendOrder order);
+
+            /*!
+             * Wait for the messages of an exchange and unpack them. In the SWEEP
+             * mode, the remaining dimensions are exchanged one after the other.
+             * @param view is the original field data
+             * @tparam Op the data assigment operator of the
+             * unpack function call
+             */
+            template <class Op>
+            void finishExchange(view_type& view);
+
+            /*!
+             * Start the current step of the exchange in progress, which is the whole
+             * exchange in the NEIGHBOR mode and one dimension in the SWEEP mode.
+             * @param view is the original field data
+             */
+            void startStep(view_type& view);
+
+            using schedule_type = HaloSchedule<T, Dim, ViewArgs...>;
+
+            /*!
+             * Get the communication schedule of an exchange with all neighbors, which
+             * is built on first use and rebuilt whenever the layout changes.
+             * @param layout the field layout storing the domain decomposition
+             * @param order the data send orientation
+             */
+            schedule_type& getSchedule(const Layout_t* layout, SendOrder order);
+
+            /*!
+             * Get the communication schedule of one dimension of the SWEEP mode.
+             * @param layout the field layout storing the domain decomposition
+             * @param order the data send orientation
+             * @param d the dimension
+             */
+            schedule_type& getSweepSchedule(const Layout_t* layout, SendOrder order, unsigned d);
+
+            /*!
+             * @returns true if the dimension is periodic and not distributed, in
+             * which case the SWEEP mode fills its halo cells locally
+             */
+            static bool isPeriodicSerial(const Layout_t* layout, unsigned d);
+
             /*!
              * Extract the subview of the original data. This does not copy.
              * A subview points to the same memory.
@@ -152,6 +283,33 @@ namespace ippl {
             auto makeSubview(const view_type& view, const bound_type& intersect);
 
             databuffer_type haloData_m;
+
+            HaloExchange mode_m;
+
+            //! The schedules of both send orientations, the exchange in progress and the
+            //! validity of the halo cells
+            struct ExchangeState {
+                std::unique_ptr<schedule_type> schedules[2];
+                std::array<std::unique_ptr<schedule_type>, Dim> sweepSchedules[2];
+
+                bool active = false;
+                bool sweep;
+                SendOrder order;
+                const Layout_t* layout;
+                // the step of a sweep; the dimensions are filled in increasing
+                // and accumulated in decreasing order
+                unsigned step;
+                // the schedule of the step, null if the step is done locally
+                schedule_type* pending = nullptr;
+
+                // the halo cells and boundary conditions are current
+                bool valid                 = false;
+                size_type refreshes        = 0;
+                size_type skippedRefreshes = 0;
+            };
+
+            //! Shared by the copies of a field, which all refer to the same data
+            std::shared_ptr<ExchangeState> state_m;
         };
     }  // namespace detail
 }  // namespace ippl
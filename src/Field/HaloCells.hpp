@@ -17,7 +17,6 @@
 //
 
 #include <memory>
-#include <vector>
 
 #include "Utility/IpplException.h"
 
@@ -26,7 +25,9 @@
 namespace ippl {
     namespace detail {
         template <typename T, unsigned Dim, class... ViewArgs>
-        HaloCells<T, Dim, ViewArgs...>::HaloCells() {}
+        HaloCells<T, Dim, ViewArgs...>::HaloCells()
+            : mode_m(defaultHaloExchange)
+            , state_m(std::make_shared<ExchangeState>()) {}
 
         template <typename T, unsigned Dim, class... ViewArgs>
         void HaloCells<T, Dim, ViewArgs...>::accumulateHalo(view_type& view,
@@ -39,89 +40,168 @@ namespace ippl {
             exchangeBoundaries<assign>(view, layout, INTERNAL_TO_HALO);
         }
 
+        template <typename T, unsigned Dim, class... ViewArgs>
+        void HaloCells<T, Dim, ViewArgs...>::beginFillHalo(view_type& view,
+                                                           const Layout_t* layout) {
+            beginExchange(view, layout, INTERNAL_TO_HALO);
+        }
+
+        template <typename T, unsigned Dim, class... ViewArgs>
+        void HaloCells<T, Dim, ViewArgs...>::endFillHalo(view_type& view) {
+            finishExchange<assign>(view);
+        }
+
         template <typename T, unsigned Dim, class... ViewArgs>
         template <class Op>
         void HaloCells<T, Dim, ViewArgs...>::exchangeBoundaries(view_type& view,
                                                                 const Layout_t* layout,
                                                                 SendOrder order) {
-            using neighbor_list = typename Layout_t::neighbor_list;
-            using range_list    = typename Layout_t::neighbor_range_list;
-
-            const neighbor_list& neighbors = layout->getNeighbors();
-            const range_list &sendRanges   = layout->getNeighborsSendRange(),
-                             &recvRanges   = layout->getNeighborsRecvRange();
-
-            size_t totalRequests = 0;
-            for (const auto& componentNeighbors : neighbors) {
-                totalRequests += componentNeighbors.size();
-            }
+            beginExchange(view, layout, order);
+            finishExchange<Op>(view);
+        }
 
-            using memory_space = typename view_type::memory_space;
-            using buffer_type  = Communicate::buffer_type<memory_space>;
-            std::vector<MPI_Request> requests(totalRequests);
-
-            // sending loop
-            constexpr size_t cubeCount = detail::countHypercubes(Dim) - 1;
-            size_t requestIndex        = 0;
-            for (size_t index = 0; index < cubeCount; index++) {
-                int tag                        = HALO_TAG + index;
-                const auto& componentNeighbors = neighbors[index];
-                for (size_t i = 0; i < componentNeighbors.size(); i++) {
-                    int targetRank = componentNeighbors[i];
-
-                    bound_type range;
-                    if (order == INTERNAL_TO_HALO) {
+        template <typename T, unsigned Dim, class... ViewArgs>
+        typename HaloCells<T, Dim, ViewArgs...>::schedule_type&
+        HaloCells<T, Dim, ViewArgs...>::getSchedule(const Layout_t* layout, SendOrder order) {
+            std::unique_ptr<schedule_type>& schedule = state_m->schedules[order];
+            if (!schedule || !schedule->isValid(layout)) {
+                using neighbor_list = typename Layout_t::neighbor_list;
+                using range_list    = typename Layout_t::neighbor_range_list;
+
+                const neighbor_list& neighbors = layout->getNeighbors();
+                const range_list &sendRanges   = layout->getNeighborsSendRange(),
+                                 &recvRanges   = layout->getNeighborsRecvRange();
+
+                typename schedule_type::message_list sends, recvs;
+                constexpr size_t cubeCount = detail::countHypercubes(Dim) - 1;
+                for (size_t index = 0; index < cubeCount; index++) {
+                    int sendTag = HALO_TAG + index;
+                    int recvTag = HALO_TAG + Layout_t::getMatchingIndex(index);
+                    for (size_t i = 0; i < neighbors[index].size(); i++) {
                         /*We store only the sending and receiving ranges
                          * of INTERNAL_TO_HALO and use the fact that the
                          * sending range of HALO_TO_INTERNAL is the receiving
                          * range of INTERNAL_TO_HALO and vice versa
                          */
-                        range = sendRanges[index][i];
-                    } else {
-                        range = recvRanges[index][i];
+                        const bool fill = order == INTERNAL_TO_HALO;
+                        const int rank  = neighbors[index][i];
+                        sends.push_back(
+                            {rank, sendTag, fill ? sendRanges[index][i] : recvRanges[index][i]});
+                        recvs.push_back(
+                            {rank, recvTag, fill ? recvRanges[index][i] : sendRanges[index][i]});
                     }
+                }
+                schedule = std::make_unique<schedule_type>(layout, sends, recvs);
+            }
+            return *schedule;
+        }
 
-                    size_type nsends;
-                    pack(range, view, haloData_m, nsends);
-
-                    buffer_type buf = Comm->getBuffer<memory_space, T>(
-                        IPPL_HALO_SEND + i * cubeCount + index, nsends);
-
-                    Comm->isend(targetRank, tag, haloData_m, *buf, requests[requestIndex++],
-                                nsends);
-                    buf->resetWritePos();
+        template <typename T, unsigned Dim, class... ViewArgs>
+        typename HaloCells<T, Dim, ViewArgs...>::schedule_type&
+        HaloCells<T, Dim, ViewArgs...>::getSweepSchedule(const Layout_t* layout, SendOrder order,
+                                                         unsigned d) {
+            std::unique_ptr<schedule_type>& schedule = state_m->sweepSchedules[order][d];
+            if (!schedule || !schedule->isValid(layout)) {
+                using neighbor_list = typename Layout_t::face_neighbor_list;
+                using range_list    = typename Layout_t::face_range_list;
+
+                const neighbor_list& neighbors = layout->getSweepNeighbors();
+                const range_list &sendRanges   = layout->getSweepSendRange(),
+                                 &recvRanges   = layout->getSweepRecvRange();
+
+                // the lower face of one rank matches the upper face of the other
+                typename schedule_type::message_list sends, recvs;
+                for (unsigned face = 2 * d; face < 2 * d + 2; ++face) {
+                    int sendTag = HALO_SWEEP_TAG + face;
+                    int recvTag = HALO_SWEEP_TAG + (face ^ 1);
+                    for (size_t i = 0; i < neighbors[face].size(); i++) {
+                        const bool fill = order == INTERNAL_TO_HALO;
+                        const int rank  = neighbors[face][i];
+                        sends.push_back(
+                            {rank, sendTag, fill ? sendRanges[face][i] : recvRanges[face][i]});
+                        recvs.push_back(
+                            {rank, recvTag, fill ? recvRanges[face][i] : sendRanges[face][i]});
+                    }
                 }
+                schedule = std::make_unique<schedule_type>(layout, sends, recvs);
             }
+            return *schedule;
+        }
 
-            // receiving loop
-            for (size_t index = 0; index < cubeCount; index++) {
-                int tag                        = HALO_TAG + Layout_t::getMatchingIndex(index);
-                const auto& componentNeighbors = neighbors[index];
-                for (size_t i = 0; i < componentNeighbors.size(); i++) {
-                    int sourceRank = componentNeighbors[i];
+        template <typename T, unsigned Dim, class... ViewArgs>
+        bool HaloCells<T, Dim, ViewArgs...>::isPeriodicSerial(const Layout_t* layout, unsigned d) {
+            return layout->isAllPeriodic_m
+                   && layout->getLocalNDIndex()[d].length() == layout->getDomain()[d].length();
+        }
 
-                    bound_type range;
-                    if (order == INTERNAL_TO_HALO) {
-                        range = recvRanges[index][i];
-                    } else {
-                        range = sendRanges[index][i];
-                    }
+        template <typename T, unsigned Dim, class... ViewArgs>
+        void HaloCells<T, Dim, ViewArgs...>::beginExchange(view_type& view, const Layout_t* layout,
+                                                           SendOrder order) {
+            ExchangeState& state = *state_m;
+            if (state.active) {
+                throw IpplException("HaloCells::beginExchange",
+                                    "The previous halo exchange has not been finished.");
+            }
 
-                    size_type nrecvs = range.size();
+            state.active = true;
+            state.sweep  = mode_m == HaloExchange::SWEEP;
+            state.order  = order;
+            state.layout = layout;
+            state.step   = 0;
+            startStep(view);
+        }
 
-                    buffer_type buf = Comm->getBuffer<memory_space, T>(
-                        IPPL_HALO_RECV + i * cubeCount + index, nrecvs);
+        template <typename T, unsigned Dim, class... ViewArgs>
+        void HaloCells<T, Dim, ViewArgs...>::startStep(view_type& view) {
+            ExchangeState& state = *state_m;
+            if (!state.sweep) {
+                state.pending = &getSchedule(state.layout, state.order);
+            } else {
+                // the halos of each dimension are forwarded in the following ones,
+                // so accumulating runs the fill steps backwards
+                const unsigned d =
+                    state.order == INTERNAL_TO_HALO ? state.step : Dim - 1 - state.step;
+                state.pending = isPeriodicSerial(state.layout, d)
+                                    ? nullptr
+                                    : &getSweepSchedule(state.layout, state.order, d);
+            }
 
-                    Comm->recv(sourceRank, tag, haloData_m, *buf, nrecvs * sizeof(T), nrecvs);
-                    buf->resetReadPos();
+            if (state.pending != nullptr) {
+                state.pending->start(view);
+            }
+        }
 
-                    unpack<Op>(range, view, haloData_m);
-                }
+        template <typename T, unsigned Dim, class... ViewArgs>
+        template <class Op>
+        void HaloCells<T, Dim, ViewArgs...>::finishExchange(view_type& view) {
+            ExchangeState& state = *state_m;
+            if (!state.active) {
+                return;
             }
 
-            if (totalRequests > 0) {
-                MPI_Waitall(totalRequests, requests.data(), MPI_STATUSES_IGNORE);
+            const unsigned nsteps = state.sweep ? Dim : 1;
+            while (true) {
+                if (state.pending != nullptr) {
+                    state.pending->template finish<Op>(view);
+                    state.pending = nullptr;
+                } else {
+                    const unsigned d =
+                        state.order == INTERNAL_TO_HALO ? state.step : Dim - 1 - state.step;
+                    const int nghost =
+                        (view.extent(d) - state.layout->getLocalNDIndex()[d].length()) / 2;
+                    if (state.order == INTERNAL_TO_HALO) {
+                        applyPeriodicSerialDim<assign>(view, state.layout, nghost, d);
+                    } else {
+                        applyPeriodicSerialDim<rhs_plus_assign>(view, state.layout, nghost, d);
+                    }
+                }
+
+                if (++state.step == nsteps) {
+                    break;
+                }
+                startStep(view);
             }
+            state.active = false;
         }
 
         template <typename T, unsigned Dim, class... ViewArgs>
@@ -202,55 +282,61 @@ namespace ippl {
         void HaloCells<T, Dim, ViewArgs...>::applyPeriodicSerialDim(view_type& view,
                                                                     const Layout_t* layout,
                                                                     const int nghost) {
+            for (unsigned d = 0; d < Dim; ++d) {
+                applyPeriodicSerialDim<Op>(view, layout, nghost, d);
+            }
+        }
+
+        template <typename T, unsigned Dim, class... ViewArgs>
+        template <typename Op>
+        void HaloCells<T, Dim, ViewArgs...>::applyPeriodicSerialDim(view_type& view,
+                                                                    const Layout_t* layout,
+                                                                    const int nghost, unsigned d) {
             int myRank           = Comm->rank();
             const auto& lDomains = layout->getHostLocalDomains();
             const auto& domain   = layout->getDomain();
             using index_type     = typename RangePolicy<Dim>::index_type;
-            Kokkos::Array<index_type, Dim> ext, begin, end;
+            Kokkos::Array<index_type, Dim> begin, end;
 
             for (size_t i = 0; i < Dim; ++i) {
-                ext[i]   = view.extent(i);
+                end[i]   = view.extent(i);
                 begin[i] = 0;
             }
+            end[d] = nghost;
 
             Op op;
 
-            for (unsigned d = 0; d < Dim; ++d) {
-                end    = ext;
-                end[d] = nghost;
-
-                if (lDomains[myRank][d].length() == domain[d].length()) {
-                    int N = view.extent(d) - 1;
-
-                    using index_array_type = typename RangePolicy<Dim>::index_array_type;
-                    using exec_space       = typename view_type::execution_space;
-                    ippl::parallel_for(
-                        "applyPeriodicSerialDim", createRangePolicy<Dim, exec_space>(begin, end),
-                        KOKKOS_LAMBDA(index_array_type & coords) {
-                            // The ghosts are filled starting from the inside
-                            // of the domain proceeding outwards for both lower
-                            // and upper faces. The extra brackets and explicit
-                            // mention
-
-                            // nghost + i
-                            coords[d] += nghost;
-                            auto&& left = apply(view, coords);
-
-                            // N - nghost - i
-                            coords[d]    = N - coords[d];
-                            auto&& right = apply(view, coords);
-
-                            // nghost - 1 - i
-                            coords[d] += 2 * nghost - 1 - N;
-                            op(apply(view, coords), right);
-
-                            // N - (nghost - 1 - i) = N - (nghost - 1) + i
-                            coords[d] = N - coords[d];
-                            op(apply(view, coords), left);
-                        });
-
-                    Kokkos::fence();
-                }
+            if (lDomains[myRank][d].length() == domain[d].length()) {
+                int N = view.extent(d) - 1;
+
+                using index_array_type = typename RangePolicy<Dim>::index_array_type;
+                using exec_space       = typename view_type::execution_space;
+                ippl::parallel_for(
+                    "applyPeriodicSerialDim", createRangePolicy<Dim, exec_space>(begin, end),
+                    KOKKOS_LAMBDA(index_array_type & coords) {
+                        // The ghosts are filled starting from the inside
+                        // of the domain proceeding outwards for both lower
+                        // and upper faces. The extra brackets and explicit
+                        // mention
+
+                        // nghost + i
+                        coords[d] += nghost;
+                        auto&& left = apply(view, coords);
+
+                        // N - nghost - i
+                        coords[d]    = N - coords[d];
+                        auto&& right = apply(view, coords);
+
+                        // nghost - 1 - i
+                        coords[d] += 2 * nghost - 1 - N;
+                        op(apply(view, coords), right);
+
+                        // N - (nghost - 1 - i) = N - (nghost - 1) + i
+                        coords[d] = N - coords[d];
+                        op(apply(view, coords), left);
+                    });
+
+                Kokkos::fence();
             }
         }
     }  // namespace detail
@@ -0,0 +1,165 @@
+//
+// Class HaloSchedule
+//   The persistent communication schedule of a halo exchange.
+//
+//   For a fixed field layout, the neighbors, the ranges to send and receive and
+//   the message sizes of a halo exchange never change. A schedule computes them
+//   once, allocates one send and one receive buffer holding all messages and
+//   creates persistent MPI requests for them. An exchange then consists of one
+//   pack kernel over all ranges to send, MPI_Startall and one unpack kernel.
+//   The schedule is rebuilt when the layout changes (see FieldLayout::getVersion).
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_HALO_SCHEDULE_H
+#define IPPL_HALO_SCHEDULE_H
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+#include <vector>
+
+#include "Types/IpplTypes.h"
+#include "Types/ViewTypes.h"
+
+#include "Utility/ParallelDispatch.h"
+
+#include "FieldLayout/FieldLayout.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * The messages of one halo exchange of a field.
+         * @tparam T data type of the field
+         * @tparam Dim field dimension
+         */
+        template <typename T, unsigned Dim, class... ViewArgs>
+        class HaloSchedule {
+        public:
+            using view_type       = typename detail::ViewType<T, Dim, ViewArgs...>::view_type;
+            using buffer_type     = typename detail::ViewType<T, 1, ViewArgs...>::view_type;
+            using memory_space    = typename view_type::memory_space;
+            using execution_space = typename view_type::execution_space;
+            using Layout_t        = FieldLayout<Dim>;
+            using bound_type      = typename Layout_t::bound_type;
+
+            //! A message to or from a neighbor
+            struct Message {
+                int rank;
+                int tag;
+                bound_type range;
+            };
+
+            using message_list = std::vector<Message>;
+
+            /*!
+             * Build the persistent requests of an exchange.
+             * @param layout the field layout storing the domain decomposition
+             * @param sends the messages to send
+             * @param recvs the messages to receive
+             */
+            HaloSchedule(const Layout_t* layout, const message_list& sends,
+                         const message_list& recvs);
+
+            HaloSchedule(const HaloSchedule&)            = delete;
+            HaloSchedule& operator=(const HaloSchedule&) = delete;
+
+            ~HaloSchedule();
+
+            /*!
+             * @param layout the layout of the field
+             * @returns true if the schedule was built for the current neighbors of the layout
+             */
+            bool isValid(const Layout_t* layout) const {
+                return layout == layout_m && layout->getVersion() == version_m;
+            }
+
+            /*!
+             * Start the receives, pack all ranges to send in one kernel and start
+             * the sends.
+             * @param view the original field data
+             */
+            void start(const view_type& view);
+
+            /*!
+             * Wait for all messages and unpack the received ranges. Ranges that do
+             * not overlap are unpacked in one kernel; overlapping ranges, as in the
+             * accumulation of halos, are unpacked one after the other.
+             * @param view the original field data
+             * @tparam Op the data assigment operator
+             */
+            template <class Op>
+            void finish(const view_type& view);
+
+        private:
+            using index_type       = typename RangePolicy<Dim, execution_space>::index_type;
+            using index_array_type = typename RangePolicy<Dim, execution_space>::index_array_type;
+
+            //! A range and the position of its data in a buffer
+            struct Region {
+                Kokkos::Array<index_type, Dim> lo;
+                Kokkos::Array<index_type, Dim> extent;
+                size_type offset;
+            };
+
+            using region_view = Kokkos::View<Region*, memory_space>;
+
+            /*!
+             * Map an element of a buffer to the view index it belongs to; the data
+             * of a range is stored with the first index running fastest.
+             * @param r the region of the element
+             * @param k the position of the element in the buffer
+             */
+            KOKKOS_INLINE_FUNCTION static index_array_type getIndex(const Region& r, size_type k);
+
+            /*!
+             * Find the region of an element in a list of regions sorted by offset
+             * @param regions the regions
+             * @param n the number of regions
+             * @param k the position of the element in the buffer
+             */
+            KOKKOS_INLINE_FUNCTION static const Region& findRegion(const region_view& regions,
+                                                                   int n, size_type k);
+
+            /*!
+             * Convert the ranges of messages to regions stored back to back
+             * @param messages the messages
+             * @param regions the regions (host)
+             * @returns the total number of elements
+             */
+            static size_type makeRegions(const message_list& messages,
+                                         std::vector<Region>& regions);
+
+            const Layout_t* layout_m;
+            unsigned long long version_m;
+
+            region_view sendRegions_m;
+            region_view recvRegions_m;
+            std::vector<Region> hostRecvRegions_m;
+            bool disjointRecvs_m;
+
+            buffer_type sendBuffer_m;
+            buffer_type recvBuffer_m;
+            size_type nsends_m;
+            size_type nrecvs_m;
+
+            std::vector<MPI_Request> sendRequests_m;
+            std::vector<MPI_Request> recvRequests_m;
+        };
+    }  // namespace detail
+}  // namespace ippl
+
+#include "Field/HaloSchedule.hpp"
+
+#endif
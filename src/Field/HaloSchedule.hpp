@@ -0,0 +1,222 @@
+//
+// Class HaloSchedule
+//   The persistent communication schedule of a halo exchange.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "Communicate/Communicate.h"
+
+namespace ippl {
+    namespace detail {
+        template <typename T, unsigned Dim, class... ViewArgs>
+        HaloSchedule<T, Dim, ViewArgs...>::HaloSchedule(const Layout_t* layout,
+                                                        const message_list& sends,
+                                                        const message_list& recvs)
+            : layout_m(layout)
+            , version_m(layout->getVersion()) {
+            std::vector<Region> sendRegions;
+            nsends_m = makeRegions(sends, sendRegions);
+            nrecvs_m = makeRegions(recvs, hostRecvRegions_m);
+
+            auto copyRegions = [](const std::vector<Region>& regions, region_view& view) {
+                view      = region_view("halo regions", regions.size());
+                auto host = Kokkos::create_mirror_view(view);
+                for (size_t i = 0; i < regions.size(); ++i) {
+                    host(i) = regions[i];
+                }
+                Kokkos::deep_copy(view, host);
+            };
+            copyRegions(sendRegions, sendRegions_m);
+            copyRegions(hostRecvRegions_m, recvRegions_m);
+
+            // the ghost cells filled by different neighbors are disjoint, but the
+            // internal cells receiving accumulated halos from several neighbors are not
+            disjointRecvs_m = true;
+            for (size_t i = 0; i < hostRecvRegions_m.size(); ++i) {
+                for (size_t j = 0; j < i; ++j) {
+                    const Region &a = hostRecvRegions_m[i], &b = hostRecvRegions_m[j];
+                    bool overlap    = true;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        overlap = overlap && a.extent[d] > 0 && b.extent[d] > 0
+                                  && a.lo[d] < b.lo[d] + b.extent[d]
+                                  && b.lo[d] < a.lo[d] + a.extent[d];
+                    }
+                    disjointRecvs_m = disjointRecvs_m && !overlap;
+                }
+            }
+
+            sendBuffer_m = buffer_type("halo send buffer", nsends_m);
+            recvBuffer_m = buffer_type("halo receive buffer", nrecvs_m);
+
+            // one persistent request per message; the buffers never move, so the
+            // requests stay valid for the lifetime of the schedule
+            auto messageSize = [](const std::vector<Region>& regions, size_t i, size_type total) {
+                return (i + 1 < regions.size() ? regions[i + 1].offset : total) - regions[i].offset;
+            };
+
+            recvRequests_m.resize(recvs.size());
+            for (size_t i = 0; i < recvs.size(); ++i) {
+                size_type nrecvs = messageSize(hostRecvRegions_m, i, nrecvs_m);
+                Comm->recvInit(recvs[i].rank, recvs[i].tag,
+                               recvBuffer_m.data() + hostRecvRegions_m[i].offset,
+                               nrecvs * sizeof(T), recvRequests_m[i]);
+            }
+
+            sendRequests_m.resize(sends.size());
+            for (size_t i = 0; i < sends.size(); ++i) {
+                size_type nsends = messageSize(sendRegions, i, nsends_m);
+                Comm->sendInit(sends[i].rank, sends[i].tag,
+                               sendBuffer_m.data() + sendRegions[i].offset, nsends * sizeof(T),
+                               sendRequests_m[i]);
+            }
+        }
+
+        template <typename T, unsigned Dim, class... ViewArgs>
+        HaloSchedule<T, Dim, ViewArgs...>::~HaloSchedule() {
+            // fields may outlive the communicator
+            int finalized;
+            MPI_Finalized(&finalized);
+            if (finalized) {
+                return;
+            }
+            for (auto& request : sendRequests_m) {
+                MPI_Request_free(&request);
+            }
+            for (auto& request : recvRequests_m) {
+                MPI_Request_free(&request);
+            }
+        }
+
+        template <typename T, unsigned Dim, class... ViewArgs>
+        size_type HaloSchedule<T, Dim, ViewArgs...>::makeRegions(const message_list& messages,
+                                                                 std::vector<Region>& regions) {
+            regions.clear();
+            size_type offset = 0;
+            for (const Message& message : messages) {
+                const bound_type& range = message.range;
+                Region r;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    r.lo[d]     = range.lo[d];
+                    r.extent[d] = range.hi[d] - range.lo[d];
+                }
+                r.offset = offset;
+                regions.push_back(r);
+                offset += range.size();
+            }
+            return offset;
+        }
+
+        template <typename T, unsigned Dim, class... ViewArgs>
+        KOKKOS_INLINE_FUNCTION typename HaloSchedule<T, Dim, ViewArgs...>::index_array_type
+        HaloSchedule<T, Dim, ViewArgs...>::getIndex(const Region& r, size_type k) {
+            index_array_type args;
+            size_type l = k - r.offset;
+            for (unsigned d = 0; d < Dim; ++d) {
+                args[d] = r.lo[d] + l % r.extent[d];
+                l /= r.extent[d];
+            }
+            return args;
+        }
+
+        template <typename T, unsigned Dim, class... ViewArgs>
+        KOKKOS_INLINE_FUNCTION const typename HaloSchedule<T, Dim, ViewArgs...>::Region&
+        HaloSchedule<T, Dim, ViewArgs...>::findRegion(const region_view& regions, int n,
+                                                      size_type k) {
+            // the last region starting at or before k; empty regions are skipped
+            // because the next region starts at the same offset
+            int lo = 0, hi = n - 1;
+            while (lo < hi) {
+                const int mid = (lo + hi + 1) / 2;
+                if (regions(mid).offset <= k) {
+                    lo = mid;
+                } else {
+                    hi = mid - 1;
+                }
+            }
+            return regions(lo);
+        }
+
+        template <typename T, unsigned Dim, class... ViewArgs>
+        void HaloSchedule<T, Dim, ViewArgs...>::start(const view_type& view) {
+            if (recvRequests_m.size() > 0) {
+                MPI_Startall(recvRequests_m.size(), recvRequests_m.data());
+            }
+
+            if (nsends_m > 0) {
+                auto buffer  = sendBuffer_m;
+                auto regions = sendRegions_m;
+                const int n  = regions.extent(0);
+                using policy = Kokkos::RangePolicy<execution_space>;
+                Kokkos::parallel_for(
+                    "HaloSchedule::pack()", policy(0, nsends_m), KOKKOS_LAMBDA(const size_type k) {
+                        buffer(k) = apply(view, getIndex(findRegion(regions, n, k), k));
+                    });
+                Kokkos::fence();
+            }
+
+            if (sendRequests_m.size() > 0) {
+                MPI_Startall(sendRequests_m.size(), sendRequests_m.data());
+            }
+        }
+
+        template <typename T, unsigned Dim, class... ViewArgs>
+        template <class Op>
+        void HaloSchedule<T, Dim, ViewArgs...>::finish(const view_type& view) {
+            if (recvRequests_m.size() > 0) {
+                MPI_Waitall(recvRequests_m.size(), recvRequests_m.data(), MPI_STATUSES_IGNORE);
+            }
+
+            // 29. November 2020
+            // https://stackoverflow.com/questions/3735398/operator-as-template-parameter
+            Op op;
+
+            auto buffer  = recvBuffer_m;
+            using policy = Kokkos::RangePolicy<execution_space>;
+            if (disjointRecvs_m) {
+                if (nrecvs_m > 0) {
+                    auto regions = recvRegions_m;
+                    const int n  = regions.extent(0);
+                    Kokkos::parallel_for(
+                        "HaloSchedule::unpack()", policy(0, nrecvs_m),
+                        KOKKOS_LAMBDA(const size_type k) {
+                            op(apply(view, getIndex(findRegion(regions, n, k), k)), buffer(k));
+                        });
+                }
+            } else {
+                // overlapping ranges are unpacked in a fixed order, so that the
+                // result does not depend on the order in which messages arrive
+                for (size_t i = 0; i < hostRecvRegions_m.size(); ++i) {
+                    const Region r = hostRecvRegions_m[i];
+                    const size_type end = i + 1 < hostRecvRegions_m.size()
+                                              ? hostRecvRegions_m[i + 1].offset
+                                              : nrecvs_m;
+                    if (end == r.offset) {
+                        continue;
+                    }
+                    Kokkos::parallel_for(
+                        "HaloSchedule::unpack()", policy(r.offset, end),
+                        KOKKOS_LAMBDA(const size_type k) {
+                            op(apply(view, getIndex(r, k)), buffer(k));
+                        });
+                }
+            }
+            Kokkos::fence();
+
+            if (sendRequests_m.size() > 0) {
+                MPI_Waitall(sendRequests_m.size(), sendRequests_m.data(), MPI_STATUSES_IGNORE);
+            }
+        }
+    }  // namespace detail
+}  // namespace ippl
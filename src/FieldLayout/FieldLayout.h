@@ -53,6 +53,15 @@ namespace ippl {
     };
 
     namespace detail {
+        /*!
+         * @returns a number that is different on every call, which identifies the
+         * state of a layout
+         */
+        inline unsigned long long nextLayoutVersion() {
+            static unsigned long long version = 0;
+            return ++version;
+        }
+
         /*!
          * Counts the hypercubes in a given dimension
          * @param dim the dimension
@@ -211,6 +220,11 @@ namespace ippl {
         using neighbor_list       = std::array<rank_list, detail::countHypercubes(Dim) - 1>;
         using neighbor_range_list = std::array<bounds_list, detail::countHypercubes(Dim) - 1>;
 
+        // the face neighbors of the dimension-by-dimension halo exchange, arranged
+        // by 2 * d for the lower and 2 * d + 1 for the upper face in dimension d
+        using face_neighbor_list = std::array<rank_list, 2 * Dim>;
+        using face_range_list    = std::array<bounds_list, 2 * Dim>;
+
         /*!
          * Default constructor, which should only be used if you are going to
          * call 'initialize' soon after (before using in any context)
@@ -311,6 +325,29 @@ namespace ippl {
          */
         static int getMatchingIndex(int index);
 
+        /*!
+         * Get the face neighbors of the dimension-by-dimension halo exchange, which
+         * exchanges the halos of one dimension after the other. The ranges of a
+         * dimension include the halo cells of the dimensions before it, so that the
+         * edges and vertices are filled without messages to edge and vertex neighbors.
+         * @return List of list of neighbor ranks touching each face
+         */
+        const face_neighbor_list& getSweepNeighbors() const;
+
+        /*!
+         * Get the ranges to send to the face neighbors in the dimension-by-dimension
+         * halo exchange
+         * @return Ranges to send
+         */
+        const face_range_list& getSweepSendRange() const;
+
+        /*!
+         * Get the ranges to receive from the face neighbors in the dimension-by-dimension
+         * halo exchange
+         * @return Ranges to receive
+         */
+        const face_range_list& getSweepRecvRange() const;
+
         /*!
          * Recursively finds neighbor ranks for layouts with all periodic boundary
          * conditions
@@ -346,10 +383,24 @@ namespace ippl {
         void addNeighbors(const NDIndex_t& gnd, const NDIndex_t& nd, const NDIndex_t& ndNeighbor,
                           const NDIndex_t& intersect, int nghost, int rank);
 
+        /*!
+         * Finds the face neighbors of the dimension-by-dimension halo exchange
+         * @param nghost number of ghost cells
+         */
+        void findSweepNeighbors(int nghost);
+
         void write(std::ostream& = std::cout) const;
 
         void updateLayout(const std::vector<NDIndex_t>& domains);
 
+        /*!
+         * Get the version of the domain decomposition, which changes whenever the
+         * neighbors are recomputed, e.g. by updateLayout; communication schedules
+         * built for the layout are valid as long as the version does not change
+         * @return Version number
+         */
+        unsigned long long getVersion() const { return version_m; }
+
         bool isAllPeriodic_m;
 
     private:
@@ -367,6 +418,29 @@ namespace ippl {
 
         int getPeriodicOffset(const NDIndex_t& nd, const unsigned int d, const int k);
 
+        /*!
+         * Obtain the cells of a halo face that a domain provides in the
+         * dimension-by-dimension halo exchange. The face is extended by the halo
+         * cells of the dimensions before d wherever the other domain holds them.
+         * @param nd the receiving domain
+         * @param ndNeighbor the sending domain, shifted across periodic boundaries
+         * @param d the dimension of the face
+         * @param side 0 for the lower, 1 for the upper face
+         * @param nghost number of ghost cells per dimension
+         * @param cells the cells, in the frame of the receiving domain
+         * @return True if the domain provides any cells
+         */
+        bool getSweepCells(const NDIndex_t& nd, const NDIndex_t& ndNeighbor, unsigned d, int side,
+                           int nghost, NDIndex_t& cells) const;
+
+        /*!
+         * Convert cells to the bounds of a local view
+         * @param cells the cells
+         * @param offset the local domain of the view
+         * @param nghost number of ghost cells per dimension
+         */
+        static bound_type toBounds(const NDIndex_t& cells, const NDIndex_t& offset, int nghost);
+
     private:
         //! Global domain
         NDIndex_t gDomain_m;
@@ -384,6 +458,12 @@ namespace ippl {
         neighbor_list neighbors_m;
         neighbor_range_list neighborsSendRange_m, neighborsRecvRange_m;
 
+        face_neighbor_list sweepNeighbors_m;
+        face_range_list sweepSendRange_m, sweepRecvRange_m;
+
+        //! Version of the neighbors and ranges
+        unsigned long long version_m;
+
         void calcWidths();
     };
 
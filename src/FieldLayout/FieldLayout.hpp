@@ -50,7 +50,8 @@ namespace ippl {
     template <unsigned Dim>
     FieldLayout<Dim>::FieldLayout()
         : dLocalDomains_m("local domains (device)", 0)
-        , hLocalDomains_m(Kokkos::create_mirror_view(dLocalDomains_m)) {
+        , hLocalDomains_m(Kokkos::create_mirror_view(dLocalDomains_m))
+        , version_m(detail::nextLayoutVersion()) {
         for (unsigned int d = 0; d < Dim; ++d) {
             requestedLayout_m[d] = PARALLEL;
             minWidth_m[d]        = 0;
@@ -97,6 +98,7 @@ namespace ippl {
             Kokkos::resize(hLocalDomains_m, nRanks);
             hLocalDomains_m(0) = domain;
             Kokkos::deep_copy(dLocalDomains_m, hLocalDomains_m);
+            version_m = detail::nextLayoutVersion();
             return;
         }
 
@@ -169,6 +171,22 @@ namespace ippl {
         return neighborsRecvRange_m;
     }
 
+    template <unsigned Dim>
+    const typename FieldLayout<Dim>::face_neighbor_list& FieldLayout<Dim>::getSweepNeighbors()
+        const {
+        return sweepNeighbors_m;
+    }
+
+    template <unsigned Dim>
+    const typename FieldLayout<Dim>::face_range_list& FieldLayout<Dim>::getSweepSendRange() const {
+        return sweepSendRange_m;
+    }
+
+    template <unsigned Dim>
+    const typename FieldLayout<Dim>::face_range_list& FieldLayout<Dim>::getSweepRecvRange() const {
+        return sweepRecvRange_m;
+    }
+
     template <unsigned Dim>
     void FieldLayout<Dim>::write(std::ostream& out) const {
         if (Comm->rank() > 0) {
@@ -250,6 +268,7 @@ namespace ippl {
             neighborsSendRange_m[i].clear();
             neighborsRecvRange_m[i].clear();
         }
+        version_m = detail::nextLayoutVersion();
 
         int myRank = Comm->rank();
 
@@ -285,6 +304,108 @@ namespace ippl {
             }
             IpplTimings::stopTimer(findPeriodicNeighborsTimer);
         }
+
+        findSweepNeighbors(nghost);
+    }
+
+    template <unsigned Dim>
+    void FieldLayout<Dim>::findSweepNeighbors(int nghost) {
+        for (unsigned face = 0; face < 2 * Dim; ++face) {
+            sweepNeighbors_m[face].clear();
+            sweepSendRange_m[face].clear();
+            sweepRecvRange_m[face].clear();
+        }
+
+        int myRank          = Comm->rank();
+        const NDIndex_t& nd = hLocalDomains_m[myRank];
+        for (int rank = 0; rank < Comm->size(); ++rank) {
+            if (rank == myRank) {
+                // periodic serial dimensions are filled locally
+                continue;
+            }
+
+            const NDIndex_t& ndNeighbor = hLocalDomains_m[rank];
+            for (unsigned d = 0; d < Dim; ++d) {
+                // 0 - neighbor on the lower side
+                // 1 - neighbor on the upper side
+                for (int side = 0; side < 2; ++side) {
+                    // across the global boundary, the neighbor is shifted by the period
+                    int shift = 0;
+                    if (side == 0 ? nd[d].min() == gDomain_m[d].min()
+                                  : nd[d].max() == gDomain_m[d].max()) {
+                        if (!isAllPeriodic_m) {
+                            continue;
+                        }
+                        const int period = gDomain_m[d].length();
+                        shift            = side == 0 ? -period : period;
+                    }
+
+                    NDIndex_t shifted = ndNeighbor;
+                    shifted[d] += shift;
+                    NDIndex_t recvCells;
+                    if (!getSweepCells(nd, shifted, d, side, nghost, recvCells)) {
+                        continue;
+                    }
+
+                    // the neighbor sees us on its opposite side
+                    NDIndex_t local = nd;
+                    local[d] -= shift;
+                    NDIndex_t sendCells;
+                    getSweepCells(ndNeighbor, local, d, 1 - side, nghost, sendCells);
+                    sendCells[d] += shift;
+
+                    const unsigned face = 2 * d + side;
+                    sweepNeighbors_m[face].push_back(rank);
+                    sweepSendRange_m[face].push_back(toBounds(sendCells, nd, nghost));
+                    sweepRecvRange_m[face].push_back(toBounds(recvCells, nd, nghost));
+                }
+            }
+        }
+    }
+
+    template <unsigned Dim>
+    bool FieldLayout<Dim>::getSweepCells(const NDIndex_t& nd, const NDIndex_t& ndNeighbor,
+                                         unsigned d, int side, int nghost,
+                                         NDIndex_t& cells) const {
+        for (unsigned j = 0; j < Dim; ++j) {
+            Index face = nd[j];
+            if (j == d) {
+                face = side == 0 ? Index(nd[d].first() - nghost, nd[d].first() - 1)
+                                 : Index(nd[d].last() + 1, nd[d].last() + nghost);
+            }
+            cells[j] = face.intersect(ndNeighbor[j]);
+            if (cells[j].empty()) {
+                return false;
+            }
+        }
+
+        /* The halo cells of the dimensions before d were filled in the previous
+         * steps. The neighbor provides those next to the cells it owns, which
+         * are all halo cells of the face except across a non-periodic boundary.
+         */
+        for (unsigned j = 0; j < d; ++j) {
+            int first = cells[j].first(), last = cells[j].last();
+            if (first == nd[j].first() && (isAllPeriodic_m || nd[j].min() != gDomain_m[j].min())) {
+                first -= nghost;
+            }
+            if (last == nd[j].last() && (isAllPeriodic_m || nd[j].max() != gDomain_m[j].max())) {
+                last += nghost;
+            }
+            cells[j] = Index(first, last);
+        }
+        return true;
+    }
+
+    template <unsigned Dim>
+    typename FieldLayout<Dim>::bound_type FieldLayout<Dim>::toBounds(const NDIndex_t& cells,
+                                                                     const NDIndex_t& offset,
+                                                                     int nghost) {
+        bound_type bounds;
+        for (unsigned i = 0; i < Dim; ++i) {
+            bounds.lo[i] = cells[i].first() - offset[i].first() + nghost;
+            bounds.hi[i] = cells[i].last() - offset[i].first() + nghost + 1;
+        }
+        return bounds;
     }
 
     template <unsigned Dim>
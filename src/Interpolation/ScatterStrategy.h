@@ -0,0 +1,144 @@
+//
+// Scatter strategies
+//   Policies selecting how ParticleAttrib::scatter accumulates the particle
+//   contributions on the field. Every particle adds to width^Dim grid points,
+//   where width is the support of the shape function, and several particles
+//   may hit the same point, so the updates have to be combined without races:
+//     - AtomicScatter adds every contribution with an atomic operation.
+//     - DuplicatedScatter uses a Kokkos::ScatterView, i.e. one copy of the
+//       field per thread on host backends, which is reduced at the end.
+//     - SortedScatter requires the particles to be sorted by cell for the
+//       same shape function (see ParticleBase::sort). Runs of particles
+//       sharing a stencil are reduced first and the sums are added to the
+//       field without any atomics.
+//     - TiledScatter accumulates chunks of consecutive particles in a
+//       field tile in team scratch memory and adds the tile to the field once.
+//     - DefaultScatter picks a strategy based on the execution space.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_SCATTER_STRATEGY_H
+#define IPPL_SCATTER_STRATEGY_H
+
+#include <Kokkos_Core.hpp>
+
+#include <type_traits>
+
+#include "Types/IpplTypes.h"
+#include "Types/Vector.h"
+
+namespace ippl {
+    //! Atomic update of every stencil point
+    struct AtomicScatter {};
+
+    //! Per-thread duplicates of the field through Kokkos::ScatterView
+    struct DuplicatedScatter {};
+
+    /*!
+     * Segmented reduction over particles sorted with SortOrder::Lexicographic;
+     * falls back to atomics if the particles are not sorted
+     */
+    struct SortedScatter {};
+
+    //! Accumulation of particle chunks in a field tile in team scratch memory
+    struct TiledScatter {
+        //! Number of consecutive particles handled by one team
+        unsigned particlesPerTile = 1024;
+
+        //! Largest number of grid points in a tile; chunks that cover more
+        //  points are scattered with atomics
+        unsigned maxTileSize = 4096;
+    };
+
+    //! Duplicated scatter on host backends and atomic scatter on devices
+    struct DefaultScatter {};
+
+    namespace detail {
+        template <typename Strategy, typename ExecutionSpace>
+        struct ResolveScatterStrategy {
+            using type = Strategy;
+        };
+
+        template <typename ExecutionSpace>
+        struct ResolveScatterStrategy<DefaultScatter, ExecutionSpace> {
+            using type = std::conditional_t<
+                Kokkos::SpaceAccessibility<ExecutionSpace, Kokkos::HostSpace>::accessible,
+                DuplicatedScatter, AtomicScatter>;
+        };
+
+        /*!
+         * The strategy that is actually run for a given strategy and execution space
+         */
+        template <typename Strategy, typename ExecutionSpace>
+        using scatter_strategy_t =
+            typename ResolveScatterStrategy<Strategy, ExecutionSpace>::type;
+
+        /*!
+         * Scatter kernels; specialized for every strategy
+         * @tparam Strategy the scatter strategy
+         */
+        template <typename Strategy>
+        struct ScatterKernel;
+
+        template <>
+        struct ScatterKernel<AtomicScatter> {
+            /*!
+             * Scatter the values of the particles on the field
+             * @param strategy the strategy and its parameters
+             * @param view the field view including ghost cells
+             * @param positions the particle positions
+             * @param values the particle values
+             * @param dead the particles to skip (see isDead)
+             * @param n the number of particles
+             * @param map the map from positions to stencils (see StencilMap)
+             */
+            template <typename View, typename PositionView, typename ValueView, typename MaskView,
+                      typename StencilMap>
+            static void apply(const AtomicScatter& strategy, const View& view,
+                              const PositionView& positions, const ValueView& values,
+                              const MaskView& dead, size_type n, const StencilMap& map);
+        };
+
+        template <>
+        struct ScatterKernel<DuplicatedScatter> {
+            template <typename View, typename PositionView, typename ValueView, typename MaskView,
+                      typename StencilMap>
+            static void apply(const DuplicatedScatter& strategy, const View& view,
+                              const PositionView& positions, const ValueView& values,
+                              const MaskView& dead, size_type n, const StencilMap& map);
+        };
+
+        template <>
+        struct ScatterKernel<SortedScatter> {
+            template <typename View, typename PositionView, typename ValueView, typename MaskView,
+                      typename StencilMap>
+            static void apply(const SortedScatter& strategy, const View& view,
+                              const PositionView& positions, const ValueView& values,
+                              const MaskView& dead, size_type n, const StencilMap& map);
+        };
+
+        template <>
+        struct ScatterKernel<TiledScatter> {
+            template <typename View, typename PositionView, typename ValueView, typename MaskView,
+                      typename StencilMap>
+            static void apply(const TiledScatter& strategy, const View& view,
+                              const PositionView& positions, const ValueView& values,
+                              const MaskView& dead, size_type n, const StencilMap& map);
+        };
+    }  // namespace detail
+}  // namespace ippl
+
+#include "Interpolation/ScatterStrategy.hpp"
+
+#endif
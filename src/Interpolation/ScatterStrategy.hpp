@@ -0,0 +1,364 @@
+//
+// Scatter strategies
+//   Kernels implementing the scatter strategies of ParticleAttrib::scatter.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include <Kokkos_ScatterView.hpp>
+
+#include <cstdint>
+
+#include "Expression/IpplOperations.h"
+#include "Interpolation/ShapeFunctions.h"
+#include "Particle/ParticleAttribBase.h"
+#include "Particle/ParticleSort.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * Adds the weighted value of a particle to the sums of all stencil points
+         * @param sums the sums, one per stencil point
+         * @param stencil the particle stencil
+         * @param val the particle value
+         */
+        template <unsigned long... Point, typename Shape, typename T, unsigned Dim>
+        KOKKOS_INLINE_FUNCTION void accumulateStencil(const std::index_sequence<Point...>&,
+                                                      T* sums,
+                                                      const Stencil<Shape, T, Dim>& stencil,
+                                                      const T& val) {
+            ((sums[Point] += val * stencilWeight<Point>(std::make_index_sequence<Dim>{}, stencil)),
+             ...);
+        }
+
+        /*!
+         * Adds the sums of all runs for a single stencil point to the field. The
+         * stencils of the runs are distinct, so no two runs update the same entry.
+         * @tparam Shape the shape function
+         * @tparam Point the stencil point
+         * @param view the field view
+         * @param sums the sums of each run for each stencil point
+         * @param stencils the first stencil point of each run
+         * @param nRuns the number of runs
+         */
+        template <typename Shape, unsigned long Point, unsigned long... Index, typename View,
+                  typename SumView, typename StencilView>
+        void addRunSumsToPoint(const std::index_sequence<Index...>&, const View& view,
+                               const SumView& sums, const StencilView& stencils,
+                               size_type nRuns) {
+            using exec_space = typename SumView::execution_space;
+            Kokkos::parallel_for(
+                "ScatterKernel<SortedScatter>::addRunSums",
+                Kokkos::RangePolicy<exec_space>(0, nRuns), KOKKOS_LAMBDA(const size_t r) {
+                    view((stencils(r)[Index] + stencilOffset<Shape, Point, Index>())...) +=
+                        sums(r, Point);
+                });
+        }
+
+        template <typename Shape, unsigned long... Point, typename View, typename SumView,
+                  typename StencilView>
+        void addRunSums(const std::index_sequence<Point...>&, const View& view, const SumView& sums,
+                        const StencilView& stencils, size_type nRuns) {
+            (addRunSumsToPoint<Shape, Point>(std::make_index_sequence<View::rank>{}, view, sums,
+                                             stencils, nRuns),
+             ...);
+        }
+
+        template <typename View, typename PositionView, typename ValueView, typename MaskView,
+                  typename StencilMap>
+        void ScatterKernel<AtomicScatter>::apply(const AtomicScatter& /*strategy*/,
+                                                 const View& view, const PositionView& positions,
+                                                 const ValueView& values, const MaskView& dead,
+                                                 size_type n, const StencilMap& map) {
+            using exec_space = typename ValueView::execution_space;
+            using points     = stencil_sequence<typename StencilMap::shape_type, View::rank>;
+
+            Kokkos::parallel_for(
+                "ScatterKernel<AtomicScatter>", Kokkos::RangePolicy<exec_space>(0, n),
+                KOKKOS_LAMBDA(const size_t i) {
+                    if (isDead(dead, i)) {
+                        return;
+                    }
+
+                    const auto stencil = map(positions(i));
+
+                    scatterToField(points{}, view, stencil, values(i));
+                });
+            Kokkos::fence();
+        }
+
+        template <typename View, typename PositionView, typename ValueView, typename MaskView,
+                  typename StencilMap>
+        void ScatterKernel<DuplicatedScatter>::apply(const DuplicatedScatter& /*strategy*/,
+                                                     const View& view,
+                                                     const PositionView& positions,
+                                                     const ValueView& values, const MaskView& dead,
+                                                     size_type n, const StencilMap& map) {
+            using exec_space       = typename ValueView::execution_space;
+            using value_type       = typename ValueView::value_type;
+            using points           = stencil_sequence<typename StencilMap::shape_type, View::rank>;
+
+            using scatter_view_type =
+                Kokkos::Experimental::ScatterView<typename View::data_type,
+                                                  typename View::array_layout, exec_space,
+                                                  Kokkos::Experimental::ScatterSum>;
+            scatter_view_type scatter(view);
+
+            Kokkos::parallel_for(
+                "ScatterKernel<DuplicatedScatter>", Kokkos::RangePolicy<exec_space>(0, n),
+                KOKKOS_LAMBDA(const size_t i) {
+                    if (isDead(dead, i)) {
+                        return;
+                    }
+
+                    auto access = scatter.access();
+
+                    const auto stencil = map(positions(i));
+
+                    depositToField(
+                        points{},
+                        [&](const value_type& val, auto... idx) { access(idx...) += val; },
+                        stencil, values(i));
+                });
+            Kokkos::Experimental::contribute(view, scatter);
+            Kokkos::fence();
+        }
+
+        template <typename View, typename PositionView, typename ValueView, typename MaskView,
+                  typename StencilMap>
+        void ScatterKernel<SortedScatter>::apply(const SortedScatter& /*strategy*/,
+                                                 const View& view, const PositionView& positions,
+                                                 const ValueView& values, const MaskView& dead,
+                                                 size_type n, const StencilMap& map) {
+            using exec_space       = typename ValueView::execution_space;
+            using memory_space     = typename ValueView::memory_space;
+            using value_type       = typename ValueView::value_type;
+            using array_layout     = typename View::array_layout;
+            using policy_type      = Kokkos::RangePolicy<exec_space>;
+            using shape_type       = typename StencilMap::shape_type;
+            using points           = stencil_sequence<shape_type, View::rank>;
+            constexpr unsigned Dim = View::rank;
+            constexpr size_t size  = stencilSize<shape_type, Dim>();
+
+            if (n == 0) {
+                return;
+            }
+
+            Vector<int, Dim> extent;
+            for (unsigned d = 0; d < Dim; ++d) {
+                extent[d] = view.extent(d);
+            }
+
+            // key of the stencil of every particle, in the memory order of the view;
+            // dead particles have the largest key and may only trail the live ones
+            Kokkos::View<std::uint64_t*, memory_space> keys("stencil keys", n);
+            Kokkos::parallel_for(
+                "ScatterKernel<SortedScatter>::keys", policy_type(0, n),
+                KOKKOS_LAMBDA(const size_t i) {
+                    if (isDead(dead, i)) {
+                        keys(i) = UINT64_MAX;
+                        return;
+                    }
+
+                    const auto stencil = map(positions(i));
+
+                    Vector<int, Dim> cell = stencil.first;
+                    keys(i) = cellKey<array_layout>(cell, extent, SortOrder::Lexicographic);
+                });
+
+            // the runs of equal keys are only distinct if the keys are sorted
+            size_type descents = 0;
+            Kokkos::parallel_reduce(
+                "ScatterKernel<SortedScatter>::descents", policy_type(0, n - 1),
+                KOKKOS_LAMBDA(const size_t i, size_type& count) { count += keys(i) > keys(i + 1); },
+                Kokkos::Sum<size_type>(descents));
+
+            if (descents > 0) {
+                ScatterKernel<AtomicScatter>::apply(AtomicScatter{}, view, positions, values, dead,
+                                                    n, map);
+                return;
+            }
+
+            Kokkos::View<size_type*, memory_space> runStart("run starts", n + 1);
+            size_type nRuns = 0;
+            Kokkos::parallel_scan(
+                "ScatterKernel<SortedScatter>::runs", policy_type(0, n),
+                KOKKOS_LAMBDA(const size_t i, size_type& run, const bool final) {
+                    // trailing dead particles are appended to the last run
+                    if (!isDead(dead, i) && (i == 0 || keys(i) != keys(i - 1))) {
+                        if (final) {
+                            runStart(run) = i;
+                        }
+                        run += 1;
+                    }
+                },
+                nRuns);
+            Kokkos::parallel_for(
+                "ScatterKernel<SortedScatter>::lastRun", policy_type(0, 1),
+                KOKKOS_LAMBDA(const size_t) { runStart(nRuns) = n; });
+
+            // segmented reduction: each run is summed up by a single thread
+            Kokkos::View<value_type**, memory_space> sums("run sums", nRuns, size);
+            Kokkos::View<Vector<size_t, Dim>*, memory_space> stencils("run stencils", nRuns);
+            Kokkos::parallel_for(
+                "ScatterKernel<SortedScatter>::reduce", policy_type(0, nRuns),
+                KOKKOS_LAMBDA(const size_t r) {
+                    value_type local[size] = {};
+
+                    for (size_type i = runStart(r); i < runStart(r + 1); ++i) {
+                        if (isDead(dead, i)) {
+                            continue;
+                        }
+                        const auto stencil = map(positions(i));
+                        accumulateStencil(points{}, local, stencil, values(i));
+                    }
+
+                    stencils(r) = map(positions(runStart(r))).first;
+                    for (unsigned s = 0; s < size; ++s) {
+                        sums(r, s) = local[s];
+                    }
+                });
+
+            addRunSums<shape_type>(points{}, view, sums, stencils, nRuns);
+            Kokkos::fence();
+        }
+
+        template <typename View, typename PositionView, typename ValueView, typename MaskView,
+                  typename StencilMap>
+        void ScatterKernel<TiledScatter>::apply(const TiledScatter& strategy, const View& view,
+                                                const PositionView& positions,
+                                                const ValueView& values, const MaskView& dead,
+                                                size_type n, const StencilMap& map) {
+            using exec_space       = typename ValueView::execution_space;
+            using value_type       = typename ValueView::value_type;
+            using shape_type       = typename StencilMap::shape_type;
+            using points           = stencil_sequence<shape_type, View::rank>;
+            constexpr unsigned Dim = View::rank;
+
+            using team_policy = Kokkos::TeamPolicy<exec_space>;
+            using member_type = typename team_policy::member_type;
+            using tile_type   = Kokkos::View<value_type*, typename exec_space::scratch_memory_space,
+                                           Kokkos::MemoryUnmanaged>;
+
+            if (n == 0) {
+                return;
+            }
+
+            const size_type chunk   = strategy.particlesPerTile;
+            const size_type maxSize = strategy.maxTileSize;
+            const int nTiles        = (n + chunk - 1) / chunk;
+
+            Kokkos::parallel_for(
+                "ScatterKernel<TiledScatter>",
+                team_policy(nTiles, Kokkos::AUTO)
+                    .set_scratch_size(0, Kokkos::PerTeam(tile_type::shmem_size(maxSize))),
+                KOKKOS_LAMBDA(const member_type& team) {
+                    const size_type begin = team.league_rank() * chunk;
+                    const size_type end   = begin + chunk < n ? begin + chunk : n;
+
+                    // bounding box of the stencils of this chunk
+                    Vector<int, Dim> lo, extent;
+                    size_type tileSize = 1;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        int firstMin = 0, firstMax = 0;
+                        Kokkos::parallel_reduce(
+                            Kokkos::TeamThreadRange(team, begin, end),
+                            [&](const size_type i, int& val) {
+                                if (isDead(dead, i)) {
+                                    return;
+                                }
+                                const auto stencil = map(positions(i));
+                                if ((int)stencil.first[d] < val) {
+                                    val = stencil.first[d];
+                                }
+                            },
+                            Kokkos::Min<int>(firstMin));
+                        Kokkos::parallel_reduce(
+                            Kokkos::TeamThreadRange(team, begin, end),
+                            [&](const size_type i, int& val) {
+                                if (isDead(dead, i)) {
+                                    return;
+                                }
+                                const auto stencil = map(positions(i));
+                                if ((int)stencil.first[d] > val) {
+                                    val = stencil.first[d];
+                                }
+                            },
+                            Kokkos::Max<int>(firstMax));
+
+                        // all particles of the chunk are dead
+                        if (firstMax < firstMin) {
+                            return;
+                        }
+                        lo[d]     = firstMin;
+                        extent[d] = firstMax - firstMin + shape_type::width;
+                        tileSize *= extent[d];
+                    }
+
+                    // scattered particles do not fit into a tile
+                    if (tileSize > maxSize) {
+                        Kokkos::parallel_for(
+                            Kokkos::TeamThreadRange(team, begin, end), [&](const size_type i) {
+                                if (isDead(dead, i)) {
+                                    return;
+                                }
+                                const auto stencil = map(positions(i));
+
+                                scatterToField(points{}, view, stencil, values(i));
+                            });
+                        return;
+                    }
+
+                    tile_type tile(team.team_scratch(0), maxSize);
+                    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, tileSize),
+                                         [&](const size_type k) { tile(k) = 0; });
+                    team.team_barrier();
+
+                    Kokkos::parallel_for(
+                        Kokkos::TeamThreadRange(team, begin, end), [&](const size_type i) {
+                            if (isDead(dead, i)) {
+                                return;
+                            }
+                            const auto stencil = map(positions(i));
+
+                            depositToField(
+                                points{},
+                                [&](const value_type& val, auto... idx) {
+                                    size_type k = 0;
+                                    unsigned d  = 0;
+                                    ((k = k * extent[d] + (int(idx) - lo[d]), ++d), ...);
+                                    Kokkos::atomic_add(&tile(k), val);
+                                },
+                                stencil, values(i));
+                        });
+                    team.team_barrier();
+
+                    // flush the tile
+                    Kokkos::parallel_for(
+                        Kokkos::TeamThreadRange(team, tileSize), [&](const size_type k) {
+                            if (tile(k) == 0) {
+                                return;
+                            }
+                            Vector<size_t, Dim> index;
+                            size_type rest = k;
+                            for (int d = Dim - 1; d >= 0; --d) {
+                                index[d] = lo[d] + rest % extent[d];
+                                rest /= extent[d];
+                            }
+                            Kokkos::atomic_add(&ippl::apply(view, index), tile(k));
+                        });
+                });
+            Kokkos::fence();
+        }
+    }  // namespace detail
+}  // namespace ippl
@@ -0,0 +1,243 @@
+//
+// Shape functions
+//   Particle shape functions for the interpolation between particles and
+//   grids. A shape function is a struct describing the one-dimensional
+//   weights of a particle on the grid points around it; the stencil in
+//   several dimensions is the tensor product of these weights. The number
+//   of points per dimension (the width of the support) is known at compile
+//   time, so all loops over the stencil are unrolled.
+//     - CIC: first order, cloud-in-cell (2 points per dimension)
+//     - TSC: second order, triangular-shaped cloud (3 points per dimension)
+//     - PCS: third order, piecewise cubic spline (4 points per dimension)
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_SHAPE_FUNCTIONS_H
+#define IPPL_SHAPE_FUNCTIONS_H
+
+#include <Kokkos_Core.hpp>
+
+#include <utility>
+
+#include "Types/Vector.h"
+
+#include "Utility/IpplException.h"
+
+namespace ippl {
+    /*
+     * All shape functions work with the particle position s in units of the mesh
+     * spacing, measured such that the centre of cell i is at s = i. They provide
+     *   width           the number of grid points per dimension
+     *   nghost          the number of ghost layers the field needs so that the stencils
+     *                   of all particles in the local domain fit into the field view
+     *   first(s)        the index of the first grid point of the stencil
+     *   weights(d, w)   the weights of the points first, ..., first + width - 1
+     *                   for the distance d = s - first
+     */
+
+    //! Cloud-in-cell (linear) shape function
+    struct CIC {
+        static constexpr unsigned width = 2;
+        static constexpr int nghost     = 1;
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION static int first(T s);
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION static void weights(T d, T* w);
+    };
+
+    //! Triangular-shaped cloud (quadratic) shape function
+    struct TSC {
+        static constexpr unsigned width = 3;
+        static constexpr int nghost     = 1;
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION static int first(T s);
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION static void weights(T d, T* w);
+    };
+
+    /*!
+     * Piecewise cubic spline shape function. The stencils need two ghost layers,
+     * while the halo exchange of FieldLayout between ranks is set up for one layer;
+     * PCS is therefore restricted to fields that are not distributed, which
+     * scatter and gather check (see detail::checkShapeSupport).
+     */
+    struct PCS {
+        static constexpr unsigned width = 4;
+        static constexpr int nghost     = 2;
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION static int first(T s);
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION static void weights(T d, T* w);
+    };
+
+    namespace detail {
+        /*!
+         * The grid points and weights of a single particle
+         * @tparam Shape the shape function
+         * @tparam T the weight type
+         * @tparam Dim the number of dimensions
+         */
+        template <typename Shape, typename T, unsigned Dim>
+        struct Stencil {
+            //! View index of the first point along each dimension
+            Vector<size_t, Dim> first;
+
+            //! Weights of the points along each dimension
+            T weights[Dim][Shape::width];
+        };
+
+        /*!
+         * Computes the stencil of a particle on the local field view
+         * @tparam Shape the shape function
+         * @tparam T the weight type
+         * @tparam Dim the number of dimensions
+         * @tparam VectorType the mesh vector type
+         */
+        template <typename Shape, typename T, unsigned Dim, typename VectorType>
+        struct StencilMap {
+            using shape_type = Shape;
+
+            VectorType origin;
+            VectorType invdx;
+
+            //! First local index minus the number of ghost cells
+            Vector<int, Dim> offset;
+
+            /*!
+             * @param pos the particle position
+             * @return The stencil of the particle
+             */
+            template <typename PositionType>
+            KOKKOS_INLINE_FUNCTION Stencil<Shape, T, Dim> operator()(
+                const PositionType& pos) const;
+        };
+
+        /*!
+         * The number of grid points of a stencil
+         */
+        template <typename Shape, unsigned Dim>
+        constexpr unsigned long stencilSize() {
+            unsigned long size = 1;
+            for (unsigned d = 0; d < Dim; ++d) {
+                size *= Shape::width;
+            }
+            return size;
+        }
+
+        /*!
+         * The index sequence over all points of a stencil
+         */
+        template <typename Shape, unsigned Dim>
+        using stencil_sequence = std::make_index_sequence<stencilSize<Shape, Dim>()>;
+
+        /*!
+         * The position of a stencil point along an axis
+         * @tparam Point the index of the point in the stencil
+         * @tparam Axis the axis
+         */
+        template <typename Shape, unsigned long Point, unsigned long Axis>
+        constexpr unsigned long stencilOffset() {
+            unsigned long point = Point;
+            for (unsigned long d = 0; d < Axis; ++d) {
+                point /= Shape::width;
+            }
+            return point % Shape::width;
+        }
+
+        /*!
+         * Computes the view index of a stencil point along an axis
+         * @tparam Point the index of the point in the stencil
+         * @tparam Axis the axis
+         * @param stencil the particle stencil
+         */
+        template <unsigned long Point, unsigned long Axis, typename Shape, typename T, unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr size_t stencilIndex(const Stencil<Shape, T, Dim>& stencil);
+
+        /*!
+         * Computes the weight of a stencil point
+         * @tparam Point the index of the point in the stencil
+         * @tparam Axis the sequence 0...Dim - 1
+         * @param stencil the particle stencil
+         * @return The product of the axial weights of the point
+         */
+        template <unsigned long Point, unsigned long... Axis, typename Shape, typename T,
+                  unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr T stencilWeight(const std::index_sequence<Axis...>&,
+                                                         const Stencil<Shape, T, Dim>& stencil);
+
+        /*!
+         * Hands the weighted value of a particle for every stencil point to a functor
+         * @tparam Point... the indices of the stencil points (see stencil_sequence)
+         * @tparam Deposit functor called as deposit(value, indices...) for every point
+         * @param deposit the functor accumulating the contributions
+         * @param stencil the particle stencil
+         * @param val the value to interpolate
+         */
+        template <unsigned long... Point, typename Deposit, typename Shape, typename T,
+                  unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr void depositToField(const std::index_sequence<Point...>&,
+                                                             const Deposit& deposit,
+                                                             const Stencil<Shape, T, Dim>& stencil,
+                                                             const T& val);
+
+        /*!
+         * Scatters a particle value to the field with atomic updates
+         * @tparam Point... the indices of the stencil points (see stencil_sequence)
+         * @param view the field view on which to scatter
+         * @param stencil the particle stencil
+         * @param val the value to interpolate
+         */
+        template <unsigned long... Point, typename View, typename Shape, typename T,
+                  unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr void scatterToField(const std::index_sequence<Point...>&,
+                                                             const View& view,
+                                                             const Stencil<Shape, T, Dim>& stencil,
+                                                             T val = 1);
+
+        /*!
+         * Check that the stencils of a shape function fit into the field view and
+         * that the halo exchange covers them. The exchange between ranks handles a
+         * single ghost layer, so wider stencils need a field that is not distributed.
+         * @tparam Shape the shape function
+         * @param f the field
+         * @param where the calling function
+         * @throws IpplException if the shape function cannot be used with the field
+         */
+        template <typename Shape, typename Field>
+        void checkShapeSupport(const Field& f, const char* where);
+
+        /*!
+         * Gathers the field value at a particle position
+         * @tparam Point... the indices of the stencil points (see stencil_sequence)
+         * @param view the field view from which to gather
+         * @param stencil the particle stencil
+         * @return The interpolated value
+         */
+        template <unsigned long... Point, typename View, typename Shape, typename T,
+                  unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr typename View::value_type gatherFromField(
+            const std::index_sequence<Point...>&, const View& view,
+            const Stencil<Shape, T, Dim>& stencil);
+    }  // namespace detail
+}  // namespace ippl
+
+#include "Interpolation/ShapeFunctions.hpp"
+
+#endif
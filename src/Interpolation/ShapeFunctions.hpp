@@ -0,0 +1,157 @@
+//
+// Shape functions
+//   Particle shape functions for the interpolation between particles and
+//   grids.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+
+namespace ippl {
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION int CIC::first(T s) {
+        return Kokkos::floor(s);
+    }
+
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION void CIC::weights(T d, T* w) {
+        w[0] = 1 - d;
+        w[1] = d;
+    }
+
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION int TSC::first(T s) {
+        return Kokkos::floor(s + T(0.5)) - 1;
+    }
+
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION void TSC::weights(T d, T* w) {
+        // distance from the nearest grid point, in [-1/2, 1/2)
+        const T x = d - 1;
+        w[0]      = T(0.5) * (T(0.5) - x) * (T(0.5) - x);
+        w[1]      = T(0.75) - x * x;
+        w[2]      = T(0.5) * (T(0.5) + x) * (T(0.5) + x);
+    }
+
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION int PCS::first(T s) {
+        return Kokkos::floor(s) - 1;
+    }
+
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION void PCS::weights(T d, T* w) {
+        // distance from the grid point to the left, in [0, 1)
+        const T x  = d - 1;
+        const T x2 = x * x;
+        const T x3 = x2 * x;
+        w[0]       = (1 - x) * (1 - x) * (1 - x) / 6;
+        w[1]       = (4 - 6 * x2 + 3 * x3) / 6;
+        w[2]       = (1 + 3 * x + 3 * x2 - 3 * x3) / 6;
+        w[3]       = x3 / 6;
+    }
+
+    namespace detail {
+        template <typename Shape, typename T, unsigned Dim, typename VectorType>
+        template <typename PositionType>
+        KOKKOS_INLINE_FUNCTION Stencil<Shape, T, Dim>
+        StencilMap<Shape, T, Dim, VectorType>::operator()(const PositionType& pos) const {
+            Stencil<Shape, T, Dim> stencil;
+            for (unsigned d = 0; d < Dim; ++d) {
+                const T s   = (pos[d] - origin[d]) * invdx[d] - T(0.5);
+                const int i = Shape::first(s);
+                Shape::weights(s - i, stencil.weights[d]);
+                stencil.first[d] = i - offset[d];
+            }
+            return stencil;
+        }
+
+        template <unsigned long Point, unsigned long Axis, typename Shape, typename T, unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr size_t stencilIndex(
+            const Stencil<Shape, T, Dim>& stencil) {
+            return stencil.first[Axis] + stencilOffset<Shape, Point, Axis>();
+        }
+
+        template <unsigned long Point, unsigned long... Axis, typename Shape, typename T,
+                  unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr T stencilWeight(const std::index_sequence<Axis...>&,
+                                                         const Stencil<Shape, T, Dim>& stencil) {
+            return (stencil.weights[Axis][stencilOffset<Shape, Point, Axis>()] * ...);
+        }
+
+        template <unsigned long Point, unsigned long... Axis, typename Deposit, typename Shape,
+                  typename T, unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr int depositToPoint(const std::index_sequence<Axis...>&,
+                                                            const Deposit& deposit,
+                                                            const Stencil<Shape, T, Dim>& stencil,
+                                                            const T& val) {
+            deposit(val * (stencil.weights[Axis][stencilOffset<Shape, Point, Axis>()] * ...),
+                    stencilIndex<Point, Axis>(stencil)...);
+            return 0;
+        }
+
+        template <unsigned long... Point, typename Deposit, typename Shape, typename T,
+                  unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr void depositToField(const std::index_sequence<Point...>&,
+                                                             const Deposit& deposit,
+                                                             const Stencil<Shape, T, Dim>& stencil,
+                                                             const T& val) {
+            // The number of indices is Dim
+            [[maybe_unused]] auto _ =
+                (depositToPoint<Point>(std::make_index_sequence<Dim>{}, deposit, stencil, val)
+                 ^ ...);
+        }
+
+        template <unsigned long... Point, typename View, typename Shape, typename T,
+                  unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr void scatterToField(const std::index_sequence<Point...>&,
+                                                             const View& view,
+                                                             const Stencil<Shape, T, Dim>& stencil,
+                                                             T val) {
+            depositToField(
+                std::index_sequence<Point...>{},
+                [&](const T& value, auto... idx) { Kokkos::atomic_add(&view(idx...), value); },
+                stencil, val);
+        }
+
+        template <unsigned long Point, unsigned long... Axis, typename View, typename Shape,
+                  typename T, unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr typename View::value_type gatherFromPoint(
+            const std::index_sequence<Axis...>&, const View& view,
+            const Stencil<Shape, T, Dim>& stencil) {
+            return (stencil.weights[Axis][stencilOffset<Shape, Point, Axis>()] * ...)
+                   * view(stencilIndex<Point, Axis>(stencil)...);
+        }
+
+        template <unsigned long... Point, typename View, typename Shape, typename T,
+                  unsigned Dim>
+        KOKKOS_INLINE_FUNCTION constexpr typename View::value_type gatherFromField(
+            const std::index_sequence<Point...>&, const View& view,
+            const Stencil<Shape, T, Dim>& stencil) {
+            // The number of indices is Dim
+            return (gatherFromPoint<Point>(std::make_index_sequence<Dim>{}, view, stencil) + ...);
+        }
+
+        template <typename Shape, typename Field>
+        void checkShapeSupport(const Field& f, const char* where) {
+            if (f.getNghost() < Shape::nghost) {
+                throw IpplException(where, "The field has too few ghost layers for the "
+                                           "stencils of the shape function.");
+            }
+            if (Shape::nghost > 1 && f.getLayout().getHostLocalDomains().extent(0) > 1) {
+                throw IpplException(where, "The halo exchange covers one ghost layer, so "
+                                           "the shape function needs a field that is not "
+                                           "distributed.");
+            }
+        }
+    }  // namespace detail
+}  // namespace ippl
@@ -61,6 +61,18 @@ namespace ippl {
                     } else {
                         throw std::runtime_error("Invalid timer fence option");
                     }
+                } else if (detail::checkOption(argv[nargs], "--halo-exchange", "")) {
+                    ++nargs;
+                    if (nargs >= argc) {
+                        throw std::runtime_error("Missing halo exchange mode!");
+                    }
+                    if (std::strcmp(argv[nargs], "neighbor") == 0) {
+                        defaultHaloExchange = HaloExchange::NEIGHBOR;
+                    } else if (std::strcmp(argv[nargs], "sweep") == 0) {
+                        defaultHaloExchange = HaloExchange::SWEEP;
+                    } else {
+                        throw std::runtime_error("Invalid halo exchange mode");
+                    }
                 } else if (detail::checkOption(argv[nargs], "--version", "-v")) {
                     IpplInfo::printVersion();
                     std::string options = IpplInfo::compileOptions();
@@ -43,8 +43,16 @@
 
 #include "Types/Vector.h"
 
+#include "Particle/ParticleAssignment.h"
 #include "Particle/ParticleBase.h"
+#include "Particle/ParticleMoments.h"
+#include "Particle/ParticlePusher.h"
+#include "Particle/SoAParticleAttrib.h"
 #include "Particle/ParticleSpatialLayout.h"
+#include "Particle/NeighborList.h"
+
+// IPPL random sampling
+#include "Random/InverseTransformSampling.h"
 
 // // IPPL Load balancing
 #include "Decomposition/OrthogonalRecursiveBisection.h"
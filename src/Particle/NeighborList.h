@@ -0,0 +1,168 @@
+//
+// Class NeighborList
+//   Cell-linked list and Verlet neighbor list for short-range particle-particle
+//   interactions.
+//
+//   The local particles and the ghosts of a ParticleSpatialLayout are binned
+//   into the cells of a uniform Cartesian grid covering the local region and
+//   the ghost shell, with cells at least as wide as cutoff + skin. The Verlet
+//   list of every local particle then only holds the particles of the
+//   neighbouring cells within cutoff + skin, so that evaluating all pairs is
+//   O(N). The list is kept until a particle has moved further than skin / 2:
+//
+//     layout.updateGhosts(bunch, cutoff, skin);
+//     list.update(bunch);
+//     list.for_each_pair(bunch, cutoff, KOKKOS_LAMBDA(size_t i, size_t j,
+//                                                     const Vector_t& dist) {...});
+//
+//   Indices j >= bunch.getLocalNum() refer to the ghosts.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_NEIGHBOR_LIST_H
+#define IPPL_NEIGHBOR_LIST_H
+
+#include <Kokkos_Core.hpp>
+
+#include "Types/IpplTypes.h"
+#include "Types/ViewTypes.h"
+
+#include "Types/Vector.h"
+
+namespace ippl {
+    /*!
+     * Which pairs are stored in a neighbor list
+     */
+    enum class NeighborListType {
+        //! Every pair of local particles once (j > i) and every local-ghost pair;
+        //! kernels may update both particles of a local pair
+        Half,
+        //! Every neighbor j of every local particle i; kernels update i only
+        Full
+    };
+
+    /*!
+     * Cell-linked list and Verlet neighbor list
+     * @tparam T the position value type
+     * @tparam Dim the dimension
+     * @tparam MemorySpace the memory space of the positions
+     */
+    template <typename T, unsigned Dim,
+              class MemorySpace = Kokkos::DefaultExecutionSpace::memory_space>
+    class NeighborList {
+    public:
+        using vector_type     = Vector<T, Dim>;
+        using memory_space    = MemorySpace;
+        using execution_space = typename memory_space::execution_space;
+        using size_type       = detail::size_type;
+
+        using position_view_type =
+            typename detail::ViewType<vector_type, 1, memory_space>::view_type;
+        using index_view_type = typename detail::ViewType<size_type, 1, memory_space>::view_type;
+
+        /*!
+         * @param cutoff the largest interaction range
+         * @param skin the additional range of the list; the list is rebuilt once
+         * a particle has moved further than skin / 2
+         * @param type whether pairs are stored once or for both particles
+         */
+        NeighborList(T cutoff, T skin, NeighborListType type = NeighborListType::Half);
+
+        /*!
+         * Bin the local particles and the ghosts of the layout into cells and
+         * build the neighbor lists
+         * @param bunch the particle bunch; its layout must be a ParticleSpatialLayout
+         */
+        template <class Bunch>
+        void build(const Bunch& bunch);
+
+        /*!
+         * Whether the list has to be rebuilt because particles moved further
+         * than half the skin, the particles changed or the ghosts were rebuilt.
+         * Must be called on all ranks.
+         * @param bunch the particle bunch
+         */
+        template <class Bunch>
+        bool needsRebuild(const Bunch& bunch) const;
+
+        /*!
+         * Rebuild the list if needed. Must be called on all ranks.
+         * @param bunch the particle bunch
+         * @returns Whether the list was rebuilt
+         */
+        template <class Bunch>
+        bool update(const Bunch& bunch);
+
+        /*!
+         * Call a functor for every pair of the list within the cutoff, using the
+         * current positions
+         * @param bunch the particle bunch
+         * @param cutoff the interaction range, at most the cutoff of the list
+         * @param f the functor, called as f(i, j, R(i) - R(j)) with the local
+         * particle i and the local particle or ghost j
+         */
+        template <class Bunch, class Functor>
+        void for_each_pair(const Bunch& bunch, T cutoff, const Functor& f) const;
+
+        T getCutoff() const { return cutoff_m; }
+
+        T getSkin() const { return skin_m; }
+
+        NeighborListType getType() const { return type_m; }
+
+        //! @returns the number of pairs stored in the list
+        size_type getPairNum() const { return pairNum_m; }
+
+        //! @returns how often the list has been built
+        unsigned getBuildCount() const { return builds_m; }
+
+        //! The start of each local particle's neighbors in getNeighbors()
+        const index_view_type& getNeighborOffsets() const { return neighborOffsets_m; }
+
+        const index_view_type& getNeighbors() const { return neighbors_m; }
+
+        //! The start of each cell's particles in getCellParticles()
+        const index_view_type& getCellOffsets() const { return cellOffsets_m; }
+
+        const index_view_type& getCellParticles() const { return cellParticles_m; }
+
+    private:
+        T cutoff_m;
+        T skin_m;
+        NeighborListType type_m;
+
+        //! The cell grid
+        vector_type origin_m;
+        vector_type invWidth_m;
+        Vector<int, Dim> nCells_m;
+
+        index_view_type cellOffsets_m;
+        index_view_type cellParticles_m;
+
+        index_view_type neighborOffsets_m;
+        index_view_type neighbors_m;
+        size_type pairNum_m = 0;
+
+        //! The local positions at build time and the state of the particles and ghosts
+        position_view_type buildR_m;
+        size_type localNum_m   = 0;
+        size_type ghostNum_m   = 0;
+        unsigned ghostBuilds_m = 0;
+        unsigned builds_m      = 0;
+    };
+}  // namespace ippl
+
+#include "Particle/NeighborList.hpp"
+
+#endif
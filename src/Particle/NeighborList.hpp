@@ -0,0 +1,370 @@
+//
+// Class NeighborList
+//   Cell-linked list and Verlet neighbor list for short-range particle-particle
+//   interactions.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include <algorithm>
+#include <limits>
+
+#include "Communicate/DataTypes.h"
+
+#include "Utility/IpplException.h"
+#include "Utility/IpplTimings.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * The local particles followed by the ghosts
+         */
+        template <typename LocalView, typename GhostView>
+        struct CombinedPositions {
+            LocalView local;
+            GhostView ghosts;
+            size_type nLocal;
+
+            KOKKOS_INLINE_FUNCTION auto operator()(const size_t k) const {
+                return k < nLocal ? local(k) : ghosts(k - nLocal);
+            }
+        };
+
+        template <typename T, unsigned Dim>
+        KOKKOS_INLINE_FUNCTION T distanceSquared(const Vector<T, Dim>& a,
+                                                 const Vector<T, Dim>& b) {
+            T r2 = 0;
+            for (unsigned d = 0; d < Dim; ++d) {
+                r2 += (a[d] - b[d]) * (a[d] - b[d]);
+            }
+            return r2;
+        }
+
+        /*!
+         * @returns The cell containing a position; positions outside the grid
+         * are assigned to the boundary cells
+         */
+        template <typename T, unsigned Dim>
+        KOKKOS_INLINE_FUNCTION Vector<int, Dim> binPosition(const Vector<T, Dim>& x,
+                                                            const Vector<T, Dim>& origin,
+                                                            const Vector<T, Dim>& invWidth,
+                                                            const Vector<int, Dim>& nCells) {
+            Vector<int, Dim> cell;
+            for (unsigned d = 0; d < Dim; ++d) {
+                const T c = Kokkos::floor((x[d] - origin[d]) * invWidth[d]);
+                cell[d]   = c < 0 ? 0 : (c >= nCells[d] ? nCells[d] - 1 : int(c));
+            }
+            return cell;
+        }
+
+        template <unsigned Dim>
+        KOKKOS_INLINE_FUNCTION size_t linearCell(const Vector<int, Dim>& cell,
+                                                 const Vector<int, Dim>& nCells) {
+            size_t index = 0;
+            for (int d = Dim - 1; d >= 0; --d) {
+                index = index * nCells[d] + cell[d];
+            }
+            return index;
+        }
+
+        /*!
+         * Call a functor with the index of every cell adjacent to the given
+         * one, including the cell itself
+         */
+        template <unsigned Dim, typename Functor>
+        KOKKOS_INLINE_FUNCTION void forEachAdjacentCell(const Vector<int, Dim>& cell,
+                                                        const Vector<int, Dim>& nCells,
+                                                        Functor&& f) {
+            int nAdjacent = 1;
+            for (unsigned d = 0; d < Dim; ++d) {
+                nAdjacent *= 3;
+            }
+            for (int s = 0; s < nAdjacent; ++s) {
+                Vector<int, Dim> other;
+                bool inside = true;
+                for (unsigned d = 0, code = s; d < Dim; ++d, code /= 3) {
+                    other[d] = cell[d] + int(code % 3) - 1;
+                    inside &= other[d] >= 0 && other[d] < nCells[d];
+                }
+                if (inside) {
+                    f(linearCell(other, nCells));
+                }
+            }
+        }
+
+        /*!
+         * Finds the particles within range of a local particle in the adjacent
+         * cells of a cell-linked list
+         */
+        template <typename Positions, typename IndexView, typename T, unsigned Dim>
+        struct VerletSearch {
+            Positions pos;
+            IndexView cellOffsets;
+            IndexView cellParticles;
+            Vector<T, Dim> origin;
+            Vector<T, Dim> invWidth;
+            Vector<int, Dim> nCells;
+            T range2;
+            //! only report the neighbors with a larger index
+            bool half;
+
+            template <typename Functor>
+            KOKKOS_INLINE_FUNCTION void operator()(const size_t i, Functor&& f) const {
+                const Vector<T, Dim> xi = pos(i);
+                forEachAdjacentCell(
+                    binPosition(xi, origin, invWidth, nCells), nCells, [&](const size_t c) {
+                        for (size_t m = cellOffsets(c); m < cellOffsets(c + 1); ++m) {
+                            const size_t j = cellParticles(m);
+                            if (j != i && (!half || j > i)
+                                && distanceSquared(xi, pos(j)) <= range2) {
+                                f(j);
+                            }
+                        }
+                    });
+            }
+        };
+
+        /*!
+         * Writes the exclusive prefix sum of the counts to the offsets
+         * @param counts the counts
+         * @param offsets the offsets (output); one element longer than the counts
+         * @returns The sum of all counts
+         */
+        template <typename ViewType>
+        size_type exclusiveScan(const ViewType& counts, const ViewType& offsets) {
+            using execution_space = typename ViewType::execution_space;
+            using policy_type     = Kokkos::RangePolicy<execution_space>;
+
+            size_type total = 0;
+            Kokkos::parallel_scan(
+                "exclusiveScan", policy_type(0, counts.extent(0)),
+                KOKKOS_LAMBDA(const size_t i, size_type& sum, const bool final) {
+                    if (final) {
+                        offsets(i) = sum;
+                    }
+                    sum += counts(i);
+                },
+                total);
+            Kokkos::deep_copy(Kokkos::subview(offsets, counts.extent(0)), total);
+            return total;
+        }
+    }  // namespace detail
+
+    template <typename T, unsigned Dim, class MemorySpace>
+    NeighborList<T, Dim, MemorySpace>::NeighborList(T cutoff, T skin, NeighborListType type)
+        : cutoff_m(cutoff)
+        , skin_m(skin)
+        , type_m(type) {
+        if (cutoff <= 0 || skin < 0) {
+            throw IpplException("NeighborList::NeighborList",
+                                "The cutoff must be positive and the skin non-negative.");
+        }
+    }
+
+    template <typename T, unsigned Dim, class MemorySpace>
+    template <class Bunch>
+    void NeighborList<T, Dim, MemorySpace>::build(const Bunch& bunch) {
+        static IpplTimings::TimerRef buildTimer = IpplTimings::getTimer("buildNeighborList");
+        IpplTimings::startTimer(buildTimer);
+
+        const auto& layout     = bunch.getLayout();
+        const size_type nLocal = bunch.getLocalNum();
+        const auto dead        = bunch.getDeadMask();
+        const auto ghosts      = layout.getGhostPositions();
+        const size_type nTotal = nLocal + ghosts.extent(0);
+
+        const detail::CombinedPositions<std::decay_t<decltype(bunch.R.getView())>,
+                                        std::decay_t<decltype(ghosts)>>
+            pos{bunch.R.getView(), ghosts, nLocal};
+
+        // the grid covers the local region and the shell of the ghosts with
+        // cells that are at least as wide as the range of the list
+        const T range       = cutoff_m + skin_m;
+        const auto region   = layout.getRegionLayout().gethLocalRegions()(Comm->rank());
+        size_type nCellsAll = 1;
+        for (unsigned d = 0; d < Dim; ++d) {
+            const T length = region[d].length() + 2 * range;
+            nCells_m[d]    = std::max(1, int(length / range));
+            origin_m[d]    = region[d].min() - range;
+            invWidth_m[d]  = nCells_m[d] / length;
+            nCellsAll *= nCells_m[d];
+        }
+        const vector_type origin      = origin_m;
+        const vector_type invWidth    = invWidth_m;
+        const Vector<int, Dim> nCells = nCells_m;
+
+        using policy_type = Kokkos::RangePolicy<execution_space>;
+
+        // cell-linked list: a counting sort of all particles by cell
+        index_view_type cellOf("cell of particle", nTotal);
+        index_view_type counts("particles per cell", nCellsAll);
+        Kokkos::parallel_for(
+            "NeighborList::build()::bin", policy_type(0, nTotal), KOKKOS_LAMBDA(const size_t k) {
+                if (k < nLocal && detail::isDead(dead, k)) {
+                    cellOf(k) = nCellsAll;
+                    return;
+                }
+                cellOf(k) = detail::linearCell(
+                    detail::binPosition(pos(k), origin, invWidth, nCells), nCells);
+                Kokkos::atomic_increment(&counts(cellOf(k)));
+            });
+
+        cellOffsets_m = index_view_type("cell offsets", nCellsAll + 1);
+        const size_type nBinned = detail::exclusiveScan(counts, cellOffsets_m);
+        Kokkos::deep_copy(counts,
+                          Kokkos::subview(cellOffsets_m, std::make_pair(size_type(0), nCellsAll)));
+
+        cellParticles_m          = index_view_type("cell particles", nBinned);
+        const auto cellOffsets   = cellOffsets_m;
+        const auto cellParticles = cellParticles_m;
+        Kokkos::parallel_for(
+            "NeighborList::build()::fill", policy_type(0, nTotal), KOKKOS_LAMBDA(const size_t k) {
+                if (cellOf(k) < nCellsAll) {
+                    cellParticles(Kokkos::atomic_fetch_add(&counts(cellOf(k)), 1)) = k;
+                }
+            });
+
+        // Verlet list: the particles of the adjacent cells within the range,
+        // counted first and stored in a second pass
+        using search_type =
+            detail::VerletSearch<std::decay_t<decltype(pos)>, index_view_type, T, Dim>;
+        const bool half = type_m == NeighborListType::Half;
+        const search_type search{pos,      cellOffsets, cellParticles, origin,
+                                 invWidth, nCells,      range * range, half};
+
+        index_view_type nNeighbors("neighbors per particle", nLocal);
+        Kokkos::parallel_for(
+            "NeighborList::build()::count", policy_type(0, nLocal), KOKKOS_LAMBDA(const size_t i) {
+                size_type n = 0;
+                if (!detail::isDead(dead, i)) {
+                    search(i, [&](const size_t) { ++n; });
+                }
+                nNeighbors(i) = n;
+            });
+
+        neighborOffsets_m = index_view_type("neighbor offsets", nLocal + 1);
+        pairNum_m         = detail::exclusiveScan(nNeighbors, neighborOffsets_m);
+
+        neighbors_m                = index_view_type("neighbors", pairNum_m);
+        const auto neighborOffsets = neighborOffsets_m;
+        const auto neighbors       = neighbors_m;
+        Kokkos::parallel_for(
+            "NeighborList::build()::fill", policy_type(0, nLocal), KOKKOS_LAMBDA(const size_t i) {
+                if (detail::isDead(dead, i)) {
+                    return;
+                }
+                size_type n = neighborOffsets(i);
+                search(i, [&](const size_t j) { neighbors(n++) = j; });
+            });
+
+        // remember the state the list was built for
+        buildR_m = position_view_type("neighbor list positions", nLocal);
+        Kokkos::deep_copy(buildR_m, Kokkos::subview(bunch.R.getView(),
+                                                    std::make_pair(size_type(0), nLocal)));
+        Kokkos::fence();
+
+        localNum_m    = nLocal;
+        ghostNum_m    = ghosts.extent(0);
+        ghostBuilds_m = layout.getGhostScheduleBuilds();
+        ++builds_m;
+
+        IpplTimings::stopTimer(buildTimer);
+    }
+
+    template <typename T, unsigned Dim, class MemorySpace>
+    template <class Bunch>
+    bool NeighborList<T, Dim, MemorySpace>::needsRebuild(const Bunch& bunch) const {
+        const auto& layout = bunch.getLayout();
+
+        T maxDisplacement2 = std::numeric_limits<T>::max();
+        if (builds_m > 0 && bunch.getLocalNum() == localNum_m
+            && layout.getGhostPositions().extent(0) == ghostNum_m
+            && layout.getGhostScheduleBuilds() == ghostBuilds_m) {
+            const auto positions = bunch.R.getView();
+            const auto buildR    = buildR_m;
+            const auto dead      = bunch.getDeadMask();
+
+            using policy_type = Kokkos::RangePolicy<execution_space>;
+            Kokkos::parallel_reduce(
+                "NeighborList::needsRebuild()", policy_type(0, localNum_m),
+                KOKKOS_LAMBDA(const size_t i, T& max) {
+                    if (!detail::isDead(dead, i)) {
+                        const T r2 = detail::distanceSquared(positions(i), buildR(i));
+                        max        = r2 > max ? r2 : max;
+                    }
+                },
+                Kokkos::Max<T>(maxDisplacement2));
+        }
+
+        // the ghosts are the particles of the other ranks, so their displacement counts too
+        MPI_Datatype type = get_mpi_datatype<T>(maxDisplacement2);
+        MPI_Allreduce(MPI_IN_PLACE, &maxDisplacement2, 1, type, MPI_MAX,
+                      Comm->getCommunicator());
+
+        return 4 * maxDisplacement2 > skin_m * skin_m;
+    }
+
+    template <typename T, unsigned Dim, class MemorySpace>
+    template <class Bunch>
+    bool NeighborList<T, Dim, MemorySpace>::update(const Bunch& bunch) {
+        if (needsRebuild(bunch)) {
+            build(bunch);
+            return true;
+        }
+        return false;
+    }
+
+    template <typename T, unsigned Dim, class MemorySpace>
+    template <class Bunch, class Functor>
+    void NeighborList<T, Dim, MemorySpace>::for_each_pair(const Bunch& bunch, T cutoff,
+                                                          const Functor& f) const {
+        if (bunch.getLocalNum() != localNum_m || cutoff > cutoff_m) {
+            throw IpplException("NeighborList::for_each_pair",
+                                "The neighbor list is out of date or its cutoff is too small.");
+        }
+
+        static IpplTimings::TimerRef pairTimer = IpplTimings::getTimer("forEachPair");
+        IpplTimings::startTimer(pairTimer);
+
+        const auto ghosts = bunch.getLayout().getGhostPositions();
+        const detail::CombinedPositions<std::decay_t<decltype(bunch.R.getView())>,
+                                        std::decay_t<decltype(ghosts)>>
+            pos{bunch.R.getView(), ghosts, localNum_m};
+
+        const auto dead            = bunch.getDeadMask();
+        const auto neighborOffsets = neighborOffsets_m;
+        const auto neighbors       = neighbors_m;
+        const T cutoff2            = cutoff * cutoff;
+
+        using policy_type = Kokkos::RangePolicy<execution_space>;
+        Kokkos::parallel_for(
+            "NeighborList::for_each_pair()", policy_type(0, localNum_m),
+            KOKKOS_LAMBDA(const size_t i) {
+                if (detail::isDead(dead, i)) {
+                    return;
+                }
+                const vector_type xi = pos(i);
+                for (size_type n = neighborOffsets(i); n < neighborOffsets(i + 1); ++n) {
+                    const size_t j         = neighbors(n);
+                    const vector_type xj   = pos(j);
+                    if (detail::distanceSquared(xi, xj) <= cutoff2) {
+                        const vector_type dist = xi - xj;
+                        f(i, j, dist);
+                    }
+                }
+            });
+        Kokkos::fence();
+
+        IpplTimings::stopTimer(pairTimer);
+    }
+}  // namespace ippl
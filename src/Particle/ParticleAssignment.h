@@ -0,0 +1,137 @@
+//
+// ParticleAssignment
+//   Evaluation of several particle attribute assignments in one kernel.
+//
+//   Every assignment to a particle attribute launches its own kernel over
+//   all particles. A sequence of assignments, e.g. a drift followed by a
+//   kick, can instead be evaluated in a single kernel:
+//
+//     ippl::assign(ippl::deferred(R) = R + dt * P,
+//                  ippl::deferred(P) = P + dt * E);
+//
+//   The assignments are applied to each particle in the given order, so the
+//   result is the same as with separate statements. Since a particle is
+//   handled by one thread, the values written by an earlier assignment are
+//   still in cache when the later ones read them.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_PARTICLE_ASSIGNMENT_H
+#define IPPL_PARTICLE_ASSIGNMENT_H
+
+#include <Kokkos_Core.hpp>
+
+#include <tuple>
+#include <type_traits>
+
+#include "Types/IpplTypes.h"
+
+#include "Utility/IpplException.h"
+
+#include "Expression/IpplExpressions.h"
+#include "Particle/ParticleAttribBase.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * A particle attribute assignment captured for a fused kernel
+         * @tparam Attrib the attribute type (ParticleAttrib or SoAParticleAttrib)
+         * @tparam E the expression type
+         * @tparam N the size of the expression
+         */
+        template <typename Attrib, typename E, size_t N>
+        struct ParticleAssignment {
+            using view_type       = typename Attrib::view_type;
+            using mask_type       = typename Attrib::mask_type;
+            using execution_space = typename Attrib::execution_space;
+
+            view_type view;
+            CapturedExpression<E, N> expr;
+
+            //! number of particles and deleted particles of the bunch, and the
+            //! address of the count, which identifies the bunch
+            size_type count;
+            mask_type dead;
+            const size_type* bunch;
+
+            KOKKOS_INLINE_FUNCTION void apply(const size_t i) const { view(i) = expr(i); }
+        };
+
+        /*!
+         * The left-hand side of a particle assignment that is not evaluated
+         * immediately (see deferred)
+         */
+        template <typename Attrib>
+        struct DeferredAssignment {
+            Attrib& attrib;
+
+            template <typename E, size_t N>
+            ParticleAssignment<Attrib, E, N> operator=(const Expression<E, N>& expr) const {
+                using capture_type = CapturedExpression<E, N>;
+                return {attrib.getView(), reinterpret_cast<const capture_type&>(expr),
+                        attrib.getParticleCount(), attrib.getDeadMask(),
+                        attrib.getParticleCountPtr()};
+            }
+
+            auto operator=(const typename Attrib::value_type& x) const {
+                return *this = Scalar<typename Attrib::value_type>(x);
+            }
+        };
+    }  // namespace detail
+
+    /*!
+     * Mark an assignment to a particle attribute for evaluation with assign
+     * @param attrib the attribute that is assigned to
+     * @return The left-hand side of the assignment
+     */
+    template <typename Attrib>
+    detail::DeferredAssignment<Attrib> deferred(Attrib& attrib) {
+        return {attrib};
+    }
+
+    /*!
+     * Evaluate several particle attribute assignments in a single kernel. The
+     * assignments are applied to each particle one after the other, as if they
+     * were separate statements. All attributes must belong to the same bunch.
+     * @param assignments the assignments, created with deferred
+     */
+    template <typename... Attribs, typename... E, size_t... N>
+    void assign(const detail::ParticleAssignment<Attribs, E, N>&... assignments) {
+        static_assert(sizeof...(Attribs) > 0, "Nothing to assign");
+
+        using first_type = std::tuple_element_t<0, std::tuple<Attribs...>>;
+        using execution_space = typename first_type::execution_space;
+        static_assert((std::is_same_v<typename Attribs::execution_space, execution_space> && ...),
+                      "All attributes must be stored in the same memory space");
+
+        const auto& first = std::get<0>(std::forward_as_tuple(assignments...));
+        if (((assignments.bunch != first.bunch) || ...)) {
+            throw IpplException("ippl::assign",
+                                "All attributes must belong to the same particle bunch.");
+        }
+
+        const auto dead = first.dead;
+
+        using policy_type = Kokkos::RangePolicy<execution_space>;
+        Kokkos::parallel_for(
+            "ippl::assign", policy_type(0, first.count), KOKKOS_LAMBDA(const size_t i) {
+                if (detail::isDead(dead, i)) {
+                    return;
+                }
+                (assignments.apply(i), ...);
+            });
+    }
+}  // namespace ippl
+
+#endif
@@ -31,7 +31,8 @@
 
 #include "Expression/IpplExpressions.h"
 
-#include "Interpolation/CIC.h"
+#include "Interpolation/ScatterStrategy.h"
+#include "Interpolation/ShapeFunctions.h"
 #include "Particle/ParticleAttribBase.h"
 
 namespace ippl {
@@ -49,6 +50,7 @@ namespace ippl {
         using Base = typename detail::ParticleAttribBase<>::with_properties<Properties...>;
 
         using hash_type = typename Base::hash_type;
+        using mask_type = typename Base::mask_type;
 
         using view_type  = typename detail::ViewType<T, 1, Properties...>::view_type;
         using HostMirror = typename view_type::host_mirror_type;
@@ -62,26 +64,10 @@ namespace ippl {
         // New items are appended to the end of the array.
         void create(size_type) override;
 
-        /*!
-         * Particle deletion function. Partition the particles into a valid region
-         * and an invalid region.
-         * @param deleteIndex List of indices of invalid particles in the valid region
-         * @param keepIndex List of indices of valid particles in the invalid region
-         * @param invalidCount Number of invalid particles in the valid region
-         */
-        void destroy(const hash_type& deleteIndex, const hash_type& keepIndex,
-                     size_type invalidCount) override;
-
-        void pack(void*, const hash_type&) const override;
-
-        void unpack(void*, size_type) override;
-
-        void serialize(detail::Archive<memory_space>& ar, size_type nsends) override {
-            ar.serialize(dview_m, nsends);
-        }
+        void reserve(size_type n) override;
 
-        void deserialize(detail::Archive<memory_space>& ar, size_type nrecvs) override {
-            ar.deserialize(dview_m, nrecvs);
+        void appendByteViews(std::vector<detail::ByteView>& views) override {
+            views.push_back({reinterpret_cast<char*>(dview_m.data()), sizeof(value_type), 0});
         }
 
         virtual ~ParticleAttrib() = default;
@@ -129,14 +115,28 @@ namespace ippl {
         // KOKKOS_INLINE_FUNCTION
         ParticleAttrib<T, Properties...>& operator=(detail::Expression<E, N> const& expr);
 
-        //     // scatter the data from this attribute onto the given Field, using
-        //     // the given Position attribute
-        template <typename Field, typename P2>
-        void scatter(Field& f,
-                     const ParticleAttrib<Vector<P2, Field::dim>, Properties...>& pp) const;
+        /*!
+         * Scatter the data from this attribute onto the given Field, using
+         * the given Position attribute
+         * @tparam Shape the shape function (see Interpolation/ShapeFunctions.h)
+         * @tparam Strategy the scatter strategy (see Interpolation/ScatterStrategy.h)
+         * @param f the field to scatter to
+         * @param pp the particle positions, stored as ParticleAttrib or SoAParticleAttrib
+         * @param strategy the strategy and its parameters
+         */
+        template <typename Shape = CIC, typename Field, typename PositionAttrib,
+                  typename Strategy = DefaultScatter>
+        void scatter(Field& f, const PositionAttrib& pp,
+                     const Strategy& strategy = Strategy()) const;
 
-        template <typename Field, typename P2>
-        void gather(Field& f, const ParticleAttrib<Vector<P2, Field::dim>, Properties...>& pp);
+        /*!
+         * Interpolate the given Field at the particle positions into this attribute
+         * @tparam Shape the shape function (see Interpolation/ShapeFunctions.h)
+         * @param f the field to gather from
+         * @param pp the particle positions, stored as ParticleAttrib or SoAParticleAttrib
+         */
+        template <typename Shape = CIC, typename Field, typename PositionAttrib>
+        void gather(Field& f, const PositionAttrib& pp);
 
         T sum();
         T max();
@@ -44,64 +44,26 @@ namespace ippl {
     }
 
     template <typename T, class... Properties>
-    void ParticleAttrib<T, Properties...>::destroy(const hash_type& deleteIndex,
-                                                   const hash_type& keepIndex,
-                                                   size_type invalidCount) {
-        // Replace all invalid particles in the valid region with valid
-        // particles in the invalid region
-        using policy_type = Kokkos::RangePolicy<execution_space>;
-        Kokkos::parallel_for(
-            "ParticleAttrib::destroy()", policy_type(0, invalidCount),
-            KOKKOS_CLASS_LAMBDA(const size_t i) {
-                dview_m(deleteIndex(i)) = dview_m(keepIndex(i));
-            });
-    }
-
-    template <typename T, class... Properties>
-    void ParticleAttrib<T, Properties...>::pack(void* buffer, const hash_type& hash) const {
-        using this_type     = ParticleAttrib<T, Properties...>;
-        this_type* buffer_p = static_cast<this_type*>(buffer);
-        auto& view          = buffer_p->dview_m;
-        auto size           = hash.extent(0);
-        if (view.extent(0) < size) {
+    void ParticleAttrib<T, Properties...>::reserve(size_type n) {
+        if (this->size() < n) {
             int overalloc = Comm->getDefaultOverallocation();
-            Kokkos::realloc(view, size * overalloc);
+            this->resize(n * overalloc);
         }
-
-        using policy_type = Kokkos::RangePolicy<execution_space>;
-        Kokkos::parallel_for(
-            "ParticleAttrib::pack()", policy_type(0, size),
-            KOKKOS_CLASS_LAMBDA(const size_t i) { view(i) = dview_m(hash(i)); });
-        Kokkos::fence();
-    }
-
-    template <typename T, class... Properties>
-    void ParticleAttrib<T, Properties...>::unpack(void* buffer, size_type nrecvs) {
-        using this_type     = ParticleAttrib<T, Properties...>;
-        this_type* buffer_p = static_cast<this_type*>(buffer);
-        auto& view          = buffer_p->dview_m;
-        auto size           = dview_m.extent(0);
-        size_type required  = *(this->localNum_mp) + nrecvs;
-        if (size < required) {
-            int overalloc = Comm->getDefaultOverallocation();
-            this->resize(required * overalloc);
-        }
-
-        size_type count   = *(this->localNum_mp);
-        using policy_type = Kokkos::RangePolicy<execution_space>;
-        Kokkos::parallel_for(
-            "ParticleAttrib::unpack()", policy_type(0, nrecvs),
-            KOKKOS_CLASS_LAMBDA(const size_t i) { dview_m(count + i) = view(i); });
-        Kokkos::fence();
     }
 
     template <typename T, class... Properties>
     // KOKKOS_INLINE_FUNCTION
     ParticleAttrib<T, Properties...>& ParticleAttrib<T, Properties...>::operator=(T x) {
+        const mask_type dead = this->getDeadMask();
+
         using policy_type = Kokkos::RangePolicy<execution_space>;
         Kokkos::parallel_for(
             "ParticleAttrib::operator=()", policy_type(0, *(this->localNum_mp)),
-            KOKKOS_CLASS_LAMBDA(const size_t i) { dview_m(i) = x; });
+            KOKKOS_CLASS_LAMBDA(const size_t i) {
+                if (!detail::isDead(dead, i)) {
+                    dview_m(i) = x;
+                }
+            });
         return *this;
     }
 
@@ -113,17 +75,23 @@ namespace ippl {
         using capture_type = detail::CapturedExpression<E, N>;
         capture_type expr_ = reinterpret_cast<const capture_type&>(expr);
 
+        const mask_type dead = this->getDeadMask();
+
         using policy_type = Kokkos::RangePolicy<execution_space>;
         Kokkos::parallel_for(
             "ParticleAttrib::operator=()", policy_type(0, *(this->localNum_mp)),
-            KOKKOS_CLASS_LAMBDA(const size_t i) { dview_m(i) = expr_(i); });
+            KOKKOS_CLASS_LAMBDA(const size_t i) {
+                if (!detail::isDead(dead, i)) {
+                    dview_m(i) = expr_(i);
+                }
+            });
         return *this;
     }
 
     template <typename T, class... Properties>
-    template <typename Field, class PT>
-    void ParticleAttrib<T, Properties...>::scatter(
-        Field& f, const ParticleAttrib<Vector<PT, Field::dim>, Properties...>& pp) const {
+    template <typename Shape, typename Field, typename PositionAttrib, typename Strategy>
+    void ParticleAttrib<T, Properties...>::scatter(Field& f, const PositionAttrib& pp,
+                                                   const Strategy& strategy) const {
         constexpr unsigned Dim = Field::dim;
 
         static IpplTimings::TimerRef scatterTimer = IpplTimings::getTimer("scatter");
@@ -135,7 +103,6 @@ namespace ippl {
         const mesh_type& mesh = f.get_mesh();
 
         using vector_type = typename mesh_type::vector_type;
-        using value_type  = typename ParticleAttrib<T, Properties...>::value_type;
 
         const vector_type& dx     = mesh.getMeshSpacing();
         const vector_type& origin = mesh.getOrigin();
@@ -144,24 +111,21 @@ namespace ippl {
         const FieldLayout<Dim>& layout = f.getLayout();
         const NDIndex<Dim>& lDom       = layout.getLocalNDIndex();
         const int nghost               = f.getNghost();
+        detail::checkShapeSupport<Shape>(f, "ParticleAttrib::scatter");
 
-        using policy_type = Kokkos::RangePolicy<execution_space>;
-        Kokkos::parallel_for(
-            "ParticleAttrib::scatter", policy_type(0, *(this->localNum_mp)),
-            KOKKOS_CLASS_LAMBDA(const size_t idx) {
-                // find nearest grid point
-                vector_type l                 = (pp(idx) - origin) * invdx + 0.5;
-                Vector<int, Field::dim> index = l;
-                Vector<T, Field::dim> whi     = l - index;
-                Vector<T, Field::dim> wlo     = 1.0 - whi;
-
-                Vector<size_t, Field::dim> args = index - lDom.first() + nghost;
-
-                // scatter
-                const value_type& val = dview_m(idx);
-                detail::scatterToField(std::make_index_sequence<1 << Field::dim>{}, view, wlo, whi,
-                                       args, val);
-            });
+        detail::StencilMap<Shape, T, Dim, vector_type> map{origin, invdx, lDom.first() - nghost};
+
+        const mask_type dead = this->getDeadMask();
+
+        using strategy_type = detail::scatter_strategy_t<Strategy, execution_space>;
+        if constexpr (std::is_same_v<strategy_type, Strategy>) {
+            detail::ScatterKernel<strategy_type>::apply(strategy, view, pp.getView(), dview_m,
+                                                        dead, *(this->localNum_mp), map);
+        } else {
+            detail::ScatterKernel<strategy_type>::apply(strategy_type{}, view, pp.getView(),
+                                                        dview_m, dead, *(this->localNum_mp),
+                                                        map);
+        }
         IpplTimings::stopTimer(scatterTimer);
 
         static IpplTimings::TimerRef accumulateHaloTimer = IpplTimings::getTimer("accumulateHalo");
@@ -171,9 +135,8 @@ namespace ippl {
     }
 
     template <typename T, class... Properties>
-    template <typename Field, typename P2>
-    void ParticleAttrib<T, Properties...>::gather(
-        Field& f, const ParticleAttrib<Vector<P2, Field::dim>, Properties...>& pp) {
+    template <typename Shape, typename Field, typename PositionAttrib>
+    void ParticleAttrib<T, Properties...>::gather(Field& f, const PositionAttrib& pp) {
         constexpr unsigned Dim = Field::dim;
 
         static IpplTimings::TimerRef fillHaloTimer = IpplTimings::getTimer("fillHalo");
@@ -189,6 +152,7 @@ namespace ippl {
         const mesh_type& mesh = f.get_mesh();
 
         using vector_type = typename mesh_type::vector_type;
+        using weight_type = typename mesh_type::value_type;
 
         const vector_type& dx     = mesh.getMeshSpacing();
         const vector_type& origin = mesh.getOrigin();
@@ -197,22 +161,25 @@ namespace ippl {
         const FieldLayout<Dim>& layout = f.getLayout();
         const NDIndex<Dim>& lDom       = layout.getLocalNDIndex();
         const int nghost               = f.getNghost();
+        detail::checkShapeSupport<Shape>(f, "ParticleAttrib::gather");
+
+        detail::StencilMap<Shape, weight_type, Dim, vector_type> map{origin, invdx,
+                                                                     lDom.first() - nghost};
+
+        const mask_type dead = this->getDeadMask();
 
         using policy_type = Kokkos::RangePolicy<execution_space>;
         Kokkos::parallel_for(
             "ParticleAttrib::gather", policy_type(0, *(this->localNum_mp)),
             KOKKOS_CLASS_LAMBDA(const size_t idx) {
-                // find nearest grid point
-                vector_type l                 = (pp(idx) - origin) * invdx + 0.5;
-                Vector<int, Field::dim> index = l;
-                Vector<T, Field::dim> whi     = l - index;
-                Vector<T, Field::dim> wlo     = 1.0 - whi;
+                if (detail::isDead(dead, idx)) {
+                    return;
+                }
 
-                Vector<size_t, Field::dim> args = index - lDom.first() + nghost;
+                const auto stencil = map(pp(idx));
 
-                // gather
-                dview_m(idx) = detail::gatherFromField(std::make_index_sequence<1 << Field::dim>{},
-                                                       view, wlo, whi, args);
+                dview_m(idx) = detail::gatherFromField(detail::stencil_sequence<Shape, Dim>{},
+                                                       view, stencil);
             });
         IpplTimings::stopTimer(gatherTimer);
     }
@@ -222,28 +189,32 @@ namespace ippl {
      *
      */
 
-    template <typename Tp1, typename Tf, unsigned Dim, class M, class C, typename Tp2,
-              class... Properties>
+    template <typename Shape = CIC, typename Tp1, typename Tf, unsigned Dim, class M, class C,
+              typename PositionAttrib, class... Properties, typename Strategy = DefaultScatter>
     inline void scatter(const ParticleAttrib<Tp1, Properties...>& attrib, Field<Tf, Dim, M, C>& f,
-                        const ParticleAttrib<Vector<Tp2, Dim>, Properties...>& pp) {
-        attrib.scatter(f, pp);
+                        const PositionAttrib& pp, const Strategy& strategy = Strategy()) {
+        attrib.template scatter<Shape>(f, pp, strategy);
     }
 
-    template <typename Tp1, typename Tf, unsigned Dim, class M, class C, typename Tp2,
-              class... Properties>
+    template <typename Shape = CIC, typename Tp1, typename Tf, unsigned Dim, class M, class C,
+              typename PositionAttrib, class... Properties>
     inline void gather(ParticleAttrib<Tp1, Properties...>& attrib, Field<Tf, Dim, M, C>& f,
-                       const ParticleAttrib<Vector<Tp2, Dim>, Properties...>& pp) {
-        attrib.gather(f, pp);
+                       const PositionAttrib& pp) {
+        attrib.template gather<Shape>(f, pp);
     }
 
 #define DefineParticleReduction(fun, name, op, MPI_Op)                               \
     template <typename T, class... Properties>                                       \
     T ParticleAttrib<T, Properties...>::name() {                                     \
-        T temp            = 0.0;                                                     \
-        using policy_type = Kokkos::RangePolicy<execution_space>;                    \
+        T temp               = 0.0;                                                  \
+        const mask_type dead = this->getDeadMask();                                  \
+        using policy_type    = Kokkos::RangePolicy<execution_space>;                 \
         Kokkos::parallel_reduce(                                                     \
             "fun", policy_type(0, *(this->localNum_mp)),                             \
             KOKKOS_CLASS_LAMBDA(const size_t i, T& valL) {                           \
+                if (detail::isDead(dead, i)) {                                       \
+                    return;                                                          \
+                }                                                                    \
                 T myVal = dview_m(i);                                                \
                 op;                                                                  \
             },                                                                       \
@@ -7,8 +7,9 @@
 //   contains a Kokkos::View of data for N particles, and methods to operate with
 //   this data.
 //
-//   This base class provides virtual methods used to create and destroy
-//   elements of the attribute array.
+//   This base class provides virtual methods used to create elements of the
+//   attribute array and to access its storage; particles are destroyed by
+//   ParticleBase for all attributes at once.
 //
 // Copyright (c) 2020, Matthias Frey, Paul Scherrer Institut, Villigen PSI, Switzerland
 // All rights reserved
@@ -27,6 +28,8 @@
 #ifndef IPPL_PARTICLE_ATTRIB_BASE_H
 #define IPPL_PARTICLE_ATTRIB_BASE_H
 
+#include <vector>
+
 #include "Types/IpplTypes.h"
 #include "Types/ViewTypes.h"
 
@@ -34,6 +37,16 @@
 
 namespace ippl {
     namespace detail {
+        /*!
+         * @param dead the dead mask of a bunch; empty if deletions are compacted immediately
+         * @param i the particle index
+         * @return Whether the particle has been deleted but not yet compacted
+         */
+        template <typename MaskView>
+        KOKKOS_INLINE_FUNCTION bool isDead(const MaskView& dead, size_t i) {
+            return dead.extent(0) > 0 && dead(i);
+        }
+
         template <typename MemorySpace = Kokkos::DefaultExecutionSpace::memory_space>
         class ParticleAttribBase {
             template <class... Properties>
@@ -46,22 +59,27 @@ namespace ippl {
             using hash_type       = ippl::detail::hash_type<MemorySpace>;
             using memory_space    = MemorySpace;
             using execution_space = typename memory_space::execution_space;
+            using mask_type       = typename ViewType<bool, 1, MemorySpace>::view_type;
 
             template <typename... Properties>
             using with_properties = typename WithMemSpace<Properties...>::type;
 
             virtual void create(size_type) = 0;
 
-            virtual void destroy(const hash_type&, const hash_type&, size_type) = 0;
-            virtual size_type packedSize(const size_type) const                 = 0;
-
-            virtual void pack(void*, const hash_type&) const = 0;
-
-            virtual void unpack(void*, size_type) = 0;
+            virtual size_type packedSize(const size_type) const = 0;
 
-            virtual void serialize(Archive<memory_space>& ar, size_type nsends) = 0;
+            /*!
+             * Ensure there is room for a number of particles, preserving the stored values
+             * @param n the required number of particles
+             */
+            virtual void reserve(size_type n) = 0;
 
-            virtual void deserialize(Archive<memory_space>& ar, size_type nrecvs) = 0;
+            /*!
+             * Append the attribute storage as type-erased arrays for the fused
+             * (de)serialization kernels
+             * @param views the arrays of all attributes of a memory space
+             */
+            virtual void appendByteViews(std::vector<ByteView>& views) = 0;
 
             virtual size_type size() const = 0;
 
@@ -70,8 +88,27 @@ namespace ippl {
             void setParticleCount(size_type& num) { localNum_mp = &num; }
             size_type getParticleCount() const { return *localNum_mp; }
 
+            /*!
+             * @return The address of the particle count of the bunch, which
+             * identifies the bunch the attribute belongs to
+             */
+            const size_type* getParticleCountPtr() const { return localNum_mp; }
+
+            /*!
+             * Make the attribute skip the particles of a bunch with deferred deletion
+             * @param mask the view marking the deleted particles
+             */
+            void setDeadMask(const mask_type& mask) { deadMask_mp = &mask; }
+
+            /*!
+             * @return The mask of the deleted particles that are still stored, or an
+             * empty view if the bunch compacts deletions immediately
+             */
+            mask_type getDeadMask() const { return deadMask_mp ? *deadMask_mp : mask_type(); }
+
         protected:
             const size_type* localNum_mp;
+            const mask_type* deadMask_mp = nullptr;
         };
     }  // namespace detail
 }  // namespace ippl
@@ -72,9 +72,29 @@
 
 #include "Utility/TypeUtils.h"
 
+#include "FieldLayout/FieldLayout.h"
 #include "Particle/ParticleLayout.h"
+#include "Interpolation/ShapeFunctions.h"
+#include "Particle/ParticleSort.h"
 
 namespace ippl {
+    namespace detail {
+        /*!
+         * Running counts of the scan computing the particle compaction
+         */
+        struct CompactionCount {
+            //! invalid particles to be overwritten
+            size_type holes = 0;
+            //! valid particles to be moved
+            size_type keeps = 0;
+
+            KOKKOS_INLINE_FUNCTION CompactionCount& operator+=(const CompactionCount& other) {
+                holes += other.holes;
+                keeps += other.keeps;
+                return *this;
+            }
+        };
+    }  // namespace detail
 
     /*!
      * @class ParticleBase
@@ -111,6 +131,10 @@ namespace ippl {
 
         using size_type = detail::size_type;
 
+        using position_memory_space = typename particle_position_type::memory_space;
+        using sort_key_type =
+            typename detail::ViewType<std::uint64_t, 1, position_memory_space>::view_type;
+
     public:
         //! view of particle positions
         particle_position_type R;
@@ -151,7 +175,8 @@ namespace ippl {
         void initialize(Layout_t& layout);
 
         /*!
-         * @returns processor local number of particles
+         * @returns processor local number of particles, including the particles
+         * whose deletion is deferred
          */
         size_type getLocalNum() const { return localNum_m; }
 
@@ -254,33 +279,139 @@ namespace ippl {
         /*!
          * Particle deletion Function. Partition the particles into a valid region
          * and an invalid region,
-         * effectively deleting the invalid particles
+         * effectively deleting the invalid particles. The mapping of the moved
+         * particles is computed in a single scan and all attributes of a memory
+         * space are moved in a single kernel; the arrangement of the remaining
+         * particles is given by the compaction order. If the deletion is deferred,
+         * the invalid particles are only marked as dead.
          * @param invalid View marking which indices are invalid
          * @param destroyNum Total number of invalid particles
          */
         template <typename... Properties>
         void destroy(const Kokkos::View<bool*, Properties...>& invalid, const size_type destroyNum);
 
-        template <typename HashType, typename BufferType>
+        /*!
+         * Defer the deletion of particles. Destroyed particles are only marked in a
+         * dead mask, which is honoured by the attribute assignments, reductions,
+         * scatter and gather and by the particle update; the bunch is compacted once
+         * the fraction of dead particles exceeds the threshold or on calling compact().
+         * All attributes must be stored in the memory space of the positions.
+         * @param threshold the fraction of dead local particles triggering a compaction
+         */
+        void enableDeferredDestroy(double threshold = 0.1);
+
+        bool isDestroyDeferred() const { return deferDestroy_m; }
+
+        /*!
+         * Remove the dead particles from the bunch
+         */
+        void compact();
+
+        /*!
+         * @returns the number of dead particles that are still stored
+         */
+        size_type getDeadNum() const { return deadNum_m; }
+
+        /*!
+         * @returns the mask of the dead particles; empty if deletions are not deferred
+         */
+        const typename attribute_type<position_memory_space>::mask_type& getDeadMask() const {
+            return dead_m.getView();
+        }
+
+        /*!
+         * Set how the particles are arranged after deletions, e.g. during a
+         * particle update. With CompactionOrder::Stable, the order of a prior
+         * sort is preserved.
+         * @param order the compaction order
+         */
+        void setCompactionOrder(CompactionOrder order) { compactionOrder_m = order; }
+
+        CompactionOrder getCompactionOrder() const { return compactionOrder_m; }
+
+        /*!
+         * Reorder all particles by the first grid point of their interpolation stencil,
+         * e.g. by the mesh cell shifted by half a spacing for CIC. All attributes are
+         * permuted with a single kernel per memory space.
+         * @tparam Shape the shape function whose stencils define the cells
+         * @param mesh the mesh defining the cells
+         * @param layout the field layout defining the local domain; particles outside
+         * of it are assigned to the nearest local cell
+         * @param order the cell ordering
+         */
+        template <typename Shape = CIC, typename Mesh>
+        void sort(const Mesh& mesh, const FieldLayout<PLayout::dim>& layout,
+                  SortOrder order = SortOrder::Lexicographic);
+
+        /*!
+         * Reorder all particles by the cell of the field containing them
+         * @param field the field whose mesh and layout define the cells
+         * @param order the cell ordering
+         */
+        template <typename Shape = CIC, typename Field>
+        void sort(const Field& field, SortOrder order = SortOrder::Lexicographic) {
+            sort<Shape>(field.get_mesh(), field.getLayout(), order);
+        }
+
+        /*!
+         * Measure how far the particles are from being sorted
+         * @param mesh the mesh defining the cells
+         * @param layout the field layout defining the local domain
+         * @param order the cell ordering
+         * @return The fraction of consecutive particles whose cell keys are out of order
+         */
+        template <typename Shape = CIC, typename Mesh>
+        double sortDisorder(const Mesh& mesh, const FieldLayout<PLayout::dim>& layout,
+                            SortOrder order = SortOrder::Lexicographic) const;
+
+        /*!
+         * Reorder all attributes with a single kernel per memory space
+         * @param hash the new order; particle i is replaced by the current particle hash(i)
+         */
+        void permute(const detail::hash_type<position_memory_space>& hash);
+
+        /*!
+         * Pack the selected particles into the send buffers and post the sends;
+         * one message is sent for each memory space holding attributes
+         * @param rank the destination rank
+         * @param tag the MPI tag of the first message
+         * @param sendNum the index of the send (determines the send buffers)
+         * @param requests the vector to which the send requests are appended
+         * @param hash indices of the particles to send
+         */
+        template <typename HashType>
         void sendToRank(int rank, int tag, int sendNum, std::vector<MPI_Request>& requests,
-                        const HashType& hash, BufferType& buffer);
+                        const HashType& hash);
 
-        template <typename BufferType>
-        void recvFromRank(int rank, int tag, int recvNum, size_type nRecvs, BufferType& buffer);
+        /*!
+         * Receive particles from another rank and append them to the bunch
+         * @param rank the source rank
+         * @param tag the MPI tag of the first message
+         * @param recvNum the index of the receive (determines the receive buffers)
+         * @param nRecvs the number of particles to receive
+         */
+        void recvFromRank(int rank, int tag, int recvNum, size_type nRecvs);
 
         /*!
-         * Serialize to do MPI calls.
-         * @param ar archive
+         * Post non-blocking receives for the particles sent by another rank;
+         * one message is received for each memory space holding attributes
+         * @param rank the source rank
+         * @param tag the MPI tag of the first message
+         * @param recvNum the index of the receive (determines the receive buffers)
+         * @param nRecvs the number of particles to receive
+         * @param requests the vector to which the receive requests are appended
+         * @return The number of posted messages
          */
-        template <typename Archive>
-        void serialize(Archive& ar, size_type nsends);
+        int irecvFromRank(int rank, int tag, int recvNum, size_type nRecvs,
+                          std::vector<MPI_Request>& requests);
 
         /*!
-         * Deserialize to do MPI calls.
-         * @param ar archive
+         * Append particles received with irecvFromRank once all of their
+         * messages have completed
+         * @param recvNum the index of the receive
+         * @param nRecvs the number of received particles
          */
-        template <typename Archive>
-        void deserialize(Archive& ar, size_type nrecvs);
+        void unpackFromRank(int recvNum, size_type nRecvs);
 
         /*!
          * Determine the total space necessary to store a certain number of particles
@@ -293,23 +424,54 @@ namespace ippl {
 
     protected:
         /*!
-         * Fill attributes of buffer.
-         * @tparam Buffer is a bunch type
-         * @param buffer to send
+         * Compute the cell key of every particle
+         * @param mesh the mesh defining the cells
+         * @param layout the field layout defining the local domain
+         * @param order the cell ordering
+         * @return A view with one key per local particle
+         */
+        template <typename Shape, typename Mesh>
+        sort_key_type computeSortKeys(const Mesh& mesh, const FieldLayout<PLayout::dim>& layout,
+                                      SortOrder order) const;
+
+        /*!
+         * Collect the type-erased storage of all attributes in a memory space
+         * @tparam MemorySpace the memory space
+         * @param size the number of bytes per particle over all attributes (output)
+         * @return A view of the attribute descriptors in the memory space
+         */
+        template <typename MemorySpace>
+        Kokkos::View<detail::ByteView*, MemorySpace> getByteViews(size_type& size);
+
+        /*!
+         * Serialize the attributes of the selected particles in a single kernel.
+         * @tparam MemorySpace only pack attributes stored in this memory space
+         * @param ar archive to write to
          * @param hash function to access index.
          */
-        template <class Buffer>
-        void pack(Buffer& buffer, const hash_container_type& hash);
+        template <typename MemorySpace>
+        void pack(detail::Archive<MemorySpace>& ar, const detail::hash_type<MemorySpace>& hash);
 
         /*!
-         * Fill my attributes.
-         * @tparam Buffer is a bunch type
-         * @param buffer received
+         * Append received particles to my attributes in a single kernel;
+         * the local particle count is not changed.
+         * @tparam MemorySpace only unpack attributes stored in this memory space
+         * @param ar archive to read from
+         * @param nrecvs number of received particles
          */
-        template <class Buffer>
-        void unpack(Buffer& buffer, size_type nrecvs);
+        template <typename MemorySpace>
+        void unpack(detail::Archive<MemorySpace>& ar, size_type nrecvs);
 
     private:
+        /*!
+         * Remove the invalid particles from all attributes
+         * @param invalid View marking which indices are invalid
+         * @param destroyNum Total number of invalid particles
+         */
+        template <typename... Properties>
+        void compactParticles(const Kokkos::View<bool*, Properties...>& invalid,
+                              const size_type destroyNum);
+
         //! particle layout
         // cannot use std::unique_ptr due to Kokkos
         Layout_t* layout_m;
@@ -329,6 +491,17 @@ namespace ippl {
         //! buffers for particle partitioning
         hash_container_type deleteIndex_m;
         hash_container_type keepIndex_m;
+
+        //! arrangement of the particles after deletions
+        CompactionOrder compactionOrder_m;
+
+        //! the deleted particles that are not compacted yet
+        ParticleAttrib<bool, position_memory_space> dead_m;
+        size_type deadNum_m;
+        bool deferDestroy_m;
+
+        //! fraction of dead particles triggering a compaction
+        double compactThreshold_m;
     };
 }  // namespace ippl
 
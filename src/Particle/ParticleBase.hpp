@@ -61,6 +61,12 @@
 // You should have received a copy of the GNU General Public License
 // along with IPPL. If not, see <https://www.gnu.org/licenses/>.
 //
+#include <Kokkos_Sort.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include "Utility/IpplTimings.h"
 
 namespace ippl {
 
@@ -69,7 +75,11 @@ namespace ippl {
         : layout_m(nullptr)
         , localNum_m(0)
         , nextID_m(Comm->rank())
-        , numNodes_m(Comm->size()) {
+        , numNodes_m(Comm->size())
+        , compactionOrder_m(CompactionOrder::FillFromEnd)
+        , deadNum_m(0)
+        , deferDestroy_m(false)
+        , compactThreshold_m(0) {
         if constexpr (EnableIDs) {
             addAttribute(ID);
         }
@@ -87,6 +97,15 @@ namespace ippl {
     void ParticleBase<PLayout, IP...>::addAttribute(detail::ParticleAttribBase<MemorySpace>& pa) {
         attributes_m.template get<MemorySpace>().push_back(&pa);
         pa.setParticleCount(localNum_m);
+        if (deferDestroy_m) {
+            if constexpr (std::is_same_v<MemorySpace, position_memory_space>) {
+                pa.setDeadMask(dead_m.getView());
+            } else {
+                throw IpplException("ParticleBase::addAttribute()",
+                                    "Deferred deletion requires all attributes to be stored "
+                                    "in the memory space of the positions");
+            }
+        }
     }
 
     template <class PLayout, typename... IP>
@@ -119,6 +138,12 @@ namespace ippl {
             nextID_m += numNodes_m * nLocal;
         }
 
+        if (deferDestroy_m) {
+            Kokkos::deep_copy(
+                Kokkos::subview(dead_m.getView(), std::make_pair(localNum_m, localNum_m + nLocal)),
+                false);
+        }
+
         // remember that we're creating these new particles
         localNum_m += nLocal;
     }
@@ -166,6 +191,81 @@ namespace ippl {
             return;
         }
 
+        if (!deferDestroy_m) {
+            compactParticles(invalid, destroyNum);
+            return;
+        }
+
+        // Only mark the particles; the invalid view may include particles that are
+        // dead already
+        using policy_type =
+            Kokkos::RangePolicy<typename Kokkos::View<bool*, Properties...>::execution_space>;
+        auto dead         = dead_m.getView();
+        size_type newDead = 0;
+        Kokkos::parallel_reduce(
+            "ParticleBase::destroy()", policy_type(0, localNum_m),
+            KOKKOS_LAMBDA(const size_t i, size_type& count) {
+                if (invalid(i) && !dead(i)) {
+                    dead(i) = true;
+                    count += 1;
+                }
+            },
+            Kokkos::Sum<size_type>(newDead));
+        deadNum_m += newDead;
+
+        if (deadNum_m > compactThreshold_m * localNum_m) {
+            compact();
+        }
+    }
+
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::enableDeferredDestroy(double threshold) {
+        compactThreshold_m = threshold;
+        if (deferDestroy_m) {
+            return;
+        }
+
+        detail::runForAllSpaces([&]<typename MemorySpace>() {
+            if constexpr (!std::is_same_v<MemorySpace, position_memory_space>) {
+                if (attributes_m.template get<MemorySpace>().size() > 0) {
+                    throw IpplException("ParticleBase::enableDeferredDestroy()",
+                                        "Deferred deletion requires all attributes to be stored "
+                                        "in the memory space of the positions");
+                }
+            }
+        });
+
+        // the mask is an attribute itself, so that it follows the particles
+        for (auto& attribute : attributes_m.template get<position_memory_space>()) {
+            attribute->setDeadMask(dead_m.getView());
+        }
+        addAttribute(dead_m);
+        dead_m.create(0);
+        Kokkos::deep_copy(dead_m.getView(), false);
+
+        deferDestroy_m = true;
+    }
+
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::compact() {
+        if (deadNum_m == 0) {
+            return;
+        }
+
+        static IpplTimings::TimerRef compactTimer = IpplTimings::getTimer("compactParticles");
+        IpplTimings::startTimer(compactTimer);
+
+        // The remaining particles are all alive, so the mask is clear afterwards
+        compactParticles(dead_m.getView(), deadNum_m);
+        deadNum_m = 0;
+
+        IpplTimings::stopTimer(compactTimer);
+    }
+
+    template <class PLayout, typename... IP>
+    template <typename... Properties>
+    void ParticleBase<PLayout, IP...>::compactParticles(
+        const Kokkos::View<bool*, Properties...>& invalid, const size_type destroyNum) {
         // If we're deleting all the particles, there's no point in doing
         // anything because the valid region will be empty; we only need to
         // update the particle count
@@ -181,93 +281,281 @@ namespace ippl {
         auto& locDeleteIndex  = deleteIndex_m.get<memory_space>();
         auto& locKeepIndex    = keepIndex_m.get<memory_space>();
 
-        // Resize buffers, if necessary
-        detail::runForAllSpaces([&]<typename MemorySpace>() {
-            if (attributes_m.template get<memory_space>().size() > 0) {
-                int overalloc = Comm->getDefaultOverallocation();
-                auto& del     = deleteIndex_m.get<memory_space>();
-                auto& keep    = keepIndex_m.get<memory_space>();
-                if (del.size() < destroyNum) {
-                    Kokkos::realloc(del, destroyNum * overalloc);
-                    Kokkos::realloc(keep, destroyNum * overalloc);
-                }
-            }
-        });
+        const bool stable      = compactionOrder_m == CompactionOrder::Stable;
+        const size_type newNum = localNum_m - destroyNum;
 
-        // Reset index buffer
-        Kokkos::deep_copy(locDeleteIndex, -1);
+        // Resize buffers, if necessary; the stable compaction lists all valid particles
+        const int overalloc     = Comm->getDefaultOverallocation();
+        const size_type keepNum = stable ? newNum : destroyNum;
+        if (locDeleteIndex.size() < destroyNum) {
+            Kokkos::realloc(locDeleteIndex, destroyNum * overalloc);
+        }
+        if (locKeepIndex.size() < keepNum) {
+            Kokkos::realloc(locKeepIndex, keepNum * overalloc);
+        }
 
-        // Find the indices of the invalid particles in the valid region
+        // Compute the mapping in a single pass. By default, the invalid particles in the
+        // valid region [0, newNum) are the holes and the valid particles behind it are
+        // moved into them in ascending order. For the stable order, all invalid particles
+        // are holes and all valid particles are listed in their current order.
+        detail::CompactionCount count;
         Kokkos::parallel_scan(
-            "Scan in ParticleBase::destroy()", policy_type(0, localNum_m - destroyNum),
-            KOKKOS_LAMBDA(const size_t i, int& idx, const bool final) {
-                if (final && invalid(i)) {
-                    locDeleteIndex(idx) = i;
+            "Scan in ParticleBase::destroy()", policy_type(0, localNum_m),
+            KOKKOS_LAMBDA(const size_t i, detail::CompactionCount& idx, const bool final) {
+                const bool hole = invalid(i) && (stable || i < newNum);
+                const bool keep = !invalid(i) && (stable || i >= newNum);
+                if (final) {
+                    if (hole) {
+                        locDeleteIndex(idx.holes) = i;
+                    }
+                    if (keep) {
+                        locKeepIndex(idx.keeps) = i;
+                    }
                 }
-                if (invalid(i)) {
-                    idx += 1;
+                idx.holes += hole;
+                idx.keeps += keep;
+            },
+            count);
+        Kokkos::fence();
+
+        localNum_m = newNum;
+
+        auto filter = [&]<typename MemorySpace>() {
+            return attributes_m.template get<MemorySpace>().size() > 0;
+        };
+
+        if (stable) {
+            // The particles in front of the first hole stay where they are; the others
+            // are moved forward through a buffer, since the source and destination
+            // ranges overlap
+            auto first = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), Kokkos::subview(locDeleteIndex, std::make_pair(0, 1)));
+            const size_type firstHole = first(0);
+            const size_type nMoves    = newNum - firstHole;
+
+            keepIndex_m.copyToOtherSpaces<memory_space>(filter);
+
+            detail::runForAllSpaces([&]<typename MemorySpace>() {
+                size_type bufSize = packedSize<MemorySpace>(nMoves);
+                if (bufSize == 0) {
+                    return;
                 }
+
+                // the scratch buffer of the particle permutation
+                auto buf = Comm->getBuffer<MemorySpace>(IPPL_PARTICLE_SORT, bufSize);
+
+                detail::hash_type<MemorySpace> hash(
+                    keepIndex_m.get<MemorySpace>().data() + firstHole, nMoves);
+
+                size_type size = 0;
+                auto views     = getByteViews<MemorySpace>(size);
+                buf->serialize(views, size, hash);
+                buf->deserialize(views, size, firstHole, nMoves);
+                buf->resetWritePos();
+                buf->resetReadPos();
+            });
+        } else {
+            deleteIndex_m.copyToOtherSpaces<memory_space>(filter);
+            keepIndex_m.copyToOtherSpaces<memory_space>(filter);
+
+            // Fill the holes with all attributes of a memory space in one kernel; the
+            // holes and the moved particles are disjoint
+            const size_type nMoves = count.holes;
+            detail::runForAllSpaces([&]<typename MemorySpace>() {
+                if (nMoves == 0 || attributes_m.template get<MemorySpace>().size() == 0) {
+                    return;
+                }
+
+                size_type size = 0;
+                auto views     = getByteViews<MemorySpace>(size);
+                auto& del      = deleteIndex_m.get<MemorySpace>();
+                auto& keep     = keepIndex_m.get<MemorySpace>();
+
+                using mdrange_type =
+                    Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::IndexType<size_type>,
+                                          typename MemorySpace::execution_space>;
+                Kokkos::parallel_for(
+                    "ParticleBase::destroy()",
+                    mdrange_type({0, 0}, {(long int)nMoves, (long int)views.extent(0)}),
+                    KOKKOS_LAMBDA(const size_type k, const size_type a) {
+                        const detail::ByteView& v = views(a);
+                        std::memcpy(v.data + del(k) * v.size, v.data + keep(k) * v.size,
+                                    v.size);
+                    });
             });
+        }
         Kokkos::fence();
+    }
 
-        // Determine the total number of invalid particles in the valid region
-        size_type maxDeleteIndex = 0;
+    template <class PLayout, typename... IP>
+    template <typename Shape, typename Mesh>
+    void ParticleBase<PLayout, IP...>::sort(const Mesh& mesh,
+                                            const FieldLayout<PLayout::dim>& layout,
+                                            SortOrder order) {
+        static IpplTimings::TimerRef sortTimer = IpplTimings::getTimer("sortParticles");
+        IpplTimings::startTimer(sortTimer);
+
+        // the sort permutes all particles anyway, so the dead ones are removed first
+        compact();
+
+        if (localNum_m < 2) {
+            IpplTimings::stopTimer(sortTimer);
+            return;
+        }
+
+        using execution_space = typename particle_position_type::execution_space;
+        using policy_type     = Kokkos::RangePolicy<execution_space>;
+
+        sort_key_type keys = computeSortKeys<Shape>(mesh, layout, order);
+
+        std::uint64_t minKey = 0, maxKey = 0;
         Kokkos::parallel_reduce(
-            "Reduce in ParticleBase::destroy()", policy_type(0, destroyNum),
-            KOKKOS_LAMBDA(const size_t i, size_t& maxIdx) {
-                if (locDeleteIndex(i) >= 0 && i > maxIdx) {
-                    maxIdx = i;
+            "Min key in ParticleBase::sort()", policy_type(0, localNum_m),
+            KOKKOS_LAMBDA(const size_t i, std::uint64_t& val) {
+                if (keys(i) < val) {
+                    val = keys(i);
                 }
             },
-            Kokkos::Max<size_type>(maxDeleteIndex));
-
-        // Find the indices of the valid particles in the invalid region
-        Kokkos::parallel_scan(
-            "Second scan in ParticleBase::destroy()",
-            Kokkos::RangePolicy<size_type, execution_space>(localNum_m - destroyNum, localNum_m),
-            KOKKOS_LAMBDA(const size_t i, int& idx, const bool final) {
-                if (final && !invalid(i)) {
-                    locKeepIndex(idx) = i;
-                }
-                if (!invalid(i)) {
-                    idx += 1;
+            Kokkos::Min<std::uint64_t>(minKey));
+        Kokkos::parallel_reduce(
+            "Max key in ParticleBase::sort()", policy_type(0, localNum_m),
+            KOKKOS_LAMBDA(const size_t i, std::uint64_t& val) {
+                if (keys(i) > val) {
+                    val = keys(i);
                 }
-            });
-
+            },
+            Kokkos::Max<std::uint64_t>(maxKey));
+
+        // Lexicographic keys are dense, so that each bin holds exactly one cell;
+        // Morton keys are spread out and are additionally sorted within the bins
+        const NDIndex<PLayout::dim>& lDom = layout.getLocalNDIndex();
+        std::uint64_t nCells             = 1;
+        for (unsigned d = 0; d < PLayout::dim; ++d) {
+            nCells *= lDom[d].length() + Shape::width - 1;
+        }
+        int nBins = std::max<std::uint64_t>(std::min(maxKey - minKey + 1, nCells), 1);
+
+        using bin_op_type = Kokkos::BinOp1D<sort_key_type>;
+        Kokkos::BinSort<sort_key_type, bin_op_type> binSort(keys, 0, localNum_m,
+                                                            bin_op_type(nBins, minKey, maxKey),
+                                                            order != SortOrder::Lexicographic);
+        binSort.create_permute_vector();
+        auto permutation = binSort.get_permute_vector();
+
+        detail::hash_type<position_memory_space> hash("sort permutation", localNum_m);
+        Kokkos::parallel_for(
+            "Permutation in ParticleBase::sort()", policy_type(0, localNum_m),
+            KOKKOS_LAMBDA(const size_t i) { hash(i) = permutation(i); });
         Kokkos::fence();
 
-        localNum_m -= destroyNum;
+        permute(hash);
+        IpplTimings::stopTimer(sortTimer);
+    }
 
-        auto filter = [&]<typename MemorySpace>() {
+    template <class PLayout, typename... IP>
+    template <typename Shape, typename Mesh>
+    double ParticleBase<PLayout, IP...>::sortDisorder(const Mesh& mesh,
+                                                      const FieldLayout<PLayout::dim>& layout,
+                                                      SortOrder order) const {
+        if (localNum_m < 2) {
+            return 0;
+        }
+
+        using execution_space = typename particle_position_type::execution_space;
+        using policy_type     = Kokkos::RangePolicy<execution_space>;
+
+        sort_key_type keys = computeSortKeys<Shape>(mesh, layout, order);
+
+        size_type descents = 0;
+        Kokkos::parallel_reduce(
+            "ParticleBase::sortDisorder()", policy_type(0, localNum_m - 1),
+            KOKKOS_LAMBDA(const size_t i, size_type& count) { count += keys(i) > keys(i + 1); },
+            Kokkos::Sum<size_type>(descents));
+
+        return double(descents) / (localNum_m - 1);
+    }
+
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::permute(
+        const detail::hash_type<position_memory_space>& hash) {
+        PAssert(hash.size() == localNum_m);
+
+        auto hashes = hash_container_type(hash, [&]<typename MemorySpace>() {
             return attributes_m.template get<MemorySpace>().size() > 0;
-        };
-        deleteIndex_m.copyToOtherSpaces<memory_space>(filter);
-        keepIndex_m.copyToOtherSpaces<memory_space>(filter);
-
-        // Partition the attributes into valid and invalid regions
-        // NOTE: The vector elements are pointers, but we want to extract
-        // the memory space from the class type, so we explicitly
-        // make the lambda argument a pointer to the template parameter
-        forAllAttributes([&]<typename Attribute>(Attribute*& attribute) {
-            using att_memory_space = typename Attribute::memory_space;
-            auto& del              = deleteIndex_m.get<att_memory_space>();
-            auto& keep             = keepIndex_m.get<att_memory_space>();
-            attribute->destroy(del, keep, maxDeleteIndex + 1);
         });
+        detail::runForAllSpaces([&]<typename MemorySpace>() {
+            size_type bufSize = packedSize<MemorySpace>(localNum_m);
+            if (bufSize == 0) {
+                return;
+            }
+
+            // gather all attributes into the buffer in the new order and copy them back
+            auto buf = Comm->getBuffer<MemorySpace>(IPPL_PARTICLE_SORT, bufSize);
+
+            size_type size = 0;
+            auto views     = getByteViews<MemorySpace>(size);
+            buf->serialize(views, size, hashes.template get<MemorySpace>());
+            buf->deserialize(views, size, 0, localNum_m);
+            buf->resetWritePos();
+            buf->resetReadPos();
+        });
+    }
+
+    template <class PLayout, typename... IP>
+    template <typename Shape, typename Mesh>
+    typename ParticleBase<PLayout, IP...>::sort_key_type
+    ParticleBase<PLayout, IP...>::computeSortKeys(const Mesh& mesh,
+                                                  const FieldLayout<PLayout::dim>& layout,
+                                                  SortOrder order) const {
+        constexpr unsigned Dim = PLayout::dim;
+
+        using execution_space = typename particle_position_type::execution_space;
+        using policy_type     = Kokkos::RangePolicy<execution_space>;
+        using vector_type     = typename Mesh::vector_type;
+        using array_layout =
+            typename detail::ViewType<double, Dim, position_memory_space>::view_type::array_layout;
+
+        const vector_type& dx     = mesh.getMeshSpacing();
+        const vector_type& origin = mesh.getOrigin();
+        const vector_type invdx   = 1.0 / dx;
+
+        // The cells are identified by the first grid point of the interpolation stencil,
+        // so that the particles of a cell share their stencil. The local domain contains
+        // width - 1 such cells more than mesh cells.
+        const NDIndex<Dim>& lDom = layout.getLocalNDIndex();
+        Vector<int, Dim> first, extent;
+        for (unsigned d = 0; d < Dim; ++d) {
+            first[d]  = lDom[d].first();
+            extent[d] = lDom[d].length() + Shape::width - 1;
+        }
+
+        sort_key_type keys("sort keys", localNum_m);
+        auto positions = R.getView();
+        Kokkos::parallel_for(
+            "ParticleBase::computeSortKeys()", policy_type(0, localNum_m),
+            KOKKOS_LAMBDA(const size_t i) {
+                Vector<int, Dim> cell;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    int c = Shape::first((positions(i)[d] - origin[d]) * invdx[d] - 0.5) + 1
+                            - first[d];
+                    cell[d] = c < 0 ? 0 : (c < extent[d] ? c : extent[d] - 1);
+                }
+                keys(i) = detail::cellKey<array_layout>(cell, extent, order);
+            });
+        Kokkos::fence();
+        return keys;
     }
 
     template <class PLayout, typename... IP>
-    template <typename HashType, typename BufferType>
+    template <typename HashType>
     void ParticleBase<PLayout, IP...>::sendToRank(int rank, int tag, int sendNum,
                                                   std::vector<MPI_Request>& requests,
-                                                  const HashType& hash, BufferType& buffer) {
+                                                  const HashType& hash) {
         size_type nSends = hash.size();
-        requests.resize(requests.size() + 1);
 
         auto hashes = hash_container_type(hash, [&]<typename MemorySpace>() {
             return attributes_m.template get<MemorySpace>().size() > 0;
         });
-        pack(buffer, hashes);
         detail::runForAllSpaces([&]<typename MemorySpace>() {
             size_type bufSize = packedSize<MemorySpace>(nSends);
             if (bufSize == 0) {
@@ -276,15 +564,27 @@ namespace ippl {
 
             auto buf = Comm->getBuffer<MemorySpace>(IPPL_PARTICLE_SEND + sendNum, bufSize);
 
-            Comm->isend(rank, tag++, buffer, *buf, requests.back(), nSends);
+            pack(*buf, hashes.template get<MemorySpace>());
+            requests.emplace_back();
+            Comm->isend(rank, tag++, *buf, requests.back());
             buf->resetWritePos();
         });
     }
 
     template <class PLayout, typename... IP>
-    template <typename BufferType>
     void ParticleBase<PLayout, IP...>::recvFromRank(int rank, int tag, int recvNum,
-                                                    size_type nRecvs, BufferType& buffer) {
+                                                    size_type nRecvs) {
+        std::vector<MPI_Request> requests;
+        irecvFromRank(rank, tag, recvNum, nRecvs, requests);
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        unpackFromRank(recvNum, nRecvs);
+    }
+
+    template <class PLayout, typename... IP>
+    int ParticleBase<PLayout, IP...>::irecvFromRank(int rank, int tag, int recvNum,
+                                                    size_type nRecvs,
+                                                    std::vector<MPI_Request>& requests) {
+        int nMessages = 0;
         detail::runForAllSpaces([&]<typename MemorySpace>() {
             size_type bufSize = packedSize<MemorySpace>(nRecvs);
             if (bufSize == 0) {
@@ -293,28 +593,27 @@ namespace ippl {
 
             auto buf = Comm->getBuffer<MemorySpace>(IPPL_PARTICLE_RECV + recvNum, bufSize);
 
-            Comm->recv(rank, tag++, buffer, *buf, bufSize, nRecvs);
-            buf->resetReadPos();
+            requests.emplace_back();
+            Comm->irecv(rank, tag++, *buf, requests.back(), bufSize);
+            ++nMessages;
         });
-        unpack(buffer, nRecvs);
+        return nMessages;
     }
 
     template <class PLayout, typename... IP>
-    template <typename Archive>
-    void ParticleBase<PLayout, IP...>::serialize(Archive& ar, size_type nsends) {
-        using memory_space = typename Archive::buffer_type::memory_space;
-        forAllAttributes<memory_space>([&]<typename Attribute>(Attribute& att) {
-            att->serialize(ar, nsends);
-        });
-    }
+    void ParticleBase<PLayout, IP...>::unpackFromRank(int recvNum, size_type nRecvs) {
+        detail::runForAllSpaces([&]<typename MemorySpace>() {
+            size_type bufSize = packedSize<MemorySpace>(nRecvs);
+            if (bufSize == 0) {
+                return;
+            }
 
-    template <class PLayout, typename... IP>
-    template <typename Archive>
-    void ParticleBase<PLayout, IP...>::deserialize(Archive& ar, size_type nrecvs) {
-        using memory_space = typename Archive::buffer_type::memory_space;
-        forAllAttributes<memory_space>([&]<typename Attribute>(Attribute& att) {
-            att->deserialize(ar, nrecvs);
+            auto buf = Comm->getBuffer<MemorySpace>(IPPL_PARTICLE_RECV + recvNum, bufSize);
+
+            unpack(*buf, nRecvs);
+            buf->resetReadPos();
         });
+        localNum_m += nRecvs;
     }
 
     template <class PLayout, typename... IP>
@@ -328,26 +627,45 @@ namespace ippl {
     }
 
     template <class PLayout, typename... IP>
-    template <class Buffer>
-    void ParticleBase<PLayout, IP...>::pack(Buffer& buffer, const hash_container_type& hash) {
-        detail::runForAllSpaces([&]<typename MemorySpace>() {
-            auto& att = attributes_m.template get<MemorySpace>();
-            for (unsigned j = 0; j < att.size(); j++) {
-                att[j]->pack(buffer.template getAttribute<MemorySpace>(j),
-                             hash.template get<MemorySpace>());
-            }
-        });
+    template <typename MemorySpace>
+    Kokkos::View<detail::ByteView*, MemorySpace> ParticleBase<PLayout, IP...>::getByteViews(
+        size_type& size) {
+        std::vector<detail::ByteView> arrays;
+        for (auto& attribute : attributes_m.template get<MemorySpace>()) {
+            attribute->appendByteViews(arrays);
+        }
+
+        Kokkos::View<detail::ByteView*, MemorySpace> views("attribute byte views", arrays.size());
+        auto views_host = Kokkos::create_mirror_view(views);
+
+        size = 0;
+        for (unsigned j = 0; j < arrays.size(); j++) {
+            views_host(j)        = arrays[j];
+            views_host(j).offset = size;
+            size += views_host(j).size;
+        }
+        Kokkos::deep_copy(views, views_host);
+        return views;
     }
 
     template <class PLayout, typename... IP>
-    template <class Buffer>
-    void ParticleBase<PLayout, IP...>::unpack(Buffer& buffer, size_type nrecvs) {
-        detail::runForAllSpaces([&]<typename MemorySpace>() {
-            auto& att = attributes_m.template get<MemorySpace>();
-            for (unsigned j = 0; j < att.size(); j++) {
-                att[j]->unpack(buffer.template getAttribute<MemorySpace>(j), nrecvs);
-            }
+    template <typename MemorySpace>
+    void ParticleBase<PLayout, IP...>::pack(detail::Archive<MemorySpace>& ar,
+                                            const detail::hash_type<MemorySpace>& hash) {
+        size_type size = 0;
+        auto views     = getByteViews<MemorySpace>(size);
+        ar.serialize(views, size, hash);
+    }
+
+    template <class PLayout, typename... IP>
+    template <typename MemorySpace>
+    void ParticleBase<PLayout, IP...>::unpack(detail::Archive<MemorySpace>& ar, size_type nrecvs) {
+        forAllAttributes<MemorySpace>([&]<typename Attribute>(Attribute& att) {
+            att->reserve(localNum_m + nrecvs);
         });
-        localNum_m += nrecvs;
+
+        size_type size = 0;
+        auto views     = getByteViews<MemorySpace>(size);
+        ar.deserialize(views, size, localNum_m, nrecvs);
     }
 }  // namespace ippl
@@ -91,6 +91,8 @@ namespace ippl {
              */
             void setParticleBC(BC bc) { bcs_m.fill(bc); }
 
+            const bc_container_type& getParticleBC() const { return bcs_m; }
+
             /*!
              * Apply the given boundary conditions to the current particle positions.
              * @tparam R is the particle position attribute
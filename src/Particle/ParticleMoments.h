@@ -0,0 +1,510 @@
+//
+// ParticleMoments
+//   Several reductions over particle attributes in a single pass.
+//
+//   The reductions of ParticleAttrib (sum(), max(), ...) each launch a kernel
+//   and a blocking MPI_Allreduce. Diagnostics such as RMS beam sizes or the
+//   emittance need many of them per time step. reduceMoments accumulates any
+//   number of moments of several attributes of a bunch in one kernel and
+//   combines them with one MPI reduction:
+//
+//     auto [n, meanP, covR, Rmin, Rmax] =
+//         ippl::reduceMoments(bunch, ippl::moment::count(), ippl::moment::mean(bunch.P),
+//                             ippl::moment::covariance(bunch.R, bunch.R),
+//                             ippl::moment::min(bunch.R), ippl::moment::max(bunch.R));
+//
+//   reduceMomentsAsync starts the same reduction with MPI_Iallreduce and
+//   returns a request whose wait() yields the results, so that the
+//   communication overlaps with other work.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_PARTICLE_MOMENTS_H
+#define IPPL_PARTICLE_MOMENTS_H
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Types/IpplTypes.h"
+#include "Types/Vector.h"
+
+#include "Particle/ParticleAttribBase.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * Component access for scalar and vector attribute values
+         */
+        template <typename V>
+        struct MomentTraits {
+            using scalar_type = V;
+            using result_type = V;
+
+            static constexpr unsigned size = 1;
+
+            template <typename Value>
+            KOKKOS_INLINE_FUNCTION static scalar_type get(const Value& v, unsigned) {
+                return v;
+            }
+
+            static result_type result(const scalar_type* values, scalar_type scale) {
+                return values[0] / scale;
+            }
+        };
+
+        template <typename T, unsigned Dim>
+        struct MomentTraits<Vector<T, Dim>> {
+            using scalar_type = T;
+            using result_type = Vector<T, Dim>;
+
+            static constexpr unsigned size = Dim;
+
+            template <typename Value>
+            KOKKOS_INLINE_FUNCTION static scalar_type get(const Value& v, unsigned d) {
+                return v[d];
+            }
+
+            static result_type result(const scalar_type* values, scalar_type scale) {
+                result_type r;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    r[d] = values[d] / scale;
+                }
+                return r;
+            }
+        };
+
+        /*
+         * A moment accumulates its values either into the sums or into the
+         * maxima of the reduction buffer. Minima are accumulated as maxima of
+         * the negated values. accumulate() receives the number of particles
+         * including the current one, and join() combines the partial results
+         * of two sets of particles with their counts n and nsrc.
+         */
+
+        //! The number of live particles
+        struct CountMoment {
+            using memory_space = void;
+            using scalar_type  = double;
+            using result_type  = size_type;
+
+            static constexpr size_t sums = 0, maxima = 0;
+
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION void accumulate(size_t, T*, T*, T) const {}
+
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION static void join(T*, T*, const T*, const T*, T, T) {}
+
+            template <typename T>
+            result_type finalize(const T*, const T*, T count) const {
+                return static_cast<size_type>(count);
+            }
+        };
+
+        //! The sum or the mean of an attribute
+        template <typename Attrib>
+        struct SumMoment {
+            using traits       = MomentTraits<typename Attrib::value_type>;
+            using memory_space = typename Attrib::memory_space;
+            using scalar_type  = typename traits::scalar_type;
+            using result_type  = typename traits::result_type;
+
+            static constexpr size_t sums = traits::size, maxima = 0;
+
+            typename Attrib::view_type view;
+            bool mean;
+
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION void accumulate(size_t i, T* s, T*, T) const {
+                for (unsigned d = 0; d < traits::size; ++d) {
+                    s[d] += traits::get(view(i), d);
+                }
+            }
+
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION static void join(T* s, T*, const T* src, const T*, T, T) {
+                for (unsigned d = 0; d < traits::size; ++d) {
+                    s[d] += src[d];
+                }
+            }
+
+            template <typename T>
+            result_type finalize(const T* s, const T*, T count) const {
+                scalar_type values[traits::size];
+                for (unsigned d = 0; d < traits::size; ++d) {
+                    values[d] = mean ? s[d] / count : s[d];
+                }
+                return traits::result(values, 1);
+            }
+        };
+
+        //! The component-wise maximum (sign = 1) or minimum (sign = -1) of an attribute
+        template <typename Attrib>
+        struct ExtremumMoment {
+            using traits       = MomentTraits<typename Attrib::value_type>;
+            using memory_space = typename Attrib::memory_space;
+            using scalar_type  = typename traits::scalar_type;
+            using result_type  = typename traits::result_type;
+
+            static constexpr size_t sums = 0, maxima = traits::size;
+
+            typename Attrib::view_type view;
+            int sign;
+
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION void accumulate(size_t i, T*, T* m, T) const {
+                for (unsigned d = 0; d < traits::size; ++d) {
+                    const T value = sign * traits::get(view(i), d);
+                    if (value > m[d]) {
+                        m[d] = value;
+                    }
+                }
+            }
+
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION static void join(T*, T* m, const T*, const T* src, T, T) {
+                for (unsigned d = 0; d < traits::size; ++d) {
+                    if (src[d] > m[d]) {
+                        m[d] = src[d];
+                    }
+                }
+            }
+
+            template <typename T>
+            result_type finalize(const T*, const T* m, T) const {
+                scalar_type values[traits::size];
+                for (unsigned d = 0; d < traits::size; ++d) {
+                    values[d] = sign * m[d];
+                }
+                return traits::result(values, 1);
+            }
+        };
+
+        /*!
+         * The second moments <a_d b_e> of two attributes, or their covariance
+         * <a_d b_e> - <a_d><b_e> if central is set. The result is indexed as
+         * result[d][e].
+         *
+         * The raw sums of a_d b_e lose most significant digits to cancellation
+         * when the attributes are far from zero, e.g. for a beam away from the
+         * origin. The means and the centered sums of (a_d - <a_d>)(b_e - <b_e>)
+         * are therefore accumulated instead, with Welford's update per particle
+         * and the pairwise formula of Chan et al. to join partial results.
+         */
+        template <typename AttribA, typename AttribB>
+        struct SecondMoment {
+            using traits_a     = MomentTraits<typename AttribA::value_type>;
+            using traits_b     = MomentTraits<typename AttribB::value_type>;
+            using memory_space = typename AttribA::memory_space;
+            using scalar_type  = typename traits_a::scalar_type;
+            using result_type  = Vector<Vector<scalar_type, traits_b::size>, traits_a::size>;
+
+            static_assert(std::is_same_v<memory_space, typename AttribB::memory_space>,
+                          "Both attributes must be stored in the same memory space");
+
+            static constexpr size_t na = traits_a::size, nb = traits_b::size;
+            static constexpr size_t sums = na + nb + na * nb, maxima = 0;
+
+            typename AttribA::view_type a;
+            typename AttribB::view_type b;
+            bool central;
+
+            // the buffer holds the means of a, the means of b and the centered sums
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION void accumulate(size_t i, T* s, T*, T n) const {
+                T da[na];
+                for (unsigned d = 0; d < na; ++d) {
+                    da[d] = traits_a::get(a(i), d) - s[d];
+                    s[d] += da[d] / n;
+                }
+                for (unsigned e = 0; e < nb; ++e) {
+                    const T be = traits_b::get(b(i), e);
+                    s[na + e] += (be - s[na + e]) / n;
+                    for (unsigned d = 0; d < na; ++d) {
+                        s[na + nb + d * nb + e] += da[d] * (be - s[na + e]);
+                    }
+                }
+            }
+
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION static void join(T* s, T*, const T* src, const T*, T n,
+                                                    T nsrc) {
+                if (nsrc == 0) {
+                    return;
+                }
+                const T total = n + nsrc;
+                T delta[na + nb];
+                for (unsigned k = 0; k < na + nb; ++k) {
+                    delta[k] = src[k] - s[k];
+                    s[k] += delta[k] * (nsrc / total);
+                }
+                for (unsigned d = 0; d < na; ++d) {
+                    for (unsigned e = 0; e < nb; ++e) {
+                        s[na + nb + d * nb + e] += src[na + nb + d * nb + e]
+                                                   + delta[d] * delta[na + e] * (n / total) * nsrc;
+                    }
+                }
+            }
+
+            template <typename T>
+            result_type finalize(const T* s, const T*, T count) const {
+                result_type r;
+                for (unsigned d = 0; d < na; ++d) {
+                    for (unsigned e = 0; e < nb; ++e) {
+                        T value = s[na + nb + d * nb + e] / count;
+                        if (!central) {
+                            value += s[d] * s[na + e];
+                        }
+                        r[d][e] = value;
+                    }
+                }
+                return r;
+            }
+        };
+
+        /*!
+         * The moments of a reduction with their offsets into the reduction
+         * buffer
+         * @tparam S the offset of the sums of the first moment
+         * @tparam M the offset of the maxima of the first moment
+         */
+        template <size_t S, size_t M, typename... Moments>
+        struct MomentList {
+            MomentList() = default;
+
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION void accumulate(size_t, T*) const {}
+
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION static void join(T*, const T*) {}
+
+            template <typename T>
+            std::tuple<> finalize(const T*, T) const {
+                return {};
+            }
+        };
+
+        template <size_t S, size_t M, typename Moment, typename... Moments>
+        struct MomentList<S, M, Moment, Moments...> {
+            MomentList(const Moment& moment, const Moments&... moments)
+                : head(moment)
+                , tail(moments...) {}
+
+            using tail_type = MomentList<S + Moment::sums, M + Moment::maxima, Moments...>;
+
+            Moment head;
+            tail_type tail;
+
+            // the number of particles is the first entry of the buffer
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION void accumulate(size_t i, T* data) const {
+                head.accumulate(i, data + S, data + M, data[0]);
+                tail.accumulate(i, data);
+            }
+
+            template <typename T>
+            KOKKOS_INLINE_FUNCTION static void join(T* data, const T* src) {
+                Moment::join(data + S, data + M, src + S, src + M, data[0], src[0]);
+                tail_type::join(data, src);
+            }
+
+            template <typename T>
+            auto finalize(const T* data, T count) const {
+                return std::tuple_cat(std::make_tuple(head.finalize(data + S, data + M, count)),
+                                      tail.finalize(data, count));
+            }
+        };
+
+        /*!
+         * Combine two reduction buffers; the moments are joined before the
+         * counts are added, since joining may depend on both counts
+         * @tparam List the MomentList of the buffer
+         */
+        template <typename List, typename T>
+        KOKKOS_INLINE_FUNCTION void joinMoments(T* dest, const T* src) {
+            List::join(dest, src);
+            dest[0] += src[0];
+        }
+
+        /*!
+         * Kokkos reducer for the reduction buffer. The buffer holds the number
+         * of particles, the sums and the maxima.
+         * @tparam T the value type
+         * @tparam N the size of the buffer
+         * @tparam MaxBegin the offset of the maxima
+         * @tparam List the MomentList of the buffer
+         */
+        template <typename T, size_t N, size_t MaxBegin, typename List>
+        struct MomentReducer {
+            struct value_type {
+                T data[N];
+            };
+
+            using reducer          = MomentReducer;
+            using result_view_type = Kokkos::View<value_type, Kokkos::HostSpace,
+                                                  Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+            KOKKOS_INLINE_FUNCTION MomentReducer(value_type& value)
+                : value_m(&value) {}
+
+            KOKKOS_INLINE_FUNCTION void join(value_type& dest, const value_type& src) const {
+                joinMoments<List>(dest.data, src.data);
+            }
+
+            KOKKOS_INLINE_FUNCTION void init(value_type& val) const {
+                for (size_t k = 0; k < MaxBegin; ++k) {
+                    val.data[k] = 0;
+                }
+                for (size_t k = MaxBegin; k < N; ++k) {
+                    val.data[k] = Kokkos::reduction_identity<T>::max();
+                }
+            }
+
+            KOKKOS_INLINE_FUNCTION value_type& reference() const { return *value_m.data(); }
+
+            KOKKOS_INLINE_FUNCTION result_view_type view() const { return value_m; }
+
+            KOKKOS_INLINE_FUNCTION bool references_scalar() const { return true; }
+
+        private:
+            result_view_type value_m;
+        };
+
+        /*!
+         * MPI operation combining reduction buffers of MomentReducer. Each
+         * element of the reduction is a whole buffer of N values, so that the
+         * layout does not depend on how MPI segments the reduction.
+         */
+        template <typename T, size_t N, typename List>
+        void momentReduction(void* in, void* inout, int* len, MPI_Datatype*);
+    }  // namespace detail
+
+    namespace moment {
+        //! The global number of live particles
+        inline detail::CountMoment count() {
+            return {};
+        }
+
+        //! The sum of an attribute over all particles
+        template <typename Attrib>
+        detail::SumMoment<Attrib> sum(const Attrib& attrib) {
+            return {attrib.getView(), false};
+        }
+
+        //! The mean of an attribute
+        template <typename Attrib>
+        detail::SumMoment<Attrib> mean(const Attrib& attrib) {
+            return {attrib.getView(), true};
+        }
+
+        //! The component-wise minimum of an attribute
+        template <typename Attrib>
+        detail::ExtremumMoment<Attrib> min(const Attrib& attrib) {
+            return {attrib.getView(), -1};
+        }
+
+        //! The component-wise maximum of an attribute
+        template <typename Attrib>
+        detail::ExtremumMoment<Attrib> max(const Attrib& attrib) {
+            return {attrib.getView(), 1};
+        }
+
+        //! The raw second moments <a_d b_e>
+        template <typename AttribA, typename AttribB>
+        detail::SecondMoment<AttribA, AttribB> secondMoment(const AttribA& a, const AttribB& b) {
+            return {a.getView(), b.getView(), false};
+        }
+
+        //! The covariances <a_d b_e> - <a_d><b_e>
+        template <typename AttribA, typename AttribB>
+        detail::SecondMoment<AttribA, AttribB> covariance(const AttribA& a, const AttribB& b) {
+            return {a.getView(), b.getView(), true};
+        }
+    }  // namespace moment
+
+    /*!
+     * A reduction of particle moments whose MPI communication is in progress
+     * @tparam Moments the requested moments
+     */
+    template <typename... Moments>
+    class MomentRequest {
+    public:
+        // the count and the sums are accumulated in at least double precision; in
+        // single precision the count would stop growing at 2^24 particles
+        using value_type  = std::common_type_t<double, typename Moments::scalar_type...>;
+        using result_type = std::tuple<typename Moments::result_type...>;
+
+        static constexpr size_t maxBegin = 1 + (Moments::sums + ... + 0);
+        static constexpr size_t size     = maxBegin + (Moments::maxima + ... + 0);
+
+        using list_type = detail::MomentList<1, maxBegin, Moments...>;
+
+        MomentRequest(const list_type& moments, std::vector<value_type>&& local);
+
+        MomentRequest(MomentRequest&& other);
+
+        MomentRequest(const MomentRequest&)            = delete;
+        MomentRequest& operator=(const MomentRequest&) = delete;
+
+        ~MomentRequest();
+
+        /*!
+         * @returns Whether the reduction has completed
+         */
+        bool test();
+
+        /*!
+         * Wait for the reduction to complete
+         * @returns The moments in the order they were requested
+         */
+        result_type wait();
+
+    private:
+        list_type moments_m;
+
+        std::vector<value_type> local_m;
+        std::vector<value_type> global_m;
+
+        MPI_Request request_m;
+    };
+
+    /*!
+     * Start the reduction of several moments of the live particles of a bunch
+     * in a single kernel and a single non-blocking MPI reduction
+     * @param bunch the particle bunch the attributes belong to
+     * @param moments the moments, created with the functions in ippl::moment
+     * @returns The request for the results
+     */
+    template <typename Bunch, typename... Moments>
+    MomentRequest<Moments...> reduceMomentsAsync(const Bunch& bunch, const Moments&... moments);
+
+    /*!
+     * Reduce several moments of the live particles of a bunch in a single
+     * kernel and a single MPI reduction
+     * @param bunch the particle bunch the attributes belong to
+     * @param moments the moments, created with the functions in ippl::moment
+     * @returns The moments in the order they were requested
+     */
+    template <typename Bunch, typename... Moments>
+    std::tuple<typename Moments::result_type...> reduceMoments(const Bunch& bunch,
+                                                               const Moments&... moments);
+}  // namespace ippl
+
+#include "Particle/ParticleMoments.hpp"
+
+#endif
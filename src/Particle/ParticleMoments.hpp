@@ -0,0 +1,149 @@
+//
+// ParticleMoments
+//   Several reductions over particle attributes in a single pass.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Ippl.h"
+
+#include "Communicate/DataTypes.h"
+
+namespace ippl {
+    namespace detail {
+        template <typename T, size_t N, typename List>
+        void momentReduction(void* in, void* inout, int* len, MPI_Datatype*) {
+            const T* src = static_cast<const T*>(in);
+            T* dest      = static_cast<T*>(inout);
+            for (int k = 0; k < *len; ++k) {
+                joinMoments<List>(dest + k * N, src + k * N);
+            }
+        }
+
+        /*!
+         * @returns The MPI operation for moment reductions of the given buffer,
+         * which is created on first use
+         */
+        template <typename T, size_t N, typename List>
+        MPI_Op getMomentOp() {
+            static MPI_Op op = [] {
+                MPI_Op newOp;
+                MPI_Op_create(&momentReduction<T, N, List>, 1, &newOp);
+                return newOp;
+            }();
+            return op;
+        }
+
+        /*!
+         * @returns The MPI datatype of a whole reduction buffer of N values of
+         * type T, which is created on first use
+         */
+        template <typename T, size_t N>
+        MPI_Datatype getMomentType() {
+            static MPI_Datatype type = [] {
+                T value{};
+                MPI_Datatype newType;
+                MPI_Type_contiguous(N, get_mpi_datatype<T>(value), &newType);
+                MPI_Type_commit(&newType);
+                return newType;
+            }();
+            return type;
+        }
+    }  // namespace detail
+
+    template <typename... Moments>
+    MomentRequest<Moments...>::MomentRequest(const list_type& moments,
+                                             std::vector<value_type>&& local)
+        : moments_m(moments)
+        , local_m(std::move(local))
+        , global_m(size) {
+        // the buffer is reduced as a single element, since the sums and the
+        // maxima need different operations
+        MPI_Iallreduce(local_m.data(), global_m.data(), 1,
+                       detail::getMomentType<value_type, size>(),
+                       detail::getMomentOp<value_type, size, list_type>(), Comm->getCommunicator(),
+                       &request_m);
+    }
+
+    template <typename... Moments>
+    MomentRequest<Moments...>::MomentRequest(MomentRequest&& other)
+        : moments_m(other.moments_m)
+        , local_m(std::move(other.local_m))
+        , global_m(std::move(other.global_m))
+        , request_m(other.request_m) {
+        // the buffers are moved along, so MPI keeps writing to valid memory
+        other.request_m = MPI_REQUEST_NULL;
+    }
+
+    template <typename... Moments>
+    MomentRequest<Moments...>::~MomentRequest() {
+        if (request_m != MPI_REQUEST_NULL) {
+            MPI_Wait(&request_m, MPI_STATUS_IGNORE);
+        }
+    }
+
+    template <typename... Moments>
+    bool MomentRequest<Moments...>::test() {
+        int flag;
+        MPI_Test(&request_m, &flag, MPI_STATUS_IGNORE);
+        return flag;
+    }
+
+    template <typename... Moments>
+    typename MomentRequest<Moments...>::result_type MomentRequest<Moments...>::wait() {
+        MPI_Wait(&request_m, MPI_STATUS_IGNORE);
+        return moments_m.finalize(global_m.data(), global_m[0]);
+    }
+
+    template <typename Bunch, typename... Moments>
+    MomentRequest<Moments...> reduceMomentsAsync(const Bunch& bunch, const Moments&... moments) {
+        using request_type = MomentRequest<Moments...>;
+        using value_type   = typename request_type::value_type;
+        using memory_space = typename Bunch::position_memory_space;
+
+        static_assert(((std::is_void_v<typename Moments::memory_space>
+                        || std::is_same_v<typename Moments::memory_space, memory_space>)
+                       && ...),
+                      "All attributes must be stored in the memory space of the positions");
+
+        using reducer_type = detail::MomentReducer<value_type, request_type::size,
+                                                   request_type::maxBegin,
+                                                   typename request_type::list_type>;
+        using buffer_type = typename reducer_type::value_type;
+
+        const typename request_type::list_type list(moments...);
+        const auto dead = bunch.getDeadMask();
+
+        buffer_type local;
+        using policy_type = Kokkos::RangePolicy<typename memory_space::execution_space>;
+        Kokkos::parallel_reduce(
+            "ippl::reduceMoments", policy_type(0, bunch.getLocalNum()),
+            KOKKOS_LAMBDA(const size_t i, buffer_type& val) {
+                if (detail::isDead(dead, i)) {
+                    return;
+                }
+                val.data[0] += 1;
+                list.accumulate(i, val.data);
+            },
+            reducer_type(local));
+
+        return request_type(list,
+                            std::vector<value_type>(local.data, local.data + request_type::size));
+    }
+
+    template <typename Bunch, typename... Moments>
+    std::tuple<typename Moments::result_type...> reduceMoments(const Bunch& bunch,
+                                                               const Moments&... moments) {
+        return reduceMomentsAsync(bunch, moments...).wait();
+    }
+}  // namespace ippl
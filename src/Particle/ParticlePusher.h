@@ -0,0 +1,182 @@
+//
+// Class ParticlePusher
+//   Time integration of charged particles in an electric field given on a
+//   mesh. The field is interpolated at the particle positions and the
+//   momenta (and optionally the positions) are updated in the same kernel,
+//   so the interpolated field never has to be stored in an attribute.
+//   The momentum update is provided by a push scheme:
+//     - Leapfrog: P += q/m * dt * E
+//     - Boris: the Boris rotation in an additional magnetic field
+//   Both schemes accept callbacks for external fields, which are evaluated
+//   at the particle position and time inside the kernel.
+//
+//   A kick-drift-kick step reads
+//     pusher.kickDrift(E, P, R, 0.5 * dt, dt, t);
+//     // update the layout, scatter and solve for E
+//     pusher.kick(E, P, R, 0.5 * dt, t + dt);
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_PARTICLE_PUSHER_H
+#define IPPL_PARTICLE_PUSHER_H
+
+#include <Kokkos_Core.hpp>
+
+#include "Types/IpplTypes.h"
+
+#include "Interpolation/ShapeFunctions.h"
+#include "Particle/ParticleAttribBase.h"
+
+namespace ippl {
+    /*!
+     * External field callback for a vanishing field
+     */
+    struct ZeroField {
+        template <typename VectorType>
+        KOKKOS_INLINE_FUNCTION VectorType operator()(const VectorType& /*R*/,
+                                                     double /*time*/) const {
+            return VectorType(0);
+        }
+    };
+
+    /*!
+     * Leapfrog momentum update in an electric field
+     * @tparam ExternalE callback returning the external electric field for a
+     * position and a time
+     */
+    template <typename ExternalE = ZeroField>
+    struct Leapfrog {
+        //! Charge-to-mass ratio of all particles
+        double chargeToMass = 1;
+
+        ExternalE externalE = ExternalE();
+
+        /*!
+         * Update the momentum of a single particle
+         * @param P the particle momentum (updated)
+         * @param E the interpolated field; the external field is added
+         * @param R the particle position
+         * @param time the time at which the field is evaluated
+         * @param dt the time step of the update
+         */
+        template <typename VectorType>
+        KOKKOS_INLINE_FUNCTION void kick(VectorType& P, VectorType& E, const VectorType& R,
+                                         double time, double dt) const;
+    };
+
+    /*!
+     * Boris momentum update in an electric and a magnetic field (3D only)
+     * @tparam ExternalE callback returning the external electric field for a
+     * position and a time
+     * @tparam ExternalB callback returning the magnetic field for a position and a time
+     */
+    template <typename ExternalE = ZeroField, typename ExternalB = ZeroField>
+    struct Boris {
+        //! Charge-to-mass ratio of all particles
+        double chargeToMass = 1;
+
+        ExternalE externalE = ExternalE();
+        ExternalB externalB = ExternalB();
+
+        /*!
+         * Update the momentum of a single particle: half an electric kick, the
+         * rotation in the magnetic field and another half electric kick
+         * @param P the particle momentum (updated)
+         * @param E the interpolated field; the external field is added
+         * @param R the particle position
+         * @param time the time at which the fields are evaluated
+         * @param dt the time step of the update
+         */
+        template <typename VectorType>
+        KOKKOS_INLINE_FUNCTION void kick(VectorType& P, VectorType& E, const VectorType& R,
+                                         double time, double dt) const;
+    };
+
+    /*!
+     * Fused field interpolation and particle push
+     * @tparam Scheme the push scheme, e.g. Leapfrog or Boris
+     * @tparam Shape the shape function for the field interpolation
+     */
+    template <typename Scheme, typename Shape = CIC>
+    class ParticlePusher {
+    public:
+        ParticlePusher(const Scheme& scheme = Scheme())
+            : scheme_m(scheme) {}
+
+        /*!
+         * Interpolate the field at the particle positions and update the momenta
+         * @param E the electric field on the mesh
+         * @param P the particle momenta
+         * @param R the particle positions
+         * @param dt the time step of the momentum update
+         * @param time the time at which the external fields are evaluated
+         */
+        template <typename Field, typename PAttrib, typename RAttrib>
+        void kick(Field& E, PAttrib& P, const RAttrib& R, double dt, double time = 0) const;
+
+        /*!
+         * Same as above, but additionally store the total field at the particle
+         * positions in an attribute
+         * @param Eout the attribute receiving the field
+         */
+        template <typename Field, typename PAttrib, typename RAttrib, typename EAttrib>
+        void kick(Field& E, PAttrib& P, const RAttrib& R, double dt, double time,
+                  EAttrib& Eout) const;
+
+        /*!
+         * Update the momenta and then the positions with the new momenta in one kernel
+         * @param E the electric field on the mesh
+         * @param P the particle momenta
+         * @param R the particle positions
+         * @param dtKick the time step of the momentum update
+         * @param dtDrift the time step of the position update
+         * @param time the time at which the external fields are evaluated
+         */
+        template <typename Field, typename PAttrib, typename RAttrib>
+        void kickDrift(Field& E, PAttrib& P, RAttrib& R, double dtKick, double dtDrift,
+                       double time = 0) const;
+
+        /*!
+         * Update the positions only
+         * @param P the particle momenta
+         * @param R the particle positions
+         * @param dt the time step
+         */
+        template <typename PAttrib, typename RAttrib>
+        void drift(const PAttrib& P, RAttrib& R, double dt) const;
+
+        const Scheme& getScheme() const { return scheme_m; }
+
+        Scheme& getScheme() { return scheme_m; }
+
+    private:
+        /*!
+         * The fused kernel behind kick and kickDrift
+         * @tparam Drift whether the positions are updated
+         * @tparam Store whether the field is written to Eout
+         * @param dead the particles to skip
+         */
+        template <bool Drift, bool Store, typename Field, typename PView, typename RView,
+                  typename EView, typename MaskView>
+        void push(Field& E, const PView& P, const RView& R, const EView& Eout,
+                  const MaskView& dead, detail::size_type n, double dtKick, double dtDrift,
+                  double time) const;
+
+        Scheme scheme_m;
+    };
+}  // namespace ippl
+
+#include "Particle/ParticlePusher.hpp"
+
+#endif
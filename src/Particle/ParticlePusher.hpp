@@ -0,0 +1,169 @@
+//
+// Class ParticlePusher
+//   Time integration of charged particles in an electric field given on a
+//   mesh.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Utility/IpplTimings.h"
+
+namespace ippl {
+    template <typename ExternalE>
+    template <typename VectorType>
+    KOKKOS_INLINE_FUNCTION void Leapfrog<ExternalE>::kick(VectorType& P, VectorType& E,
+                                                          const VectorType& R, double time,
+                                                          double dt) const {
+        E += externalE(R, time);
+        P += (chargeToMass * dt) * E;
+    }
+
+    template <typename ExternalE, typename ExternalB>
+    template <typename VectorType>
+    KOKKOS_INLINE_FUNCTION void Boris<ExternalE, ExternalB>::kick(VectorType& P, VectorType& E,
+                                                                  const VectorType& R,
+                                                                  double time, double dt) const {
+        static_assert(VectorType::dim == 3, "The Boris push requires three dimensions");
+        using value_type = typename VectorType::value_type;
+
+        E += externalE(R, time);
+
+        const value_type h = 0.5 * chargeToMass * dt;
+
+        // rotation vectors of the magnetic part
+        const VectorType t = h * externalB(R, time);
+        const VectorType s = (2 / (1 + dot(t, t).apply())) * t;
+
+        const VectorType minus = P + h * E;
+        const VectorType prime = minus + cross(minus, t);
+        P                      = minus + cross(prime, s) + h * E;
+    }
+
+    template <typename Scheme, typename Shape>
+    template <typename Field, typename PAttrib, typename RAttrib>
+    void ParticlePusher<Scheme, Shape>::kick(Field& E, PAttrib& P, const RAttrib& R, double dt,
+                                             double time) const {
+        push<false, false>(E, P.getView(), R.getView(), typename PAttrib::view_type(),
+                           P.getDeadMask(), P.getParticleCount(), dt, 0, time);
+    }
+
+    template <typename Scheme, typename Shape>
+    template <typename Field, typename PAttrib, typename RAttrib, typename EAttrib>
+    void ParticlePusher<Scheme, Shape>::kick(Field& E, PAttrib& P, const RAttrib& R, double dt,
+                                             double time, EAttrib& Eout) const {
+        push<false, true>(E, P.getView(), R.getView(), Eout.getView(), P.getDeadMask(),
+                          P.getParticleCount(), dt, 0, time);
+    }
+
+    template <typename Scheme, typename Shape>
+    template <typename Field, typename PAttrib, typename RAttrib>
+    void ParticlePusher<Scheme, Shape>::kickDrift(Field& E, PAttrib& P, RAttrib& R,
+                                                  double dtKick, double dtDrift,
+                                                  double time) const {
+        push<true, false>(E, P.getView(), R.getView(), typename PAttrib::view_type(),
+                          P.getDeadMask(), P.getParticleCount(), dtKick, dtDrift, time);
+    }
+
+    template <typename Scheme, typename Shape>
+    template <typename PAttrib, typename RAttrib>
+    void ParticlePusher<Scheme, Shape>::drift(const PAttrib& P, RAttrib& R, double dt) const {
+        static IpplTimings::TimerRef pushTimer = IpplTimings::getTimer("pushParticles");
+        IpplTimings::startTimer(pushTimer);
+
+        auto Pview      = P.getView();
+        auto Rview      = R.getView();
+        const auto dead = R.getDeadMask();
+
+        using policy_type = Kokkos::RangePolicy<typename RAttrib::execution_space>;
+        Kokkos::parallel_for(
+            "ParticlePusher::drift", policy_type(0, R.getParticleCount()),
+            KOKKOS_LAMBDA(const size_t i) {
+                if (!detail::isDead(dead, i)) {
+                    Rview(i) += dt * Pview(i);
+                }
+            });
+        Kokkos::fence();
+
+        IpplTimings::stopTimer(pushTimer);
+    }
+
+    template <typename Scheme, typename Shape>
+    template <bool Drift, bool Store, typename Field, typename PView, typename RView,
+              typename EView, typename MaskView>
+    void ParticlePusher<Scheme, Shape>::push(Field& E, const PView& P, const RView& R,
+                                             const EView& Eout, const MaskView& dead,
+                                             detail::size_type n, double dtKick, double dtDrift,
+                                             double time) const {
+        constexpr unsigned Dim = Field::dim;
+
+        static IpplTimings::TimerRef fillHaloTimer = IpplTimings::getTimer("fillHalo");
+        IpplTimings::startTimer(fillHaloTimer);
+        E.fillHalo();
+        IpplTimings::stopTimer(fillHaloTimer);
+
+        static IpplTimings::TimerRef pushTimer = IpplTimings::getTimer("pushParticles");
+        IpplTimings::startTimer(pushTimer);
+
+        const typename Field::view_type view = E.getView();
+
+        using mesh_type       = typename Field::Mesh_t;
+        const mesh_type& mesh = E.get_mesh();
+
+        using vector_type = typename mesh_type::vector_type;
+        using weight_type = typename mesh_type::value_type;
+
+        const vector_type& dx     = mesh.getMeshSpacing();
+        const vector_type& origin = mesh.getOrigin();
+        const vector_type invdx   = 1.0 / dx;
+
+        const FieldLayout<Dim>& layout = E.getLayout();
+        const NDIndex<Dim>& lDom       = layout.getLocalNDIndex();
+        const int nghost               = E.getNghost();
+        detail::checkShapeSupport<Shape>(E, "ParticlePusher::push");
+
+        detail::StencilMap<Shape, weight_type, Dim, vector_type> map{origin, invdx,
+                                                                     lDom.first() - nghost};
+
+        using particle_vector_type = typename PView::value_type;
+        using policy_type          = Kokkos::RangePolicy<typename PView::execution_space>;
+
+        const Scheme scheme = scheme_m;
+        Kokkos::parallel_for(
+            "ParticlePusher::push", policy_type(0, n), KOKKOS_LAMBDA(const size_t i) {
+                if (detail::isDead(dead, i)) {
+                    return;
+                }
+                // work on local copies, so that the attributes may be stored
+                // component-major and accessed through proxies
+                const particle_vector_type r = R(i);
+                particle_vector_type p       = P(i);
+
+                const auto stencil = map(r);
+
+                particle_vector_type field =
+                    detail::gatherFromField(detail::stencil_sequence<Shape, Dim>{}, view, stencil);
+                scheme.kick(p, field, r, time, dtKick);
+
+                P(i) = p;
+                if constexpr (Store) {
+                    Eout(i) = field;
+                }
+                if constexpr (Drift) {
+                    R(i) = r + dtDrift * p;
+                }
+            });
+        Kokkos::fence();
+
+        IpplTimings::stopTimer(pushTimer);
+    }
+}  // namespace ippl
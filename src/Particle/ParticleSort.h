@@ -0,0 +1,111 @@
+//
+// ParticleSort
+//   Cell keys and re-sort policy for ordering the particles of a bunch
+//   by the mesh cell that contains them. Particles that are close in
+//   memory then touch the same or neighbouring field entries during
+//   scatter and gather.
+//
+// Copyright (c) 2020, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_PARTICLE_SORT_H
+#define IPPL_PARTICLE_SORT_H
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+#include "Types/Vector.h"
+
+namespace ippl {
+    /*!
+     * Order in which the mesh cells are traversed when sorting particles
+     */
+    enum class SortOrder {
+        //! The memory order of the field views
+        Lexicographic,
+        //! The Morton (Z-order) curve; cells close in all dimensions stay close
+        Morton
+    };
+
+    /*!
+     * How the remaining particles are arranged when particles are destroyed
+     */
+    enum class CompactionOrder {
+        //! The holes are filled with the last valid particles; cheapest, but
+        //! the order of the particles is not preserved
+        FillFromEnd,
+        //! The valid particles keep their relative order, e.g. that of a sort
+        Stable
+    };
+
+    /*!
+     * Determines when a particle layout sorts the bunch at the end of an update.
+     * Both criteria can be combined; the bunch is sorted as soon as one of them
+     * is met.
+     */
+    struct ParticleSortPolicy {
+        SortOrder order = SortOrder::Lexicographic;
+
+        //! Sort after every interval-th update (0 disables the criterion)
+        unsigned interval = 0;
+
+        //! Sort when the fraction of consecutive particles whose cell keys are
+        //  out of order exceeds this value (values >= 1 disable the criterion)
+        double maxDisorder = 1.0;
+
+        bool enabled() const { return interval > 0 || maxDisorder < 1.0; }
+    };
+
+    namespace detail {
+        /*!
+         * Computes the sort key of a cell
+         * @tparam Layout the array layout of the field views; lexicographic keys
+         * follow the memory order of this layout
+         * @param cell the cell index relative to the local domain
+         * @param extent the number of local cells along each dimension
+         * @param order the cell ordering
+         * @return The key of the cell; Morton keys use min(64 / Dim, 32) bits of
+         * each index
+         */
+        template <typename Layout, unsigned Dim>
+        KOKKOS_INLINE_FUNCTION std::uint64_t cellKey(const Vector<int, Dim>& cell,
+                                                     const Vector<int, Dim>& extent,
+                                                     SortOrder order) {
+            std::uint64_t key = 0;
+            if (order == SortOrder::Morton) {
+                // interleave the low bits of the cell indices; indices of 2^bits and
+                // more share keys with smaller ones, which only affects the locality
+                // of the order, e.g. beyond 65536 local cells per dimension in 4D
+                constexpr unsigned bits = 64 / Dim < 32 ? 64 / Dim : 32;
+                for (unsigned b = 0; b < bits; ++b) {
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        key |= ((static_cast<std::uint64_t>(cell[d]) >> b) & 1) << (b * Dim + d);
+                    }
+                }
+            } else if constexpr (std::is_same_v<Layout, Kokkos::LayoutLeft>) {
+                for (int d = Dim - 1; d >= 0; --d) {
+                    key = key * extent[d] + cell[d];
+                }
+            } else {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    key = key * extent[d] + cell[d];
+                }
+            }
+            return key;
+        }
+    }  // namespace detail
+}  // namespace ippl
+
+#endif
@@ -19,6 +19,14 @@
 //   frequency of load balancing (N), or may supply a function to
 //   determine if load balancing should be done or not.
 //
+//   For short-range interactions, the layout provides read-only copies of
+//   the particles within a cutoff of the neighbouring regions (ghosts),
+//   including their periodic images. updateGhosts fills the ghost positions,
+//   exchangeGhosts copies further attributes to the ghosts and
+//   accumulateGhosts adds values computed for the ghosts, e.g. forces, back
+//   to the particles they were copied from. The communication schedule is
+//   kept as long as the particles stay on their ranks and within the skin.
+//
 // Copyright (c) 2020, Paul Scherrer Institut, Villigen PSI, Switzerland
 // All rights reserved
 //
@@ -35,6 +43,8 @@
 #ifndef IPPL_PARTICLE_SPATIAL_LAYOUT_H
 #define IPPL_PARTICLE_SPATIAL_LAYOUT_H
 
+#include <algorithm>
+
 #include "Types/IpplTypes.h"
 
 #include "FieldLayout/FieldLayout.h"
@@ -66,6 +76,15 @@ namespace ippl {
 
         using size_type = detail::size_type;
 
+        using position_view_type =
+            typename detail::ViewType<vector_type, 1, position_memory_space>::view_type;
+
+        //! Storage for the ghost copies of an attribute
+        template <class Attrib>
+        using ghost_view_type =
+            typename detail::ViewType<typename Attrib::value_type, 1,
+                                      position_memory_space>::view_type;
+
     public:
         // constructor: this one also takes a Mesh
         ParticleSpatialLayout(FieldLayout<Dim>&, Mesh&);
@@ -77,15 +96,238 @@ namespace ippl {
 
         void updateLayout(FieldLayout<Dim>&, Mesh&);
 
-        template <class BufferType>
-        void update(BufferType& pdata, BufferType& buffer);
+        /*!
+         * Move all particles to the ranks owning their positions. Outgoing
+         * particles are packed directly into the pooled communication buffers.
+         * @param pdata the particle bunch
+         */
+        template <class ParticleContainer>
+        void update(ParticleContainer& pdata);
+
+        /*!
+         * Start a particle update: apply the boundary conditions, post the receives,
+         * send all particles that left the local region and delete them locally.
+         * Until finishUpdate is called, the bunch only contains the particles that
+         * stay on this rank; work that does not depend on the incoming particles
+         * can be done in between, but particles must not be created or destroyed.
+         * @param pdata the particle bunch
+         */
+        template <class ParticleContainer>
+        void beginUpdate(ParticleContainer& pdata);
+
+        /*!
+         * Complete a particle update started with beginUpdate by appending the
+         * incoming particles as their messages arrive
+         * @param pdata the particle bunch
+         */
+        template <class ParticleContainer>
+        void finishUpdate(ParticleContainer& pdata);
 
         const RegionLayout_t& getRegionLayout() const { return rlayout_m; }
 
+        /*!
+         * Set the policy deciding when the particles are sorted by mesh cell
+         * at the end of an update. The cells are given by the field layout and
+         * mesh of this layout.
+         * @param policy the sort policy
+         */
+        void setSortPolicy(const ParticleSortPolicy& policy) {
+            sortPolicy_m       = policy;
+            updatesSinceSort_m = 0;
+        }
+
+        const ParticleSortPolicy& getSortPolicy() const { return sortPolicy_m; }
+
+        /*!
+         * Bound the distance any particle moves between two updates, e.g. by a CFL
+         * condition. With a bound, an update only locates the particles that left
+         * the local region and only tests them against the regions within the bound,
+         * and the send counts are only exchanged with the ranks owning these regions.
+         * The bound must be the same on all ranks.
+         *
+         * A particle that moved further cannot be sent, since its owner is not a
+         * neighbor and does not expect a message. It stays on its rank until the next
+         * check: every checkInterval-th update, the ranks agree with one
+         * MPI_Allreduce of an int on whether the bound was exceeded since the last
+         * check, and if so that update locates all particles on all ranks. A small
+         * interval costs a global reduction on that many updates; a large one leaves
+         * such particles outside the local region for longer.
+         * @param bound the largest displacement of any particle coordinate since the
+         * last update; a negative value disables the bound
+         * @param checkInterval the number of updates between two checks of the bound
+         */
+        void setDisplacementBound(T bound, unsigned checkInterval = 16) {
+            displacementBound_m = bound;
+            checkInterval_m     = std::max(checkInterval, 1u);
+            boundedUpdates_m    = 0;
+            boundExceeded_m     = false;
+        }
+
+        T getDisplacementBound() const { return displacementBound_m; }
+
+        /*!
+         * @returns the number of particles located against other regions since the
+         * counters were last reset
+         */
+        size_type getTestedCount() const { return testedCount_m; }
+
+        /*!
+         * @returns the number of particles kept without locating them since the
+         * counters were last reset
+         */
+        size_type getSkippedCount() const { return skippedCount_m; }
+
+        void resetLocateCounters() {
+            testedCount_m  = 0;
+            skippedCount_m = 0;
+        }
+
+        /*!
+         * Copy the positions of all particles within the cutoff of another region,
+         * or of a periodic image of any region, to the ranks owning these regions.
+         * The positions of periodic images are shifted by the domain length.
+         * The schedule is only rebuilt if the particles changed ranks, were sorted
+         * or moved further than the skin since it was built; particles within
+         * cutoff + skin are exchanged. Moving further than the skin is detected
+         * with the displacement bound; without one, every update rebuilds it.
+         * @param pdata the particle bunch
+         * @param cutoff the interaction range
+         * @param skin additional range that allows reusing the schedule
+         */
+        template <class ParticleContainer>
+        void updateGhosts(const ParticleContainer& pdata, T cutoff, T skin = 0);
+
+        /*!
+         * @returns the number of ghost particles received by the last updateGhosts
+         */
+        size_type getGhostNum() const { return ghostRecvOffsets_m.back(); }
+
+        /*!
+         * @returns the positions of the ghost particles, shifted for periodic images
+         */
+        const position_view_type& getGhostPositions() const { return ghostR_m; }
+
+        /*!
+         * Copy an attribute to the ghost particles with the schedule of the
+         * last updateGhosts
+         * @param attrib the attribute of the local particles
+         * @param ghosts the attribute values of the ghosts (output); resized to the
+         * number of ghosts
+         */
+        template <class Attrib>
+        void exchangeGhosts(const Attrib& attrib, ghost_view_type<Attrib>& ghosts) const;
+
+        /*!
+         * Add values computed for the ghost particles to the particles they are
+         * copies of, the reverse of exchangeGhosts
+         * @param attrib the attribute of the local particles (updated)
+         * @param ghosts the values of the ghosts
+         */
+        template <class Attrib>
+        void accumulateGhosts(Attrib& attrib, const ghost_view_type<Attrib>& ghosts) const;
+
+        /*!
+         * Force the ghost schedule to be rebuilt, e.g. after particles were
+         * created or moved outside of an update
+         */
+        void invalidateGhosts() { ghostsValid_m = false; }
+
+        //! @returns how often the ghost schedule has been built
+        unsigned getGhostScheduleBuilds() const { return ghostBuilds_m; }
+
     protected:
         //! The RegionLayout which determines where our particles go.
         RegionLayout_t rlayout_m;
 
+        //! The field layout and mesh defining the cells for sorting
+        FieldLayout<Dim>* flayout_mp = nullptr;
+        Mesh* mesh_mp                = nullptr;
+
+        ParticleSortPolicy sortPolicy_m;
+
+        //! Number of updates since the particles were last sorted
+        unsigned updatesSinceSort_m = 0;
+
+        //! Pending send and receive requests between beginUpdate and finishUpdate
+        std::vector<MPI_Request> sendRequests_m;
+        std::vector<MPI_Request> recvRequests_m;
+
+        //! Number of particles and outstanding messages per posted receive
+        std::vector<size_type> recvCounts_m;
+        std::vector<int> recvMessages_m;
+
+        //! Index of the receive each receive request belongs to
+        std::vector<int> requestOwner_m;
+
+        bool updatePending_m = false;
+
+        //! Largest particle displacement between two updates; negative if unknown
+        T displacementBound_m = -1;
+
+        //! Updates between two global checks of the bound, the updates since it was
+        //! set and whether a particle moved further since the last check
+        unsigned checkInterval_m  = 16;
+        unsigned boundedUpdates_m = 0;
+        bool boundExceeded_m      = false;
+
+        //! Particles located against other regions and particles kept without it
+        size_type testedCount_m  = 0;
+        size_type skippedCount_m = 0;
+
+        //! Ghost schedule: the range it was built for and whether it is still valid
+        T ghostCutoff_m           = -1;
+        T ghostSkin_m             = 0;
+        T ghostDrift_m            = 0;
+        bool ghostsValid_m        = false;
+        unsigned ghostBuilds_m    = 0;
+        size_type ghostLocalNum_m = 0;
+
+        //! The local particle and the periodic image of every outgoing ghost,
+        //! grouped by image and the images grouped by destination rank
+        hash_type ghostSendIndex_m;
+        locate_type ghostSendImage_m;
+        std::vector<size_type> ghostImageOffsets_m;
+
+        //! Shift of each image and positions of the particles at build time,
+        //! which identify the particles wrapped by periodic boundaries since
+        position_view_type ghostShifts_m;
+        position_view_type ghostOrigins_m;
+        vector_type ghostPeriods_m;
+
+        //! Start of the outgoing and incoming ghosts of each rank
+        std::vector<size_type> ghostSendOffsets_m;
+        std::vector<size_type> ghostRecvOffsets_m = {0};
+
+        position_view_type ghostR_m;
+
+        /*!
+         * Determine the outgoing ghosts and exchange their numbers
+         * @param pdata the particle bunch
+         * @param range the distance within which particles become ghosts
+         */
+        template <class ParticleContainer>
+        void buildGhostSchedule(const ParticleContainer& pdata, T range);
+
+        /*!
+         * Exchange slices of two buffers with all ranks of the ghost schedule
+         * @param send the outgoing values
+         * @param sendOffsets the start of the values for each rank
+         * @param recv the incoming values (output)
+         * @param recvOffsets the start of the values from each rank
+         * @param tag the message tag
+         */
+        template <class ViewType>
+        void exchangeGhostBuffers(const ViewType& send, const std::vector<size_type>& sendOffsets,
+                                  const ViewType& recv, const std::vector<size_type>& recvOffsets,
+                                  int tag) const;
+
+        /*!
+         * Sort the particles if the sort policy requires it
+         * @param pdata the particle bunch
+         */
+        template <class ParticleContainer>
+        void sortIfNeeded(ParticleContainer& pdata);
+
         using region_type = typename RegionLayout_t::view_type::value_type;
 
         template <size_t... Idx>
@@ -108,17 +350,70 @@ namespace ippl {
                                   bool_type& invalid) const;
 
         /*!
-         * @param rank we sent to
-         * @param ranks a container specifying where a particle at the i-th index should go.
-         * @param hash a mapping to fill the send buffer contiguously
+         * Determines the ranks whose regions are within the given distance of the
+         * local region, including their periodic images
+         * @param bound the largest displacement of any particle coordinate
+         * @return The neighboring ranks, excluding this rank
+         */
+        std::vector<int> findNeighbors(T bound) const;
+
+        /*!
+         * Like locateParticles, but only the particles outside the local region
+         * are located and only against the regions of the given neighbors
+         * @tparam ParticleBunch the bunch type
+         * @param pdata the particle bunch
+         * @param ranks the integer view in which to store the destination ranks
+         * @param invalid the boolean view in which to store whether each particle
+         * needs to be sent to another rank
+         * @param neighbors the ranks the particles may have moved to
+         * @param invalidCount the total number of invalidated particles (output)
+         * @return False on all ranks if this update checks the bound and any rank has
+         * had a particle that moved further since the last check, in which case the
+         * particles must be located with locateParticles
          */
-        void fillHash(int rank, const locate_type& ranks, hash_type& hash);
+        template <typename ParticleBunch>
+        bool locateNearbyParticles(const ParticleBunch& pdata, locate_type& ranks,
+                                   bool_type& invalid, const std::vector<int>& neighbors,
+                                   size_type& invalidCount);
 
         /*!
-         * @param rank we sent to
+         * Sorts the invalidated particles by destination rank. The sort is
+         * stable: within a bucket the particles keep their index order, so the
+         * messages do not depend on the thread scheduling
          * @param ranks a container specifying where a particle at the i-th index should go.
+         * @param invalid a container specifying whether a particle leaves this rank
+         * @param nSends the number of particles going to each rank (output)
+         * @param offsets the start of each rank's particles in the returned view (output);
+         * must hold one element more than the number of ranks
+         * @return The indices of all outgoing particles, grouped by destination rank
+         */
+        hash_type bucketParticles(const locate_type& ranks, const bool_type& invalid,
+                                  std::vector<size_type>& nSends,
+                                  std::vector<size_type>& offsets) const;
+
+        /*!
+         * Determines how many particles this rank receives from every other rank
+         * with the non-blocking consensus (NBX) protocol. Only ranks that actually
+         * exchange particles communicate; completion is detected with a
+         * non-blocking barrier instead of a global window and fences.
+         * @param nSends the number of particles going to each rank
+         * @param nRecvs the number of particles coming from each rank (output);
+         * must be zero-initialized
+         */
+        void exchangeSendCounts(const std::vector<size_type>& nSends,
+                                std::vector<size_type>& nRecvs);
+
+        /*!
+         * Exchanges the send counts with the given neighbors only. Since particles
+         * can only move between neighbors, no other rank is involved.
+         * @param nSends the number of particles going to each rank
+         * @param nRecvs the number of particles coming from each rank (output);
+         * must be zero-initialized
+         * @param neighbors the neighboring ranks; the relation must be symmetric
          */
-        size_t numberOfSends(int rank, const locate_type& ranks);
+        void exchangeNeighborCounts(const std::vector<size_type>& nSends,
+                                    std::vector<size_type>& nRecvs,
+                                    const std::vector<int>& neighbors);
     };
 }  // namespace ippl
 
@@ -32,6 +32,7 @@
 // You should have received a copy of the GNU General Public License
 // along with IPPL. If not, see <https://www.gnu.org/licenses/>.
 //
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <vector>
@@ -43,18 +44,41 @@ namespace ippl {
     template <typename T, unsigned Dim, class Mesh, typename... Properties>
     ParticleSpatialLayout<T, Dim, Mesh, Properties...>::ParticleSpatialLayout(FieldLayout<Dim>& fl,
                                                                               Mesh& mesh)
-        : rlayout_m(fl, mesh) {}
+        : rlayout_m(fl, mesh)
+        , flayout_mp(&fl)
+        , mesh_mp(&mesh) {}
 
     template <typename T, unsigned Dim, class Mesh, typename... Properties>
     void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::updateLayout(FieldLayout<Dim>& fl,
                                                                           Mesh& mesh) {
         rlayout_m.changeDomain(fl, mesh);
+        flayout_mp = &fl;
+        mesh_mp    = &mesh;
     }
 
     template <typename T, unsigned Dim, class Mesh, typename... Properties>
-    template <class BufferType>
-    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::update(BufferType& pdata,
-                                                                    BufferType& buffer) {
+    template <class ParticleContainer>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::update(ParticleContainer& pdata) {
+        beginUpdate(pdata);
+        finishUpdate(pdata);
+    }
+
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    template <class ParticleContainer>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::beginUpdate(
+        ParticleContainer& pdata) {
+        if (updatePending_m) {
+            throw IpplException("ParticleSpatialLayout::beginUpdate",
+                                "The previous particle update has not been finished.");
+        }
+
+        // the ghost schedule stays valid while the particles are within its skin
+        if (displacementBound_m >= 0) {
+            ghostDrift_m += displacementBound_m;
+        } else {
+            ghostsValid_m = false;
+        }
+
         static IpplTimings::TimerRef ParticleBCTimer = IpplTimings::getTimer("particleBC");
         IpplTimings::startTimer(ParticleBCTimer);
         this->applyBC(pdata.R, rlayout_m.getDomain());
@@ -65,14 +89,15 @@ namespace ippl {
         int nRanks = Comm->size();
 
         if (nRanks < 2) {
+            IpplTimings::stopTimer(ParticleUpdateTimer);
             return;
         }
 
         /* particle MPI exchange:
          *   1. figure out which particles need to go where
-         *   2. fill send buffer and send particles
+         *   2. post receives, fill send buffers and send particles
          *   3. delete invalidated particles
-         *   4. receive particles
+         *   4. unpack received particles as they arrive (finishUpdate)
          */
 
         static IpplTimings::TimerRef locateTimer = IpplTimings::getTimer("locateParticles");
@@ -91,50 +116,77 @@ namespace ippl {
          */
         bool_type invalid("invalid", localnum);
 
-        size_type invalidCount = locateParticles(pdata, ranks, invalid);
+        // with a displacement bound, particles can only move to nearby regions;
+        // if any particle moved further, all ranks locate every particle at the
+        // next check of the bound
+        std::vector<int> neighbors;
+        bool bounded = displacementBound_m >= 0;
+        size_type invalidCount;
+        if (bounded) {
+            neighbors = findNeighbors(displacementBound_m);
+            bounded   = locateNearbyParticles(pdata, ranks, invalid, neighbors, invalidCount);
+        }
+        if (!bounded) {
+            invalidCount = locateParticles(pdata, ranks, invalid);
+            testedCount_m += localnum;
+        }
         IpplTimings::stopTimer(locateTimer);
 
+        if (invalidCount > 0) {
+            ghostsValid_m = false;
+        }
+
         // 2nd step
 
-        // figure out how many receives
+        // bucket the outgoing particles by destination rank
         static IpplTimings::TimerRef preprocTimer = IpplTimings::getTimer("sendPreprocess");
         IpplTimings::startTimer(preprocTimer);
-        MPI_Win win;
-        std::vector<size_type> nRecvs(nRanks, 0);
-        MPI_Win_create(nRecvs.data(), nRanks * sizeof(size_type), sizeof(size_type), MPI_INFO_NULL,
-                       Comm->getCommunicator(), &win);
+        std::vector<size_type> nSends(nRanks, 0), offsets(nRanks + 1, 0);
+        hash_type sendIndex = bucketParticles(ranks, invalid, nSends, offsets);
 
-        std::vector<size_type> nSends(nRanks, 0);
+        // figure out how many receives
+        std::vector<size_type> nRecvs(nRanks, 0);
+        if (bounded) {
+            exchangeNeighborCounts(nSends, nRecvs, neighbors);
+        } else {
+            exchangeSendCounts(nSends, nRecvs);
+        }
+        IpplTimings::stopTimer(preprocTimer);
 
-        MPI_Win_fence(0, win);
+        int tag = Comm->next_tag(P_SPATIAL_LAYOUT_TAG, P_LAYOUT_CYCLE);
 
+        // post all receives up front so that messages can land while we are
+        // still packing and deleting particles
+        static IpplTimings::TimerRef recvTimer = IpplTimings::getTimer("particleRecv");
+        IpplTimings::startTimer(recvTimer);
+        recvRequests_m.clear();
+        recvCounts_m.clear();
+        recvMessages_m.clear();
+        requestOwner_m.clear();
         for (int rank = 0; rank < nRanks; ++rank) {
-            if (rank == Comm->rank()) {
-                // we do not need to send to ourselves
-                continue;
+            if (nRecvs[rank] > 0) {
+                int recvNum   = recvCounts_m.size();
+                int nMessages = pdata.irecvFromRank(rank, tag, recvNum, nRecvs[rank],
+                                                    recvRequests_m);
+                recvCounts_m.push_back(nRecvs[rank]);
+                recvMessages_m.push_back(nMessages);
+                requestOwner_m.insert(requestOwner_m.end(), nMessages, recvNum);
             }
-            nSends[rank] = numberOfSends(rank, ranks);
-            MPI_Put(nSends.data() + rank, 1, MPI_LONG_LONG_INT, rank, Comm->rank(), 1,
-                    MPI_LONG_LONG_INT, win);
         }
-        MPI_Win_fence(0, win);
-        MPI_Win_free(&win);
-        IpplTimings::stopTimer(preprocTimer);
+        IpplTimings::stopTimer(recvTimer);
 
         static IpplTimings::TimerRef sendTimer = IpplTimings::getTimer("particleSend");
         IpplTimings::startTimer(sendTimer);
         // send
-        std::vector<MPI_Request> requests(0);
-
-        int tag = Comm->next_tag(P_SPATIAL_LAYOUT_TAG, P_LAYOUT_CYCLE);
+        sendRequests_m.clear();
 
         int sends = 0;
         for (int rank = 0; rank < nRanks; ++rank) {
             if (nSends[rank] > 0) {
-                hash_type hash("hash", nSends[rank]);
-                fillHash(rank, ranks, hash);
+                // the particles for each rank form a contiguous slice of the permutation
+                hash_type hash(sendIndex.data() + offsets[rank], nSends[rank]);
 
-                pdata.sendToRank(rank, tag, sends++, requests, hash, buffer);
+                pdata.sendToRank(rank, tag, sends++, sendRequests_m, hash);
             }
         }
         IpplTimings::stopTimer(sendTimer);
@@ -147,25 +199,73 @@ namespace ippl {
         Kokkos::fence();
 
         IpplTimings::stopTimer(destroyTimer);
+
+        updatePending_m = true;
+        IpplTimings::stopTimer(ParticleUpdateTimer);
+    }
+
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    template <class ParticleContainer>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::finishUpdate(
+        ParticleContainer& pdata) {
+        if (!updatePending_m) {
+            sortIfNeeded(pdata);
+            return;
+        }
+
+        static IpplTimings::TimerRef ParticleUpdateTimer = IpplTimings::getTimer("updateParticle");
+        IpplTimings::startTimer(ParticleUpdateTimer);
+
         static IpplTimings::TimerRef recvTimer = IpplTimings::getTimer("particleRecv");
         IpplTimings::startTimer(recvTimer);
         // 4th step
-        int recvs = 0;
-        for (int rank = 0; rank < nRanks; ++rank) {
-            if (nRecvs[rank] > 0) {
-                pdata.recvFromRank(rank, tag, recvs++, nRecvs[rank], buffer);
+
+        // unpack the particles from each rank as soon as all of their messages are in
+        for (size_t i = 0; i < recvRequests_m.size(); ++i) {
+            int index;
+            MPI_Waitany(recvRequests_m.size(), recvRequests_m.data(), &index, MPI_STATUS_IGNORE);
+
+            int recvNum = requestOwner_m[index];
+            if (--recvMessages_m[recvNum] == 0) {
+                pdata.unpackFromRank(recvNum, recvCounts_m[recvNum]);
             }
         }
         IpplTimings::stopTimer(recvTimer);
 
+        static IpplTimings::TimerRef sendTimer = IpplTimings::getTimer("particleSend");
         IpplTimings::startTimer(sendTimer);
 
-        if (requests.size() > 0) {
-            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        if (sendRequests_m.size() > 0) {
+            MPI_Waitall(sendRequests_m.size(), sendRequests_m.data(), MPI_STATUSES_IGNORE);
         }
         IpplTimings::stopTimer(sendTimer);
 
+        updatePending_m = false;
         IpplTimings::stopTimer(ParticleUpdateTimer);
+
+        sortIfNeeded(pdata);
+    }
+
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    template <class ParticleContainer>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::sortIfNeeded(
+        ParticleContainer& pdata) {
+        if (!sortPolicy_m.enabled() || mesh_mp == nullptr) {
+            return;
+        }
+
+        ++updatesSinceSort_m;
+        bool sort = sortPolicy_m.interval > 0 && updatesSinceSort_m >= sortPolicy_m.interval;
+        if (!sort && sortPolicy_m.maxDisorder < 1.0) {
+            sort = pdata.sortDisorder(*mesh_mp, *flayout_mp, sortPolicy_m.order)
+                   > sortPolicy_m.maxDisorder;
+        }
+
+        if (sort) {
+            pdata.sort(*mesh_mp, *flayout_mp, sortPolicy_m.order);
+            updatesSinceSort_m = 0;
+            ghostsValid_m      = false;
+        }
     }
 
     template <typename T, unsigned Dim, class Mesh, typename... Properties>
@@ -180,22 +280,45 @@ namespace ippl {
     template <typename ParticleBunch>
     detail::size_type ParticleSpatialLayout<T, Dim, Mesh, Properties...>::locateParticles(
         const ParticleBunch& pdata, locate_type& ranks, bool_type& invalid) const {
-        auto& positions                            = pdata.R.getView();
-        typename RegionLayout_t::view_type Regions = rlayout_m.getdLocalRegions();
+        auto& positions = pdata.R.getView();
 
-        using mdrange_type = Kokkos::MDRangePolicy<Kokkos::Rank<2>, position_execution_space>;
+        // dead particles stay where they are until the bunch is compacted
+        const auto dead = pdata.R.getDeadMask();
 
         int myRank = Comm->rank();
 
+        size_type invalidCount = 0;
+        if (rlayout_m.hasPartitionTree()) {
+            // descend the tree of cut planes, O(log P) per particle
+            auto locator = rlayout_m.getLocator();
+
+            using range_type = Kokkos::RangePolicy<position_execution_space>;
+            Kokkos::parallel_reduce(
+                "ParticleSpatialLayout::locateParticles()", range_type(0, ranks.extent(0)),
+                KOKKOS_LAMBDA(const size_t i, size_type& count) {
+                    ranks(i)   = detail::isDead(dead, i) ? myRank : locator(positions(i));
+                    invalid(i) = (myRank != ranks(i));
+                    count += invalid(i);
+                },
+                Kokkos::Sum<size_type>(invalidCount));
+            Kokkos::fence();
+
+            return invalidCount;
+        }
+
+        // fall back to testing every region if they cannot be separated by cut planes
+        typename RegionLayout_t::view_type Regions = rlayout_m.getdLocalRegions();
+
+        using mdrange_type = Kokkos::MDRangePolicy<Kokkos::Rank<2>, position_execution_space>;
+
         const auto is = std::make_index_sequence<Dim>{};
 
-        size_type invalidCount = 0;
         Kokkos::parallel_reduce(
             "ParticleSpatialLayout::locateParticles()",
             mdrange_type({0, 0}, {ranks.extent(0), Regions.extent(0)}),
             KOKKOS_LAMBDA(const size_t i, const size_type j, size_type& count) {
                 bool xyz_bool = positionInRegion(is, positions(i), Regions(j));
-                if (xyz_bool) {
+                if (xyz_bool && !detail::isDead(dead, i)) {
                     ranks(i)   = j;
                     invalid(i) = (myRank != ranks(i));
                     count += invalid(i);
@@ -208,38 +331,543 @@ namespace ippl {
     }
 
     template <typename T, unsigned Dim, class Mesh, typename... Properties>
-    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::fillHash(int rank,
-                                                                      const locate_type& ranks,
-                                                                      hash_type& hash) {
-        /* Compute the prefix sum and fill the hash
-         */
+    std::vector<int> ParticleSpatialLayout<T, Dim, Mesh, Properties...>::findNeighbors(
+        T bound) const {
+        auto regions     = rlayout_m.gethLocalRegions();
+        const auto& bcs  = this->getParticleBC();
+        const auto& dom  = rlayout_m.getDomain();
+        const int myRank = Comm->rank();
+
+        // distance between two intervals, zero if they overlap or touch
+        auto gap = [](const auto& a, T min, T max) {
+            return std::max(T(0), std::max(min - a.max(), a.min() - max));
+        };
+
+        std::vector<int> neighbors;
+        for (int rank = 0; rank < (int)regions.extent(0); ++rank) {
+            if (rank == myRank) {
+                continue;
+            }
+
+            bool near = true;
+            for (unsigned d = 0; d < Dim && near; ++d) {
+                const auto& a = regions(myRank)[d];
+                const auto& b = regions(rank)[d];
+                T dist        = gap(a, b.min(), b.max());
+                if (bcs[2 * d] == BC::PERIODIC) {
+                    const T length = dom[d].length();
+                    dist           = std::min({dist, gap(a, b.min() - length, b.max() - length),
+                                               gap(a, b.min() + length, b.max() + length)});
+                }
+                near = dist <= bound;
+            }
+
+            if (near) {
+                neighbors.push_back(rank);
+            }
+        }
+        return neighbors;
+    }
+
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    template <typename ParticleBunch>
+    bool ParticleSpatialLayout<T, Dim, Mesh, Properties...>::locateNearbyParticles(
+        const ParticleBunch& pdata, locate_type& ranks, bool_type& invalid,
+        const std::vector<int>& neighbors, size_type& invalidCount) {
+        auto& positions = pdata.R.getView();
+        const auto dead = pdata.R.getDeadMask();
+
+        const int myRank = Comm->rank();
+
+        typename RegionLayout_t::view_type Regions = rlayout_m.getdLocalRegions();
+        const region_type local                    = rlayout_m.gethLocalRegions()(myRank);
+        const region_type domain                   = rlayout_m.getDomain();
+
+        locate_type dNeighbors("neighbors", neighbors.size());
+        Kokkos::deep_copy(dNeighbors, Kokkos::View<const int*, Kokkos::HostSpace>(
+                                          neighbors.data(), neighbors.size()));
+
+        const auto is = std::make_index_sequence<Dim>{};
+
+        // the particles inside the local region stay where they are; only the
+        // particles in the shell around it are tested against the neighbors
+        size_type tested = 0, sent = 0, lost = 0;
+        using range_type = Kokkos::RangePolicy<position_execution_space>;
+        Kokkos::parallel_reduce(
+            "ParticleSpatialLayout::locateNearbyParticles()", range_type(0, ranks.extent(0)),
+            KOKKOS_LAMBDA(const size_t i, size_type& nTested, size_type& nSent,
+                          size_type& nLost) {
+                ranks(i)   = myRank;
+                invalid(i) = false;
+                if (detail::isDead(dead, i) || positionInRegion(is, positions(i), local)) {
+                    return;
+                }
+
+                nTested += 1;
+                int rank = -1;
+                for (size_t j = 0; j < dNeighbors.extent(0) && rank < 0; ++j) {
+                    if (positionInRegion(is, positions(i), Regions(dNeighbors(j)))) {
+                        rank = dNeighbors(j);
+                    }
+                }
+
+                if (rank < 0) {
+                    // like locateParticles, keep the particles that left the domain
+                    nLost += positionInRegion(is, positions(i), domain);
+                    return;
+                }
+                ranks(i)   = rank;
+                invalid(i) = true;
+                nSent += 1;
+            },
+            Kokkos::Sum<size_type>(tested), Kokkos::Sum<size_type>(sent),
+            Kokkos::Sum<size_type>(lost));
+        Kokkos::fence();
+
+        // the particles that moved further than the bound stay on this rank; only
+        // every checkInterval_m-th update do all ranks agree to locate them
+        boundExceeded_m = boundExceeded_m || lost > 0;
+        if (++boundedUpdates_m % checkInterval_m == 0) {
+            int exceeded    = boundExceeded_m;
+            boundExceeded_m = false;
+            MPI_Allreduce(MPI_IN_PLACE, &exceeded, 1, MPI_INT, MPI_LOR, Comm->getCommunicator());
+            if (exceeded) {
+                return false;
+            }
+        }
+
+        testedCount_m += tested;
+        skippedCount_m += ranks.extent(0) - tested;
+
+        invalidCount = sent;
+        return true;
+    }
+
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::exchangeNeighborCounts(
+        const std::vector<size_type>& nSends, std::vector<size_type>& nRecvs,
+        const std::vector<int>& neighbors) {
+        const MPI_Comm& comm = Comm->getCommunicator();
+        int tag              = Comm->next_tag(P_SPATIAL_COUNT_TAG, P_LAYOUT_CYCLE);
+
+        std::vector<MPI_Request> requests(2 * neighbors.size());
+        for (size_t n = 0; n < neighbors.size(); ++n) {
+            MPI_Irecv(nRecvs.data() + neighbors[n], 1, MPI_LONG_LONG_INT, neighbors[n], tag,
+                      comm, &requests[n]);
+        }
+        for (size_t n = 0; n < neighbors.size(); ++n) {
+            MPI_Isend(nSends.data() + neighbors[n], 1, MPI_LONG_LONG_INT, neighbors[n], tag,
+                      comm, &requests[neighbors.size() + n]);
+        }
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::exchangeSendCounts(
+        const std::vector<size_type>& nSends, std::vector<size_type>& nRecvs) {
+        const MPI_Comm& comm = Comm->getCommunicator();
+        int tag              = Comm->next_tag(P_SPATIAL_COUNT_TAG, P_LAYOUT_CYCLE);
+
+        // synchronous sends only complete once the matching receive has started,
+        // so completing all of them means our counts have been picked up
+        std::vector<MPI_Request> requests;
+        requests.reserve(nSends.size());
+        for (size_t rank = 0; rank < nSends.size(); ++rank) {
+            if (nSends[rank] > 0) {
+                requests.emplace_back();
+                MPI_Issend(nSends.data() + rank, 1, MPI_LONG_LONG_INT, rank, tag, comm,
+                           &requests.back());
+            }
+        }
+
+        // receive counts from whoever sends them until every rank has
+        // delivered all of its counts, which is signalled by the barrier
+        MPI_Request barrier = MPI_REQUEST_NULL;
+        bool barrierActive  = false;
+        bool done           = false;
+        while (!done) {
+            int flag;
+            MPI_Status status;
+            MPI_Iprobe(MPI_ANY_SOURCE, tag, comm, &flag, &status);
+            if (flag) {
+                MPI_Recv(nRecvs.data() + status.MPI_SOURCE, 1, MPI_LONG_LONG_INT,
+                         status.MPI_SOURCE, tag, comm, MPI_STATUS_IGNORE);
+            }
+
+            if (barrierActive) {
+                MPI_Test(&barrier, &flag, MPI_STATUS_IGNORE);
+                done = flag;
+            } else {
+                MPI_Testall(requests.size(), requests.data(), &flag, MPI_STATUSES_IGNORE);
+                if (flag) {
+                    MPI_Ibarrier(comm, &barrier);
+                    barrierActive = true;
+                }
+            }
+        }
+    }
+
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    typename ParticleSpatialLayout<T, Dim, Mesh, Properties...>::hash_type
+    ParticleSpatialLayout<T, Dim, Mesh, Properties...>::bucketParticles(
+        const locate_type& ranks, const bool_type& invalid, std::vector<size_type>& nSends,
+        std::vector<size_type>& offsets) const {
         using policy_type = Kokkos::RangePolicy<position_execution_space>;
+
+        const int nRanks = nSends.size();
+
+        // count the particles per destination
+        locate_type counts("particles per rank", nRanks);
+        Kokkos::parallel_for(
+            "ParticleSpatialLayout::bucketParticles()::count", policy_type(0, ranks.extent(0)),
+            KOKKOS_LAMBDA(const size_t i) {
+                if (invalid(i)) {
+                    Kokkos::atomic_increment(&counts(ranks(i)));
+                }
+            });
+        Kokkos::fence();
+
+        // the exclusive prefix sum of the counts gives the start of each bucket;
+        // the non-empty buckets are numbered in rank order
+        auto counts_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), counts);
+        offsets[0]       = 0;
+        int nBuckets     = 0;
+        for (int rank = 0; rank < nRanks; ++rank) {
+            nSends[rank]      = counts_host(rank);
+            offsets[rank + 1] = offsets[rank] + nSends[rank];
+            counts_host(rank) = nSends[rank] > 0 ? nBuckets++ : -1;
+        }
+
+        hash_type sendIndex("send permutation", offsets[nRanks]);
+        if (nBuckets == 0) {
+            return sendIndex;
+        }
+        const locate_type bucket = counts;
+        Kokkos::deep_copy(bucket, counts_host);
+
+        // stable counting sort: each chunk of particles is counted and placed
+        // by a single thread, so the particles of a bucket keep their index order
+        constexpr size_type chunkSize = 256;
+        const size_type nLocal        = ranks.extent(0);
+        const size_type nChunks       = (nLocal + chunkSize - 1) / chunkSize;
+
+        Kokkos::View<size_type**, position_memory_space> slots("bucket slots per chunk", nBuckets,
+                                                               nChunks);
+        Kokkos::parallel_for(
+            "ParticleSpatialLayout::bucketParticles()::chunkCount", policy_type(0, nChunks),
+            KOKKOS_LAMBDA(const size_t c) {
+                const size_type end = Kokkos::min((c + 1) * chunkSize, nLocal);
+                for (size_type i = c * chunkSize; i < end; ++i) {
+                    if (invalid(i)) {
+                        ++slots(bucket(ranks(i)), c);
+                    }
+                }
+            });
+
+        // scanning the counts bucket by bucket, chunk by chunk gives the first
+        // slot of every chunk in the send permutation
         Kokkos::parallel_scan(
-            "ParticleSpatialLayout::fillHash()", policy_type(0, ranks.extent(0)),
-            KOKKOS_LAMBDA(const size_t i, int& idx, const bool final) {
+            "ParticleSpatialLayout::bucketParticles()::scan", policy_type(0, nBuckets * nChunks),
+            KOKKOS_LAMBDA(const size_t k, size_type& start, const bool final) {
+                const size_type count = slots(k / nChunks, k % nChunks);
                 if (final) {
-                    if (rank == ranks(i)) {
-                        hash(idx) = i;
+                    slots(k / nChunks, k % nChunks) = start;
+                }
+                start += count;
+            });
+
+        Kokkos::parallel_for(
+            "ParticleSpatialLayout::bucketParticles()::fill", policy_type(0, nChunks),
+            KOKKOS_LAMBDA(const size_t c) {
+                const size_type end = Kokkos::min((c + 1) * chunkSize, nLocal);
+                for (size_type i = c * chunkSize; i < end; ++i) {
+                    if (invalid(i)) {
+                        sendIndex(slots(bucket(ranks(i)), c)++) = i;
                     }
                 }
+            });
+        Kokkos::fence();
+
+        return sendIndex;
+    }
 
-                if (rank == ranks(i)) {
-                    idx += 1;
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    template <class ParticleContainer>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::updateGhosts(
+        const ParticleContainer& pdata, T cutoff, T skin) {
+        static IpplTimings::TimerRef ghostTimer = IpplTimings::getTimer("updateGhosts");
+        IpplTimings::startTimer(ghostTimer);
+
+        // all ranks have to agree since rebuilding exchanges the ghost counts
+        int rebuild = !ghostsValid_m || cutoff != ghostCutoff_m || skin != ghostSkin_m
+                      || ghostDrift_m > skin || pdata.getLocalNum() != ghostLocalNum_m;
+        MPI_Allreduce(MPI_IN_PLACE, &rebuild, 1, MPI_INT, MPI_LOR, Comm->getCommunicator());
+        if (rebuild) {
+            buildGhostSchedule(pdata, cutoff + skin);
+            ghostCutoff_m = cutoff;
+            ghostSkin_m   = skin;
+        }
+
+        const auto positions = pdata.R.getView();
+        const auto index     = ghostSendIndex_m;
+        const auto image     = ghostSendImage_m;
+        const auto shifts    = ghostShifts_m;
+        const auto origins   = ghostOrigins_m;
+        const auto periods   = ghostPeriods_m;
+
+        position_view_type send("ghost positions", index.extent(0));
+        using policy_type = Kokkos::RangePolicy<position_execution_space>;
+        Kokkos::parallel_for(
+            "ParticleSpatialLayout::updateGhosts()", policy_type(0, index.extent(0)),
+            KOKKOS_LAMBDA(const size_t k) {
+                const size_t i = index(k);
+                vector_type x  = positions(i);
+                // undo the periodic wrapping since the schedule was built
+                for (unsigned d = 0; d < Dim; ++d) {
+                    if (periods[d] > 0) {
+                        const T wraps = (x[d] - origins(i)[d]) / periods[d];
+                        x[d] -= periods[d] * Kokkos::floor(wraps + T(0.5));
+                    }
                 }
+                send(k) = x + shifts(image(k));
             });
         Kokkos::fence();
+
+        if (ghostR_m.extent(0) != getGhostNum()) {
+            Kokkos::realloc(ghostR_m, getGhostNum());
+        }
+        int tag = Comm->next_tag(P_SPATIAL_GHOST_TAG, P_LAYOUT_CYCLE);
+        exchangeGhostBuffers(send, ghostSendOffsets_m, ghostR_m, ghostRecvOffsets_m, tag);
+
+        IpplTimings::stopTimer(ghostTimer);
     }
 
     template <typename T, unsigned Dim, class Mesh, typename... Properties>
-    size_t ParticleSpatialLayout<T, Dim, Mesh, Properties...>::numberOfSends(
-        int rank, const locate_type& ranks) {
-        size_t nSends     = 0;
+    template <class ParticleContainer>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::buildGhostSchedule(
+        const ParticleContainer& pdata, T range) {
+        auto regions     = rlayout_m.gethLocalRegions();
+        const auto& bcs  = this->getParticleBC();
+        const auto& dom  = rlayout_m.getDomain();
+        const int myRank = Comm->rank();
+        const int nRanks = Comm->size();
+
+        int nCombinations = 1;
+        for (unsigned d = 0; d < Dim; ++d) {
+            ghostPeriods_m[d] = bcs[2 * d] == BC::PERIODIC ? dom[d].length() : 0;
+            nCombinations *= 3;
+        }
+
+        // the periodic images of all regions whose range reaches into the local
+        // region; a particle in the box of an image is a ghost at x + shift
+        std::vector<int> imageRanks;
+        std::vector<vector_type> shifts;
+        std::vector<region_type> boxes;
+        for (int rank = 0; rank < nRanks; ++rank) {
+            for (int c = 0; c < nCombinations; ++c) {
+                vector_type shift;
+                region_type box;
+                bool valid = true, zero = true;
+                for (unsigned d = 0, code = c; d < Dim; ++d, code /= 3) {
+                    const int k = int(code % 3) - 1;
+                    valid &= k == 0 || ghostPeriods_m[d] > 0;
+                    zero &= k == 0;
+                    shift[d] = k * ghostPeriods_m[d];
+                    box[d]   = PRegion<T>(regions(rank)[d].min() - shift[d] - range,
+                                          regions(rank)[d].max() - shift[d] + range);
+                    valid &= box[d].min() <= regions(myRank)[d].max()
+                             && box[d].max() >= regions(myRank)[d].min();
+                }
+                if (valid && !(zero && rank == myRank)) {
+                    imageRanks.push_back(rank);
+                    shifts.push_back(shift);
+                    boxes.push_back(box);
+                }
+            }
+        }
+
+        const size_t nImages = imageRanks.size();
+        ghostShifts_m        = position_view_type("ghost shifts", nImages);
+        Kokkos::deep_copy(ghostShifts_m, Kokkos::View<const vector_type*, Kokkos::HostSpace>(
+                                             shifts.data(), nImages));
+        Kokkos::View<region_type*, position_memory_space> dBoxes("ghost boxes", nImages);
+        Kokkos::deep_copy(dBoxes, Kokkos::View<const region_type*, Kokkos::HostSpace>(
+                                      boxes.data(), nImages));
+
+        const auto positions     = pdata.R.getView();
+        const auto dead          = pdata.R.getDeadMask();
+        const size_type localNum = pdata.getLocalNum();
+        const auto is            = std::make_index_sequence<Dim>{};
+
+        // count the ghosts per image
         using policy_type = Kokkos::RangePolicy<position_execution_space>;
-        Kokkos::parallel_reduce(
-            "ParticleSpatialLayout::numberOfSends()", policy_type(0, ranks.extent(0)),
-            KOKKOS_LAMBDA(const size_t i, size_t& num) { num += size_t(rank == ranks(i)); },
-            nSends);
+        locate_type counts("ghosts per image", nImages);
+        Kokkos::parallel_for(
+            "ParticleSpatialLayout::buildGhostSchedule()::count", policy_type(0, localNum),
+            KOKKOS_LAMBDA(const size_t i) {
+                if (detail::isDead(dead, i)) {
+                    return;
+                }
+                for (size_t m = 0; m < nImages; ++m) {
+                    if (positionInRegion(is, positions(i), dBoxes(m))) {
+                        Kokkos::atomic_increment(&counts(m));
+                    }
+                }
+            });
+        Kokkos::fence();
+
+        // the images are ordered by rank, so the ghosts for each rank are contiguous
+        auto counts_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), counts);
+        std::vector<size_type> nSends(nRanks, 0), nRecvs(nRanks, 0);
+        std::vector<int> neighbors;
+        ghostImageOffsets_m.assign(nImages + 1, 0);
+        for (size_t m = 0; m < nImages; ++m) {
+            ghostImageOffsets_m[m + 1] = ghostImageOffsets_m[m] + counts_host(m);
+            counts_host(m)             = ghostImageOffsets_m[m];
+            nSends[imageRanks[m]] += ghostImageOffsets_m[m + 1] - ghostImageOffsets_m[m];
+            if (imageRanks[m] != myRank
+                && (neighbors.empty() || neighbors.back() != imageRanks[m])) {
+                neighbors.push_back(imageRanks[m]);
+            }
+        }
+        Kokkos::deep_copy(counts, counts_host);
+
+        ghostSendIndex_m = hash_type("ghost send index", ghostImageOffsets_m[nImages]);
+        ghostSendImage_m = locate_type("ghost send image", ghostImageOffsets_m[nImages]);
+        const auto index = ghostSendIndex_m;
+        const auto image = ghostSendImage_m;
+        Kokkos::parallel_for(
+            "ParticleSpatialLayout::buildGhostSchedule()::fill", policy_type(0, localNum),
+            KOKKOS_LAMBDA(const size_t i) {
+                if (detail::isDead(dead, i)) {
+                    return;
+                }
+                for (size_t m = 0; m < nImages; ++m) {
+                    if (positionInRegion(is, positions(i), dBoxes(m))) {
+                        const int k = Kokkos::atomic_fetch_add(&counts(m), 1);
+                        index(k)    = i;
+                        image(k)    = m;
+                    }
+                }
+            });
+
+        ghostOrigins_m = position_view_type("ghost origins", localNum);
+        Kokkos::deep_copy(ghostOrigins_m,
+                          Kokkos::subview(positions, std::make_pair(size_type(0), localNum)));
         Kokkos::fence();
-        return nSends;
+
+        // the neighbor relation is symmetric, since the gap between two
+        // regions does not depend on which of them is shifted
+        exchangeNeighborCounts(nSends, nRecvs, neighbors);
+        nRecvs[myRank] = nSends[myRank];
+
+        ghostSendOffsets_m.assign(nRanks + 1, 0);
+        ghostRecvOffsets_m.assign(nRanks + 1, 0);
+        for (int rank = 0; rank < nRanks; ++rank) {
+            ghostSendOffsets_m[rank + 1] = ghostSendOffsets_m[rank] + nSends[rank];
+            ghostRecvOffsets_m[rank + 1] = ghostRecvOffsets_m[rank] + nRecvs[rank];
+        }
+
+        ghostLocalNum_m = localNum;
+        ghostDrift_m    = 0;
+        ghostsValid_m   = true;
+        ++ghostBuilds_m;
+    }
+
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    template <class Attrib>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::exchangeGhosts(
+        const Attrib& attrib, ghost_view_type<Attrib>& ghosts) const {
+        if (ghostSendOffsets_m.empty()) {
+            throw IpplException("ParticleSpatialLayout::exchangeGhosts",
+                                "The ghost schedule has not been built by updateGhosts.");
+        }
+
+        const auto view  = attrib.getView();
+        const auto index = ghostSendIndex_m;
+
+        ghost_view_type<Attrib> send("ghost values", index.extent(0));
+        using policy_type = Kokkos::RangePolicy<position_execution_space>;
+        Kokkos::parallel_for(
+            "ParticleSpatialLayout::exchangeGhosts()", policy_type(0, index.extent(0)),
+            KOKKOS_LAMBDA(const size_t k) { send(k) = view(index(k)); });
+        Kokkos::fence();
+
+        if (ghosts.extent(0) != getGhostNum()) {
+            Kokkos::realloc(ghosts, getGhostNum());
+        }
+        int tag = Comm->next_tag(P_SPATIAL_GHOST_TAG, P_LAYOUT_CYCLE);
+        exchangeGhostBuffers(send, ghostSendOffsets_m, ghosts, ghostRecvOffsets_m, tag);
+    }
+
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    template <class Attrib>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::accumulateGhosts(
+        Attrib& attrib, const ghost_view_type<Attrib>& ghosts) const {
+        if (ghostSendOffsets_m.empty()) {
+            throw IpplException("ParticleSpatialLayout::accumulateGhosts",
+                                "The ghost schedule has not been built by updateGhosts.");
+        }
+
+        const auto index = ghostSendIndex_m;
+
+        ghost_view_type<Attrib> recv("ghost contributions", index.extent(0));
+        int tag = Comm->next_tag(P_SPATIAL_RETURN_TAG, P_LAYOUT_CYCLE);
+        exchangeGhostBuffers(ghosts, ghostRecvOffsets_m, recv, ghostSendOffsets_m, tag);
+
+        // a particle appears at most once per image, so adding the images one
+        // after the other needs no atomics
+        const auto view   = attrib.getView();
+        using policy_type = Kokkos::RangePolicy<position_execution_space>;
+        for (size_t m = 0; m + 1 < ghostImageOffsets_m.size(); ++m) {
+            Kokkos::parallel_for(
+                "ParticleSpatialLayout::accumulateGhosts()",
+                policy_type(ghostImageOffsets_m[m], ghostImageOffsets_m[m + 1]),
+                KOKKOS_LAMBDA(const size_t k) { view(index(k)) += recv(k); });
+        }
+        Kokkos::fence();
+    }
+
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    template <class ViewType>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::exchangeGhostBuffers(
+        const ViewType& send, const std::vector<size_type>& sendOffsets, const ViewType& recv,
+        const std::vector<size_type>& recvOffsets, int tag) const {
+        using value_type     = typename ViewType::value_type;
+        const MPI_Comm& comm = Comm->getCommunicator();
+        const int myRank     = Comm->rank();
+        const int nRanks     = sendOffsets.size() - 1;
+
+        auto bytes = [](const std::vector<size_type>& offsets, int rank) {
+            return static_cast<int>((offsets[rank + 1] - offsets[rank]) * sizeof(value_type));
+        };
+
+        std::vector<MPI_Request> requests;
+        for (int rank = 0; rank < nRanks; ++rank) {
+            if (rank != myRank && bytes(recvOffsets, rank) > 0) {
+                requests.emplace_back();
+                MPI_Irecv(recv.data() + recvOffsets[rank], bytes(recvOffsets, rank), MPI_BYTE,
+                          rank, tag, comm, &requests.back());
+            }
+        }
+        for (int rank = 0; rank < nRanks; ++rank) {
+            if (rank != myRank && bytes(sendOffsets, rank) > 0) {
+                requests.emplace_back();
+                MPI_Isend(send.data() + sendOffsets[rank], bytes(sendOffsets, rank), MPI_BYTE,
+                          rank, tag, comm, &requests.back());
+            }
+        }
+
+        // the periodic images of the local particles stay on this rank
+        if (bytes(sendOffsets, myRank) > 0) {
+            const auto self = std::make_pair(recvOffsets[myRank], recvOffsets[myRank + 1]);
+            Kokkos::deep_copy(Kokkos::subview(recv, self),
+                              Kokkos::subview(send, std::make_pair(sendOffsets[myRank],
+                                                                   sendOffsets[myRank + 1])));
+        }
+
+        if (requests.size() > 0) {
+            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        }
     }
 }  // namespace ippl
@@ -0,0 +1,159 @@
+//
+// Class SoAParticleAttrib
+//   Vector-valued particle attribute in component-major (structure-of-arrays)
+//   storage.
+//
+//   ParticleAttrib<Vector<T, Dim>> stores the components of a particle next
+//   to each other. This attribute stores each component of all particles in
+//   a contiguous array instead, so that kernels touching one component of
+//   consecutive particles vectorize on CPUs and coalesce on GPUs. The
+//   attribute is used like a ParticleAttrib: attrib(i)[d] accesses a
+//   component, and it takes part in particle expressions, gather, scatter,
+//   the particle pushers and the (de)serialization of a bunch.
+//
+//   Two limits remain: scatter always uses atomic updates, since the scatter
+//   strategies work on scalar values, and the positions ParticleBase::R stay a
+//   ParticleAttrib, since the particle layouts rely on its Kokkos::View.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_SOA_PARTICLE_ATTRIB_H
+#define IPPL_SOA_PARTICLE_ATTRIB_H
+
+#include "Expression/IpplExpressions.h"
+
+#include "Interpolation/ShapeFunctions.h"
+#include "Particle/ParticleAttribBase.h"
+#include "Particle/SoAView.h"
+
+namespace ippl {
+
+    /*!
+     * Vector-valued particle attribute in component-major storage
+     * @tparam T the component type
+     * @tparam Dim the number of components
+     * @tparam Properties the Kokkos view properties, e.g. the memory space
+     */
+    template <typename T, unsigned Dim, class... Properties>
+    class SoAParticleAttrib
+        : public detail::ParticleAttribBase<>::with_properties<Properties...>,
+          public detail::Expression<
+              SoAParticleAttrib<T, Dim, Properties...>,
+              sizeof(detail::SoAView<Dim, Kokkos::View<T**, Kokkos::LayoutLeft, Properties...>>)> {
+    public:
+        typedef Vector<T, Dim> value_type;
+        constexpr static unsigned dim = 1;
+
+        using Base = typename detail::ParticleAttribBase<>::with_properties<Properties...>;
+
+        using hash_type = typename Base::hash_type;
+        using mask_type = typename Base::mask_type;
+
+        using storage_type = Kokkos::View<T**, Kokkos::LayoutLeft, Properties...>;
+        using view_type    = detail::SoAView<Dim, storage_type>;
+        using HostMirror   = typename view_type::host_mirror_type;
+
+        using memory_space    = typename view_type::memory_space;
+        using execution_space = typename view_type::execution_space;
+
+        using size_type = detail::size_type;
+
+        // Create storage for M particle attributes.  The storage is uninitialized.
+        // New items are appended to the end of the array.
+        void create(size_type) override;
+
+        void reserve(size_type n) override;
+
+        /*!
+         * Each component is (de)serialized as a separate array
+         */
+        void appendByteViews(std::vector<detail::ByteView>& views) override {
+            for (unsigned d = 0; d < Dim; ++d) {
+                views.push_back({reinterpret_cast<char*>(dview_m.component(d)), sizeof(T), 0});
+            }
+        }
+
+        virtual ~SoAParticleAttrib() = default;
+
+        size_type size() const override { return dview_m.extent(0); }
+
+        size_type packedSize(const size_type count) const override {
+            return count * Dim * sizeof(T);
+        }
+
+        void resize(size_type n) { Kokkos::resize(dview_m.getStorage(), n, Dim); }
+
+        void realloc(size_type n) { Kokkos::realloc(dview_m.getStorage(), n, Dim); }
+
+        KOKKOS_INLINE_FUNCTION typename view_type::reference_type operator()(
+            const size_t i) const {
+            return dview_m(i);
+        }
+
+        view_type& getView() { return dview_m; }
+
+        const view_type& getView() const { return dview_m; }
+
+        HostMirror getHostMirror() { return HostMirror(Kokkos::create_mirror(dview_m.getStorage())); }
+
+        /*!
+         * Assign the same value to the whole attribute.
+         */
+        SoAParticleAttrib<T, Dim, Properties...>& operator=(value_type x);
+
+        /*!
+         * Assign an arbitrary particle attribute expression
+         * @tparam E expression type
+         * @tparam N size of the expression, this is necessary for running on the
+         * device since otherwise it does not allocate enough memory
+         * @param expr is the expression
+         */
+        template <typename E, size_t N>
+        SoAParticleAttrib<T, Dim, Properties...>& operator=(detail::Expression<E, N> const& expr);
+
+        /*!
+         * Interpolate the given vector field at the particle positions into this attribute
+         * @tparam Shape the shape function (see Interpolation/ShapeFunctions.h)
+         * @param f the field to gather from
+         * @param pp the particle positions, stored as ParticleAttrib or SoAParticleAttrib
+         */
+        template <typename Shape = CIC, typename Field, typename PositionAttrib>
+        void gather(Field& f, const PositionAttrib& pp);
+
+        /*!
+         * Deposit the attribute onto the given vector field at the particle positions,
+         * all components in one kernel with atomic updates
+         * @tparam Shape the shape function (see Interpolation/ShapeFunctions.h)
+         * @param f the field to scatter to
+         * @param pp the particle positions, stored as ParticleAttrib or SoAParticleAttrib
+         */
+        template <typename Shape = CIC, typename Field, typename PositionAttrib>
+        void scatter(Field& f, const PositionAttrib& pp) const;
+
+        /*!
+         * The reductions are done component-wise
+         */
+        value_type sum();
+        value_type max();
+        value_type min();
+        value_type prod();
+
+    private:
+        view_type dview_m;
+    };
+}  // namespace ippl
+
+#include "Particle/SoAParticleAttrib.hpp"
+
+#endif
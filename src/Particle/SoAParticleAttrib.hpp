@@ -0,0 +1,250 @@
+//
+// Class SoAParticleAttrib
+//   Vector-valued particle attribute in component-major (structure-of-arrays)
+//   storage.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Ippl.h"
+
+#include "Communicate/DataTypes.h"
+
+#include "Utility/IpplTimings.h"
+
+namespace ippl {
+
+    template <typename T, unsigned Dim, class... Properties>
+    void SoAParticleAttrib<T, Dim, Properties...>::create(size_type n) {
+        size_type required = *(this->localNum_mp) + n;
+        if (this->size() < required) {
+            int overalloc = Comm->getDefaultOverallocation();
+            this->realloc(required * overalloc);
+        }
+    }
+
+    template <typename T, unsigned Dim, class... Properties>
+    void SoAParticleAttrib<T, Dim, Properties...>::reserve(size_type n) {
+        if (this->size() < n) {
+            int overalloc = Comm->getDefaultOverallocation();
+            this->resize(n * overalloc);
+        }
+    }
+
+    template <typename T, unsigned Dim, class... Properties>
+    SoAParticleAttrib<T, Dim, Properties...>& SoAParticleAttrib<T, Dim, Properties...>::operator=(
+        value_type x) {
+        const mask_type dead = this->getDeadMask();
+        const view_type view = dview_m;
+
+        using policy_type = Kokkos::RangePolicy<execution_space>;
+        Kokkos::parallel_for(
+            "SoAParticleAttrib::operator=()", policy_type(0, *(this->localNum_mp)),
+            KOKKOS_LAMBDA(const size_t i) {
+                if (!detail::isDead(dead, i)) {
+                    view(i) = x;
+                }
+            });
+        return *this;
+    }
+
+    template <typename T, unsigned Dim, class... Properties>
+    template <typename E, size_t N>
+    SoAParticleAttrib<T, Dim, Properties...>& SoAParticleAttrib<T, Dim, Properties...>::operator=(
+        detail::Expression<E, N> const& expr) {
+        using capture_type = detail::CapturedExpression<E, N>;
+        capture_type expr_ = reinterpret_cast<const capture_type&>(expr);
+
+        const mask_type dead = this->getDeadMask();
+        const view_type view = dview_m;
+
+        using policy_type = Kokkos::RangePolicy<execution_space>;
+        Kokkos::parallel_for(
+            "SoAParticleAttrib::operator=()", policy_type(0, *(this->localNum_mp)),
+            KOKKOS_LAMBDA(const size_t i) {
+                if (!detail::isDead(dead, i)) {
+                    view(i) = expr_(i);
+                }
+            });
+        return *this;
+    }
+
+    template <typename T, unsigned Dim, class... Properties>
+    template <typename Shape, typename Field, typename PositionAttrib>
+    void SoAParticleAttrib<T, Dim, Properties...>::gather(Field& f, const PositionAttrib& pp) {
+        constexpr unsigned FieldDim = Field::dim;
+
+        static IpplTimings::TimerRef fillHaloTimer = IpplTimings::getTimer("fillHalo");
+        IpplTimings::startTimer(fillHaloTimer);
+        f.fillHalo();
+        IpplTimings::stopTimer(fillHaloTimer);
+
+        static IpplTimings::TimerRef gatherTimer = IpplTimings::getTimer("gather");
+        IpplTimings::startTimer(gatherTimer);
+        const typename Field::view_type field = f.getView();
+
+        using mesh_type       = typename Field::Mesh_t;
+        const mesh_type& mesh = f.get_mesh();
+
+        using vector_type = typename mesh_type::vector_type;
+        using weight_type = typename mesh_type::value_type;
+
+        const vector_type& dx     = mesh.getMeshSpacing();
+        const vector_type& origin = mesh.getOrigin();
+        const vector_type invdx   = 1.0 / dx;
+
+        const FieldLayout<FieldDim>& layout = f.getLayout();
+        const NDIndex<FieldDim>& lDom       = layout.getLocalNDIndex();
+        const int nghost                    = f.getNghost();
+        detail::checkShapeSupport<Shape>(f, "SoAParticleAttrib::gather");
+
+        detail::StencilMap<Shape, weight_type, FieldDim, vector_type> map{origin, invdx,
+                                                                          lDom.first() - nghost};
+
+        const mask_type dead = this->getDeadMask();
+        const auto positions = pp.getView();
+        const view_type view = dview_m;
+
+        using policy_type = Kokkos::RangePolicy<execution_space>;
+        Kokkos::parallel_for(
+            "SoAParticleAttrib::gather", policy_type(0, *(this->localNum_mp)),
+            KOKKOS_LAMBDA(const size_t idx) {
+                if (detail::isDead(dead, idx)) {
+                    return;
+                }
+
+                const auto stencil = map(positions(idx));
+
+                view(idx) = detail::gatherFromField(
+                    detail::stencil_sequence<Shape, FieldDim>{}, field, stencil);
+            });
+        IpplTimings::stopTimer(gatherTimer);
+    }
+
+    template <typename T, unsigned Dim, class... Properties>
+    template <typename Shape, typename Field, typename PositionAttrib>
+    void SoAParticleAttrib<T, Dim, Properties...>::scatter(Field& f,
+                                                           const PositionAttrib& pp) const {
+        constexpr unsigned FieldDim = Field::dim;
+
+        static_assert(std::is_same_v<typename Field::value_type, value_type>,
+                      "The field must hold vectors of the attribute type");
+
+        static IpplTimings::TimerRef scatterTimer = IpplTimings::getTimer("scatter");
+        IpplTimings::startTimer(scatterTimer);
+        const typename Field::view_type field = f.getView();
+
+        using mesh_type       = typename Field::Mesh_t;
+        const mesh_type& mesh = f.get_mesh();
+
+        using vector_type = typename mesh_type::vector_type;
+        using weight_type = typename mesh_type::value_type;
+
+        const vector_type& dx     = mesh.getMeshSpacing();
+        const vector_type& origin = mesh.getOrigin();
+        const vector_type invdx   = 1.0 / dx;
+
+        const FieldLayout<FieldDim>& layout = f.getLayout();
+        const NDIndex<FieldDim>& lDom       = layout.getLocalNDIndex();
+        const int nghost                    = f.getNghost();
+        detail::checkShapeSupport<Shape>(f, "SoAParticleAttrib::scatter");
+
+        detail::StencilMap<Shape, weight_type, FieldDim, vector_type> map{origin, invdx,
+                                                                          lDom.first() - nghost};
+
+        const mask_type dead = this->getDeadMask();
+        const auto positions = pp.getView();
+        const view_type view = dview_m;
+
+        using points      = detail::stencil_sequence<Shape, FieldDim>;
+        using policy_type = Kokkos::RangePolicy<execution_space>;
+        Kokkos::parallel_for(
+            "SoAParticleAttrib::scatter", policy_type(0, *(this->localNum_mp)),
+            KOKKOS_LAMBDA(const size_t idx) {
+                if (detail::isDead(dead, idx)) {
+                    return;
+                }
+
+                const auto stencil     = map(positions(idx));
+                const value_type value = view(idx);
+
+                // the weights of the stencil points are computed once for all components
+                detail::depositToField(
+                    points{},
+                    [&](const weight_type& weight, auto... index) {
+                        for (unsigned d = 0; d < Dim; ++d) {
+                            Kokkos::atomic_add(&field(index...)[d], weight * value[d]);
+                        }
+                    },
+                    stencil, weight_type(1));
+            });
+        IpplTimings::stopTimer(scatterTimer);
+
+        static IpplTimings::TimerRef accumulateHaloTimer = IpplTimings::getTimer("accumulateHalo");
+        IpplTimings::startTimer(accumulateHaloTimer);
+        f.accumulateHalo();
+        IpplTimings::stopTimer(accumulateHaloTimer);
+    }
+
+    /*
+     * Non-class function
+     *
+     */
+
+    template <typename Shape = CIC, typename T, unsigned Dim, typename Tf, unsigned FieldDim,
+              class M, class C, typename PositionAttrib, class... Properties>
+    inline void gather(SoAParticleAttrib<T, Dim, Properties...>& attrib,
+                       Field<Tf, FieldDim, M, C>& f, const PositionAttrib& pp) {
+        attrib.template gather<Shape>(f, pp);
+    }
+
+    template <typename Shape = CIC, typename T, unsigned Dim, typename Tf, unsigned FieldDim,
+              class M, class C, typename PositionAttrib, class... Properties>
+    inline void scatter(const SoAParticleAttrib<T, Dim, Properties...>& attrib,
+                        Field<Tf, FieldDim, M, C>& f, const PositionAttrib& pp) {
+        attrib.template scatter<Shape>(f, pp);
+    }
+
+    // The components are reduced one after the other, each over a contiguous
+    // array, and all of them in a single MPI_Allreduce
+#define DefineSoAParticleReduction(fun, name, op, MPI_Op)                                   \
+    template <typename T, unsigned Dim, class... Properties>                                \
+    typename SoAParticleAttrib<T, Dim, Properties...>::value_type                           \
+    SoAParticleAttrib<T, Dim, Properties...>::name() {                                      \
+        value_type temp      = 0.0;                                                         \
+        const mask_type dead = this->getDeadMask();                                         \
+        using policy_type    = Kokkos::RangePolicy<execution_space>;                        \
+        for (unsigned d = 0; d < Dim; ++d) {                                                \
+            const T* component = dview_m.component(d);                                      \
+            Kokkos::parallel_reduce(                                                        \
+                "fun", policy_type(0, *(this->localNum_mp)),                                \
+                KOKKOS_LAMBDA(const size_t i, T& valL) {                                    \
+                    if (detail::isDead(dead, i)) {                                          \
+                        return;                                                             \
+                    }                                                                       \
+                    T myVal = component[i];                                                 \
+                    op;                                                                     \
+                },                                                                          \
+                Kokkos::fun<T>(temp[d]));                                                   \
+        }                                                                                   \
+        value_type globaltemp = 0.0;                                                        \
+        MPI_Datatype type     = get_mpi_datatype<T>(temp[0]);                               \
+        MPI_Allreduce(&temp[0], &globaltemp[0], Dim, type, MPI_Op, Comm->getCommunicator()); \
+        return globaltemp;                                                                  \
+    }
+
+    DefineSoAParticleReduction(Sum, sum, valL += myVal, MPI_SUM)
+    DefineSoAParticleReduction(Max, max, if (myVal > valL) valL = myVal, MPI_MAX)
+    DefineSoAParticleReduction(Min, min, if (myVal < valL) valL = myVal, MPI_MIN)
+    DefineSoAParticleReduction(Prod, prod, valL *= myVal, MPI_PROD)
+}  // namespace ippl
@@ -0,0 +1,172 @@
+//
+// Class SoAView
+//   Component-major (structure-of-arrays) storage of vector-valued particle
+//   data. The components of all particles are stored contiguously, one
+//   component after the other, so that the same component of consecutive
+//   particles is adjacent in memory. Particles are accessed through a
+//   VectorProxy, which behaves like a reference to a Vector.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_SOA_VIEW_H
+#define IPPL_SOA_VIEW_H
+
+#include <Kokkos_Core.hpp>
+
+#include "Types/Vector.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * Reference to the components of a single particle in component-major
+         * storage. The proxy takes part in expressions like a Vector and
+         * assignments write through to the storage.
+         * @tparam T the component type
+         * @tparam Dim the number of components
+         */
+        template <typename T, unsigned Dim>
+        class VectorProxy : public Expression<VectorProxy<T, Dim>, sizeof(T*) + sizeof(size_t)> {
+        public:
+            typedef T value_type;
+            static constexpr unsigned dim = Dim;
+
+            /*!
+             * @param data the first component of the particle
+             * @param stride the distance between two components
+             */
+            KOKKOS_FUNCTION
+            VectorProxy(T* data, size_t stride)
+                : data_m(data)
+                , stride_m(stride) {}
+
+            KOKKOS_DEFAULTED_FUNCTION
+            VectorProxy(const VectorProxy<T, Dim>&) = default;
+
+            KOKKOS_INLINE_FUNCTION value_type& operator[](unsigned d) const {
+                return data_m[d * stride_m];
+            }
+
+            KOKKOS_INLINE_FUNCTION value_type& operator()(unsigned d) const {
+                return data_m[d * stride_m];
+            }
+
+            /*!
+             * Copy the components of another particle; unlike the copy
+             * constructor, this does not rebind the proxy
+             */
+            KOKKOS_INLINE_FUNCTION VectorProxy<T, Dim>& operator=(const VectorProxy<T, Dim>& other) {
+                return *this = Vector<T, Dim>(other);
+            }
+
+            KOKKOS_INLINE_FUNCTION VectorProxy<T, Dim>& operator=(const T& val) {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    (*this)[d] = val;
+                }
+                return *this;
+            }
+
+            template <typename E, size_t N>
+            KOKKOS_INLINE_FUNCTION VectorProxy<T, Dim>& operator=(const Expression<E, N>& expr) {
+                // evaluate first, since the expression may refer to this particle
+                const Vector<T, Dim> value(expr);
+                for (unsigned d = 0; d < Dim; ++d) {
+                    (*this)[d] = value[d];
+                }
+                return *this;
+            }
+
+            template <typename E, size_t N>
+            KOKKOS_INLINE_FUNCTION VectorProxy<T, Dim>& operator+=(const Expression<E, N>& expr) {
+                return *this = *this + expr;
+            }
+
+            template <typename E, size_t N>
+            KOKKOS_INLINE_FUNCTION VectorProxy<T, Dim>& operator-=(const Expression<E, N>& expr) {
+                return *this = *this - expr;
+            }
+
+            template <typename E, size_t N>
+            KOKKOS_INLINE_FUNCTION VectorProxy<T, Dim>& operator*=(const Expression<E, N>& expr) {
+                return *this = *this * expr;
+            }
+
+            template <typename E, size_t N>
+            KOKKOS_INLINE_FUNCTION VectorProxy<T, Dim>& operator/=(const Expression<E, N>& expr) {
+                return *this = *this / expr;
+            }
+
+        private:
+            T* data_m;
+            size_t stride_m;
+        };
+
+        /*!
+         * View of vector-valued particle data in component-major order; the
+         * element access returns a VectorProxy
+         * @tparam Dim the number of components
+         * @tparam Storage the two-dimensional Kokkos::View with the particles
+         * in the first and the components in the second dimension
+         */
+        template <unsigned Dim, typename Storage>
+        class SoAView {
+        public:
+            using storage_type     = Storage;
+            using component_type   = typename storage_type::value_type;
+            using value_type       = Vector<component_type, Dim>;
+            using reference_type   = VectorProxy<component_type, Dim>;
+            using memory_space     = typename storage_type::memory_space;
+            using execution_space  = typename storage_type::execution_space;
+            using host_mirror_type = SoAView<Dim, typename storage_type::host_mirror_type>;
+
+            static_assert(std::is_same_v<typename storage_type::array_layout, Kokkos::LayoutLeft>,
+                          "The components must be stored one after the other");
+
+            SoAView() = default;
+
+            SoAView(const std::string& label, size_t n)
+                : storage_m(label, n, Dim) {}
+
+            explicit SoAView(const storage_type& storage)
+                : storage_m(storage) {}
+
+            KOKKOS_INLINE_FUNCTION reference_type operator()(const size_t i) const {
+                return reference_type(storage_m.data() + i, storage_m.stride(1));
+            }
+
+            /*!
+             * @param r the rank, 0 for the particles and 1 for the components
+             */
+            KOKKOS_INLINE_FUNCTION size_t extent(const unsigned r) const {
+                return storage_m.extent(r);
+            }
+
+            /*!
+             * @param d the component
+             * @return The contiguous array of the given component of all particles
+             */
+            KOKKOS_INLINE_FUNCTION component_type* component(const unsigned d) const {
+                return storage_m.data() + d * storage_m.stride(1);
+            }
+
+            storage_type& getStorage() { return storage_m; }
+
+            const storage_type& getStorage() const { return storage_m; }
+
+        private:
+            storage_type storage_m;
+        };
+    }  // namespace detail
+}  // namespace ippl
+
+#endif
@@ -0,0 +1,115 @@
+//
+// Distributions
+//   One-dimensional probability distributions for inverse transform sampling.
+//   A distribution is a small struct that can be copied into kernels and
+//   provides
+//     cdf(x)       the cumulative distribution function; it may be unnormalised,
+//                  but must be non-decreasing
+//     pdf(x)       its derivative
+//   and optionally
+//     inverse(u)   the exact inverse of the CDF, used instead of Newton iterations
+//     estimate(u)  a starting point for the Newton iterations
+//   Any struct with these members can be used with InverseTransformSampling.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_DISTRIBUTIONS_H
+#define IPPL_DISTRIBUTIONS_H
+
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+
+namespace ippl {
+    namespace random {
+        //! Uniform density on the real line, cdf(x) = x
+        template <typename T>
+        struct Uniform {
+            KOKKOS_INLINE_FUNCTION T cdf(T x) const;
+
+            KOKKOS_INLINE_FUNCTION T pdf(T x) const;
+
+            KOKKOS_INLINE_FUNCTION T inverse(T u) const;
+        };
+
+        //! Normal distribution; the inverse uses a rational approximation
+        //! refined by one Halley step
+        template <typename T>
+        struct Normal {
+            T mean   = 0;
+            T stddev = 1;
+
+            KOKKOS_INLINE_FUNCTION T cdf(T x) const;
+
+            KOKKOS_INLINE_FUNCTION T pdf(T x) const;
+
+            KOKKOS_INLINE_FUNCTION T inverse(T u) const;
+        };
+
+        //! Density 1 + alpha * cos(k * x) of a perturbed plasma, as in Landau
+        //! damping and two-stream instabilities
+        template <typename T>
+        struct CosinePerturbation {
+            T alpha = 0;
+            T k     = 1;
+
+            KOKKOS_INLINE_FUNCTION T cdf(T x) const;
+
+            KOKKOS_INLINE_FUNCTION T pdf(T x) const;
+
+            KOKKOS_INLINE_FUNCTION T estimate(T u) const;
+        };
+
+        /*!
+         * Distribution given by the values of the density at equidistant points;
+         * the density is linear between the points and zero outside
+         * @tparam T the value type
+         * @tparam MemorySpace the memory space of the table
+         */
+        template <typename T, class MemorySpace = Kokkos::DefaultExecutionSpace::memory_space>
+        class Tabulated {
+        public:
+            using view_type = Kokkos::View<T*, MemorySpace>;
+
+            Tabulated() = default;
+
+            /*!
+             * @param pdf the density at xmin + i * (xmax - xmin) / (pdf.size() - 1),
+             * which need not be normalised
+             * @param xmin the first point of the table
+             * @param xmax the last point of the table
+             */
+            Tabulated(const std::vector<T>& pdf, T xmin, T xmax);
+
+            KOKKOS_INLINE_FUNCTION T cdf(T x) const;
+
+            KOKKOS_INLINE_FUNCTION T pdf(T x) const;
+
+            KOKKOS_INLINE_FUNCTION T inverse(T u) const;
+
+        private:
+            //! The density and the cumulative distribution at the points
+            view_type pdf_m;
+            view_type cdf_m;
+
+            T xmin_m;
+            T h_m;
+            int n_m;
+        };
+    }  // namespace random
+}  // namespace ippl
+
+#include "Random/Distributions.hpp"
+
+#endif
@@ -0,0 +1,189 @@
+//
+// Distributions
+//   One-dimensional probability distributions for inverse transform sampling.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include <Kokkos_MathematicalConstants.hpp>
+#include <Kokkos_MathematicalFunctions.hpp>
+
+#include "Utility/IpplException.h"
+
+namespace ippl {
+    namespace random {
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION T Uniform<T>::cdf(T x) const {
+            return x;
+        }
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION T Uniform<T>::pdf(T) const {
+            return 1;
+        }
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION T Uniform<T>::inverse(T u) const {
+            return u;
+        }
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION T Normal<T>::cdf(T x) const {
+            return 0.5 * Kokkos::erfc(-(x - mean) / (stddev * Kokkos::numbers::sqrt2_v<T>));
+        }
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION T Normal<T>::pdf(T x) const {
+            const T z = (x - mean) / stddev;
+            return Kokkos::exp(-0.5 * z * z)
+                   / (stddev * Kokkos::sqrt(2 * Kokkos::numbers::pi_v<T>));
+        }
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION T Normal<T>::inverse(T u) const {
+            // rational approximation of the standard normal quantile (P. J. Acklam),
+            // with a relative error below 1.2e-9
+            const T a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                           1.383577518672690e+02,  -3.066479806614716e+01, 2.506628277459239e+00};
+            const T b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                           6.680131188771972e+01, -1.328068155288572e+01};
+            const T c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                           -2.549732539343734e+00, 4.374664141464968e+00,  2.938163982698783e+00};
+            const T d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                           3.754408661907416e+00};
+            const T pLow = 0.02425;
+
+            // u = 0 and u = 1 would map to infinity
+            const T tiny = Kokkos::Experimental::norm_min_v<T>;
+            const T eps  = Kokkos::Experimental::epsilon_v<T>;
+            const T p    = Kokkos::min(Kokkos::max(u, tiny), 1 - eps);
+
+            T z;
+            if (p < pLow || p > 1 - pLow) {
+                const T q = Kokkos::sqrt(-2 * Kokkos::log(p < pLow ? p : 1 - p));
+                z         = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+                    / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+                if (p > 1 - pLow) {
+                    z = -z;
+                }
+            } else {
+                const T q = p - 0.5;
+                const T r = q * q;
+                z = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+                    / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+            }
+
+            // one Halley step brings the quantile to full precision
+            const T e = 0.5 * Kokkos::erfc(-z / Kokkos::numbers::sqrt2_v<T>) - p;
+            const T v = e * Kokkos::sqrt(2 * Kokkos::numbers::pi_v<T>) * Kokkos::exp(0.5 * z * z);
+            z         = z - v / (1 + 0.5 * z * v);
+
+            return mean + stddev * z;
+        }
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION T CosinePerturbation<T>::cdf(T x) const {
+            return x + alpha * Kokkos::sin(k * x) / k;
+        }
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION T CosinePerturbation<T>::pdf(T x) const {
+            return 1 + alpha * Kokkos::cos(k * x);
+        }
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION T CosinePerturbation<T>::estimate(T u) const {
+            return u / (1 + alpha);
+        }
+
+        template <typename T, class MemorySpace>
+        Tabulated<T, MemorySpace>::Tabulated(const std::vector<T>& pdf, T xmin, T xmax)
+            : pdf_m("tabulated pdf", pdf.size())
+            , cdf_m("tabulated cdf", pdf.size())
+            , xmin_m(xmin)
+            , h_m((xmax - xmin) / (pdf.size() - 1))
+            , n_m(pdf.size()) {
+            if (pdf.size() < 2 || !(xmax > xmin)) {
+                throw IpplException("Tabulated::Tabulated",
+                                    "The table needs at least two points on a non-empty interval.");
+            }
+
+            // the trapezoidal rule is exact for the linear density between the points
+            auto pdf_host = Kokkos::create_mirror_view(pdf_m);
+            auto cdf_host = Kokkos::create_mirror_view(cdf_m);
+            cdf_host(0)   = 0;
+            for (int i = 0; i < n_m; ++i) {
+                if (pdf[i] < 0) {
+                    throw IpplException("Tabulated::Tabulated",
+                                        "The density must not be negative.");
+                }
+                pdf_host(i) = pdf[i];
+                if (i > 0) {
+                    cdf_host(i) = cdf_host(i - 1) + 0.5 * h_m * (pdf[i - 1] + pdf[i]);
+                }
+            }
+            Kokkos::deep_copy(pdf_m, pdf_host);
+            Kokkos::deep_copy(cdf_m, cdf_host);
+        }
+
+        template <typename T, class MemorySpace>
+        KOKKOS_INLINE_FUNCTION T Tabulated<T, MemorySpace>::cdf(T x) const {
+            const T s = (x - xmin_m) / h_m;
+            if (s <= 0) {
+                return 0;
+            }
+            if (s >= n_m - 1) {
+                return cdf_m(n_m - 1);
+            }
+            const int i = static_cast<int>(s);
+            const T t   = s - i;
+            return cdf_m(i) + h_m * t * (pdf_m(i) + 0.5 * t * (pdf_m(i + 1) - pdf_m(i)));
+        }
+
+        template <typename T, class MemorySpace>
+        KOKKOS_INLINE_FUNCTION T Tabulated<T, MemorySpace>::pdf(T x) const {
+            const T s = (x - xmin_m) / h_m;
+            if (s < 0 || s > n_m - 1) {
+                return 0;
+            }
+            const int i = Kokkos::min(static_cast<int>(s), n_m - 2);
+            const T t   = s - i;
+            return pdf_m(i) + t * (pdf_m(i + 1) - pdf_m(i));
+        }
+
+        template <typename T, class MemorySpace>
+        KOKKOS_INLINE_FUNCTION T Tabulated<T, MemorySpace>::inverse(T u) const {
+            // the interval [cdf(i), cdf(i + 1)] containing u
+            int lo = 0, hi = n_m - 1;
+            while (hi - lo > 1) {
+                const int mid = (lo + hi) / 2;
+                if (cdf_m(mid) <= u) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+
+            // solve the quadratic cdf of the linear density in a form that is
+            // stable for a constant density as well
+            const T a = 0.5 * h_m * (pdf_m(lo + 1) - pdf_m(lo));
+            const T b = h_m * pdf_m(lo);
+            const T c = Kokkos::max(u - cdf_m(lo), T(0));
+
+            const T disc  = Kokkos::sqrt(Kokkos::max(b * b + 4 * a * c, T(0)));
+            const T denom = b + disc;
+            const T t     = denom > 0 ? Kokkos::min(2 * c / denom, T(1)) : T(0);
+            return xmin_m + (lo + t) * h_m;
+        }
+    }  // namespace random
+}  // namespace ippl
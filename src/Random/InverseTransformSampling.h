@@ -0,0 +1,124 @@
+//
+// Class InverseTransformSampling
+//   Generates particle coordinates from a separable distribution by inverting
+//   the one-dimensional CDFs on the execution space. The distribution can be
+//   restricted to the local region of a rank, so that every rank creates only
+//   its own particles:
+//
+//     using Dist_t = ippl::random::CosinePerturbation<double>;
+//     Kokkos::Array<Dist_t, Dim> dist = ...;
+//     ippl::random::InverseTransformSampling<double, Dim, Dist_t> sampler(dist, rmin, rmax, seed);
+//     size_type nloc = sampler.setLocalRegion(locrmin, locrmax, totalP);
+//     bunch.create(nloc);
+//     sampler.generate(bunch.R, nloc);
+//
+//   Every particle draws its random numbers from a generator seeded with the
+//   seed, the rank and the particle index, so the result does not depend on
+//   the number of threads or the order in which they run.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#ifndef IPPL_INVERSE_TRANSFORM_SAMPLING_H
+#define IPPL_INVERSE_TRANSFORM_SAMPLING_H
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+#include "Types/IpplTypes.h"
+
+#include "Types/Vector.h"
+
+#include "Random/Distributions.h"
+
+namespace ippl {
+    namespace random {
+        /*!
+         * Inverse transform sampling of a separable distribution
+         * @tparam T the value type of the coordinates
+         * @tparam Dim the number of coordinates
+         * @tparam Distribution the one-dimensional distribution type (see Distributions.h)
+         * @tparam ExecSpace the execution space of the sampling kernels
+         */
+        template <typename T, unsigned Dim, class Distribution,
+                  class ExecSpace = Kokkos::DefaultExecutionSpace>
+        class InverseTransformSampling {
+        public:
+            using vector_type        = Vector<T, Dim>;
+            using size_type          = ippl::detail::size_type;
+            using execution_space    = ExecSpace;
+            using distribution_array = Kokkos::Array<Distribution, Dim>;
+            using generator_type     = Kokkos::Random_XorShift64<execution_space>;
+
+            /*!
+             * @param dist the distribution of each coordinate
+             * @param rmin the lower bounds of the sampled box; may be -infinity for
+             * distributions with an exact inverse
+             * @param rmax the upper bounds of the sampled box
+             * @param seed the seed; attributes sampled independently need different seeds
+             */
+            InverseTransformSampling(const distribution_array& dist, const vector_type& rmin,
+                                     const vector_type& rmax, std::uint64_t seed);
+
+            /*!
+             * Restrict the sampling to the local region of this rank and share a number
+             * of particles among the ranks in proportion to the probability of their
+             * regions. Must be called on all ranks.
+             * @param locrmin the lower bounds of the local region
+             * @param locrmax the upper bounds of the local region
+             * @param totalNum the total number of particles on all ranks
+             * @returns the number of particles of this rank
+             */
+            size_type setLocalRegion(const vector_type& locrmin, const vector_type& locrmax,
+                                     size_type totalNum);
+
+            /*!
+             * Fill a vector attribute with samples
+             * @param attrib the attribute, e.g. the positions of a bunch
+             * @param count the number of particles to sample
+             * @param first the index of the first particle; particles keep their
+             * samples when they are generated in several calls
+             */
+            template <class Attrib>
+            void generate(Attrib& attrib, size_type count, size_type first = 0) const;
+
+        private:
+            distribution_array dist_m;
+
+            //! The global box and its probability
+            vector_type rmin_m;
+            vector_type rmax_m;
+            vector_type cdfMin_m;
+            vector_type cdfMax_m;
+
+            //! The sampled box and the range of the CDFs on it
+            vector_type locrmin_m;
+            vector_type locrmax_m;
+            vector_type umin_m;
+            vector_type umax_m;
+
+            std::uint64_t seed_m;
+
+            //! Evaluate the CDFs at the bounds of a box on the execution space
+            void evaluateCDF(const vector_type& rmin, const vector_type& rmax, vector_type& cdfMin,
+                             vector_type& cdfMax) const;
+        };
+    }  // namespace random
+}  // namespace ippl
+
+#include "Random/InverseTransformSampling.hpp"
+
+#endif
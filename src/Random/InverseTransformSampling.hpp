@@ -0,0 +1,184 @@
+//
+// Class InverseTransformSampling
+//   Generates particle coordinates from a separable distribution by inverting
+//   the one-dimensional CDFs on the execution space.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Ippl.h"
+
+#include "Utility/IpplTimings.h"
+
+namespace ippl {
+    namespace random {
+        namespace detail {
+            //! The SplitMix64 hash, which decorrelates neighbouring seeds
+            KOKKOS_INLINE_FUNCTION std::uint64_t splitmix64(std::uint64_t x) {
+                x += 0x9E3779B97F4A7C15ull;
+                x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+                x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+                return x ^ (x >> 31);
+            }
+
+            /*!
+             * Invert a CDF, exactly if the distribution provides an inverse and
+             * otherwise with Newton iterations that fall back to bisection whenever
+             * a step leaves the bracket [lo, hi]
+             * @param dist the distribution
+             * @param u the value of the CDF, between umin = cdf(lo) and umax = cdf(hi)
+             * @returns x with cdf(x) = u
+             */
+            template <typename T, class Distribution>
+            KOKKOS_INLINE_FUNCTION T invertCDF(const Distribution& dist, T u, T lo, T hi, T umin,
+                                               T umax) {
+                if constexpr (requires { dist.inverse(u); }) {
+                    return dist.inverse(u);
+                } else {
+                    T x;
+                    if constexpr (requires { dist.estimate(u); }) {
+                        x = Kokkos::min(Kokkos::max(dist.estimate(u), lo), hi);
+                    } else {
+                        x = lo + (hi - lo) * (u - umin) / (umax - umin);
+                    }
+
+                    const T eps           = Kokkos::Experimental::epsilon_v<T>;
+                    const T tol           = 16 * eps * (1 + Kokkos::abs(u));
+                    constexpr int maxIter = 64;
+                    for (int iter = 0; iter < maxIter; ++iter) {
+                        const T f = dist.cdf(x) - u;
+                        if (Kokkos::abs(f) <= tol) {
+                            break;
+                        }
+                        if (f > 0) {
+                            hi = x;
+                        } else {
+                            lo = x;
+                        }
+                        T next = x - f / dist.pdf(x);
+                        if (!(next > lo && next < hi)) {
+                            next = 0.5 * (lo + hi);
+                        }
+                        x = next;
+                    }
+                    return x;
+                }
+            }
+        }  // namespace detail
+
+        template <typename T, unsigned Dim, class Distribution, class ExecSpace>
+        InverseTransformSampling<T, Dim, Distribution, ExecSpace>::InverseTransformSampling(
+            const distribution_array& dist, const vector_type& rmin, const vector_type& rmax,
+            std::uint64_t seed)
+            : dist_m(dist)
+            , rmin_m(rmin)
+            , rmax_m(rmax)
+            , locrmin_m(rmin)
+            , locrmax_m(rmax)
+            , seed_m(seed) {
+            evaluateCDF(rmin_m, rmax_m, cdfMin_m, cdfMax_m);
+            umin_m = cdfMin_m;
+            umax_m = cdfMax_m;
+        }
+
+        template <typename T, unsigned Dim, class Distribution, class ExecSpace>
+        void InverseTransformSampling<T, Dim, Distribution, ExecSpace>::evaluateCDF(
+            const vector_type& rmin, const vector_type& rmax, vector_type& cdfMin,
+            vector_type& cdfMax) const {
+            // the distributions may hold views, so the CDFs are evaluated where they live
+            Kokkos::View<T * [2], typename execution_space::memory_space> values("CDF bounds",
+                                                                                   Dim);
+            const distribution_array dist = dist_m;
+            Kokkos::parallel_for(
+                "InverseTransformSampling::evaluateCDF",
+                Kokkos::RangePolicy<execution_space>(0, Dim), KOKKOS_LAMBDA(const unsigned d) {
+                    values(d, 0) = dist[d].cdf(rmin[d]);
+                    values(d, 1) = dist[d].cdf(rmax[d]);
+                });
+
+            auto values_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), values);
+            for (unsigned d = 0; d < Dim; ++d) {
+                cdfMin[d] = values_host(d, 0);
+                cdfMax[d] = values_host(d, 1);
+            }
+        }
+
+        template <typename T, unsigned Dim, class Distribution, class ExecSpace>
+        typename InverseTransformSampling<T, Dim, Distribution, ExecSpace>::size_type
+        InverseTransformSampling<T, Dim, Distribution, ExecSpace>::setLocalRegion(
+            const vector_type& locrmin, const vector_type& locrmax, size_type totalNum) {
+            locrmin_m = locrmin;
+            locrmax_m = locrmax;
+            evaluateCDF(locrmin_m, locrmax_m, umin_m, umax_m);
+
+            // the probability of the local region
+            double fraction = 1;
+            for (unsigned d = 0; d < Dim; ++d) {
+                fraction *= (umax_m[d] - umin_m[d]) / (cdfMax_m[d] - cdfMin_m[d]);
+            }
+
+            size_type nloc = static_cast<size_type>(fraction * totalNum);
+            size_type nsum = 0;
+            MPI_Allreduce(&nloc, &nsum, 1, MPI_UNSIGNED_LONG, MPI_SUM, Comm->getCommunicator());
+
+            // the particles lost to rounding go to the first ranks; if the rounded
+            // probabilities add up to more than one, the ranks keep their share in
+            // rank order until the total is reached
+            const long long rest = static_cast<long long>(totalNum) - static_cast<long long>(nsum);
+            const int nRanks     = Comm->size(), rank = Comm->rank();
+            if (rest >= 0) {
+                nloc += rest / nRanks + (rank < rest % nRanks);
+            } else {
+                size_type before = 0;
+                MPI_Exscan(&nloc, &before, 1, MPI_UNSIGNED_LONG, MPI_SUM,
+                           Comm->getCommunicator());
+                // the result is undefined on the first rank
+                if (rank == 0) {
+                    before = 0;
+                }
+                nloc = before < totalNum ? std::min(nloc, totalNum - before) : 0;
+            }
+            return nloc;
+        }
+
+        template <typename T, unsigned Dim, class Distribution, class ExecSpace>
+        template <class Attrib>
+        void InverseTransformSampling<T, Dim, Distribution, ExecSpace>::generate(
+            Attrib& attrib, size_type count, size_type first) const {
+            static IpplTimings::TimerRef sampleTimer =
+                IpplTimings::getTimer("inverseTransformSampling");
+            IpplTimings::startTimer(sampleTimer);
+
+            auto view                     = attrib.getView();
+            const distribution_array dist = dist_m;
+            const vector_type lo = locrmin_m, hi = locrmax_m;
+            const vector_type umin = umin_m, umax = umax_m;
+            const std::uint64_t seed =
+                detail::splitmix64(seed_m ^ detail::splitmix64(Comm->rank()));
+
+            Kokkos::parallel_for(
+                "InverseTransformSampling::generate",
+                Kokkos::RangePolicy<execution_space>(first, first + count),
+                KOKKOS_LAMBDA(const size_t i) {
+                    generator_type gen(detail::splitmix64(seed + i));
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        const T u  = gen.drand(umin[d], umax[d]);
+                        view(i)[d] = detail::invertCDF(dist[d], u, lo[d], hi[d], umin[d], umax[d]);
+                    }
+                });
+            Kokkos::fence();
+
+            IpplTimings::stopTimer(sampleTimer);
+        }
+    }  // namespace random
+}  // namespace ippl
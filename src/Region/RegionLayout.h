@@ -18,6 +18,11 @@
 //   so that if we must repartition the copy of the FieldLayout that
 //   is stored here, we will end up repartitioning all the registered Fields.
 //
+//   Whenever the domain changes, the local regions are additionally arranged
+//   into a binary tree of axis-aligned cut planes (as produced e.g. by ORB or
+//   a uniform partitioning), so that the rank owning a position can be found
+//   in O(log P) instead of testing all P regions.
+//
 // Copyright (c) 2020, Paul Scherrer Institut, Villigen PSI, Switzerland
 // All rights reserved
 //
@@ -35,6 +40,7 @@
 #define IPPL_REGION_LAYOUT_H
 
 #include <array>
+#include <vector>
 
 #include "Types/ViewTypes.h"
 
@@ -45,6 +51,45 @@
 namespace ippl {
     namespace detail {
 
+        /*!
+         * Interior node of the region partition tree. Positions with a coordinate
+         * along the cut axis smaller than the cut value descend into the lower child,
+         * all others into the upper child. Non-negative child indices refer to
+         * other nodes, negative ones encode the leaf region -(rank + 1).
+         * @tparam T the coordinate type
+         */
+        template <typename T>
+        struct RegionCut {
+            unsigned axis;
+            T cut;
+            int lower;
+            int upper;
+        };
+
+        /*!
+         * Device-callable functor returning the rank whose region contains
+         * a given position by descending the region partition tree
+         * @tparam T the coordinate type
+         * @tparam View the view type holding the tree nodes
+         */
+        template <typename T, class View>
+        struct RegionLocator {
+            View nodes_m;
+
+            template <typename Position>
+            KOKKOS_INLINE_FUNCTION int operator()(const Position& pos) const {
+                if (nodes_m.extent(0) == 0) {
+                    return 0;
+                }
+                int node = 0;
+                while (node >= 0) {
+                    const RegionCut<T>& n = nodes_m(node);
+                    node                  = (pos[n.axis] < n.cut) ? n.lower : n.upper;
+                }
+                return -node - 1;
+            }
+        };
+
         template <typename T, unsigned Dim, class Mesh, class... Properties>
         class RegionLayout {
             template <typename... Props>
@@ -57,6 +102,10 @@ namespace ippl {
 
             using uniform_type = typename CreateUniformType<base_type, view_type>::type;
 
+            using cut_type     = RegionCut<T>;
+            using tree_type    = typename ViewType<cut_type, 1, Properties...>::view_type;
+            using locator_type = RegionLocator<T, tree_type>;
+
             // Default constructor.  To make this class actually work, the user
             // will have to later call 'changeDomain' to set the proper Domain
             // and get a new partitioning.
@@ -79,10 +128,42 @@ namespace ippl {
 
             void changeDomain(const FieldLayout<Dim>&, const Mesh& mesh);  // previously private...
 
+            /*!
+             * @return Whether the local regions could be arranged into a
+             * partition tree, i.e. whether getLocator() may be used
+             */
+            bool hasPartitionTree() const { return hasTree_m; }
+
+            /*!
+             * @return A functor mapping a position to the rank owning it in
+             * O(log P); only valid if hasPartitionTree() is true
+             */
+            locator_type getLocator() const { return locator_type{dTree_m}; }
+
         private:
             NDRegion_t convertNDIndex(const NDIndex<Dim>&, const Mesh& mesh) const;
             void fillRegions(const FieldLayout<Dim>&, const Mesh& mesh);
 
+            /*!
+             * Arranges the local regions into a tree of axis-aligned cuts and
+             * copies it to the device. If the regions cannot be separated by
+             * such cuts, no tree is built.
+             */
+            void buildPartitionTree();
+
+            /*!
+             * Recursively splits a set of regions at the most balanced
+             * axis-aligned cut separating them
+             * @param first iterator to the first region index of the set
+             * @param last iterator past the last region index of the set
+             * @param nodes the tree nodes created so far
+             * @param child the encoded index of the created node or leaf
+             * @return Whether the set could be split all the way down to single regions
+             */
+            bool splitRegions(typename std::vector<int>::iterator first,
+                              typename std::vector<int>::iterator last,
+                              std::vector<cut_type>& nodes, int& child) const;
+
             //! Offset from 'normal' Index space to 'Mesh' Index space
             std::array<int, Dim> indexOffset_m;
 
@@ -98,6 +179,11 @@ namespace ippl {
             host_mirror_type hLocalRegions_m;
 
             view_type subdomains_m;
+
+            //! region partition tree (device view)
+            tree_type dTree_m;
+
+            bool hasTree_m = false;
         };
 
         template <typename T, unsigned Dim, class Mesh>
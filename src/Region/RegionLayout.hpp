@@ -31,6 +31,10 @@
 // You should have received a copy of the GNU General Public License
 // along with IPPL. If not, see <https://www.gnu.org/licenses/>.
 //
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
 namespace ippl {
     namespace detail {
         template <typename T, unsigned Dim, class Mesh, class... Properties>
@@ -105,6 +109,87 @@ namespace ippl {
             }
 
             Kokkos::deep_copy(dLocalRegions_m, hLocalRegions_m);
+
+            buildPartitionTree();
+        }
+
+        template <typename T, unsigned Dim, class Mesh, class... Properties>
+        void RegionLayout<T, Dim, Mesh, Properties...>::buildPartitionTree() {
+            std::vector<int> ids(hLocalRegions_m.size());
+            std::iota(ids.begin(), ids.end(), 0);
+
+            std::vector<cut_type> nodes;
+            int root  = 0;
+            hasTree_m = !ids.empty() && splitRegions(ids.begin(), ids.end(), nodes, root);
+
+            if (!hasTree_m) {
+                nodes.clear();
+            }
+
+            Kokkos::realloc(dTree_m, nodes.size());
+            auto hTree = Kokkos::create_mirror_view(dTree_m);
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                hTree(i) = nodes[i];
+            }
+            Kokkos::deep_copy(dTree_m, hTree);
+        }
+
+        template <typename T, unsigned Dim, class Mesh, class... Properties>
+        bool RegionLayout<T, Dim, Mesh, Properties...>::splitRegions(
+            typename std::vector<int>::iterator first, typename std::vector<int>::iterator last,
+            std::vector<cut_type>& nodes, int& child) const {
+            const long n = last - first;
+            if (n == 1) {
+                child = -(*first + 1);
+                return true;
+            }
+
+            // find the axis-aligned cut separating the regions into two sets
+            // whose sizes differ the least; after sorting the regions by their
+            // lower bound, a cut exists wherever all preceding regions end
+            // before the next one starts
+            long bestSplit    = 0;
+            long bestBalance  = n + 1;
+            unsigned bestAxis = 0;
+            for (unsigned d = 0; d < Dim; ++d) {
+                std::sort(first, last, [&](int a, int b) {
+                    return hLocalRegions_m(a)[d].min() < hLocalRegions_m(b)[d].min();
+                });
+
+                T upper = std::numeric_limits<T>::lowest();
+                for (long k = 1; k < n; ++k) {
+                    upper = std::max(upper, hLocalRegions_m(first[k - 1])[d].max());
+                    if (upper <= hLocalRegions_m(first[k])[d].min()) {
+                        long balance = std::abs(2 * k - n);
+                        if (balance < bestBalance) {
+                            bestBalance = balance;
+                            bestSplit   = k;
+                            bestAxis    = d;
+                        }
+                    }
+                }
+            }
+
+            if (bestSplit == 0) {
+                return false;
+            }
+
+            std::sort(first, last, [&](int a, int b) {
+                return hLocalRegions_m(a)[bestAxis].min() < hLocalRegions_m(b)[bestAxis].min();
+            });
+
+            child = nodes.size();
+            nodes.push_back(cut_type{bestAxis, hLocalRegions_m(first[bestSplit])[bestAxis].min(),
+                                     0, 0});
+
+            int lower, upper;
+            if (!splitRegions(first, first + bestSplit, nodes, lower)
+                || !splitRegions(first + bestSplit, last, nodes, upper)) {
+                return false;
+            }
+            nodes[child].lower = lower;
+            nodes[child].upper = upper;
+            return true;
         }
 
         template <typename T, unsigned Dim, class Mesh, class... Properties>
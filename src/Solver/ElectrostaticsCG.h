@@ -84,6 +84,7 @@ namespace ippl {
         virtual void setDefaultParameters() override {
             this->params_m.add("max_iterations", 1000);
             this->params_m.add("tolerance", (Tlhs)1e-13);
+            this->params_m.add("overlap_halo", true);
         }
     };
 
@@ -8,6 +8,15 @@
 //   where ke = Coulomb constant,
 //         alpha = controls long-range interaction.
 //
+//   solve(bunch, Q, E) computes the complete P3M field at the particle
+//   positions: the charges are scattered onto the mesh, the long-range field is
+//   computed with the FFT and gathered, and the short-range remainder
+//      ke * q * (erfc(alpha * r) / r^2 + 2 alpha / sqrt(pi) * exp(-alpha^2 r^2) / r)
+//   is added for all pairs within the interaction radius. Pairs with particles
+//   of other ranks and periodic images use the ghosts of the ParticleSpatialLayout.
+//   The splitting parameter alpha trades mesh resolution against the number of
+//   pairs; erfc(alpha * interaction_radius) estimates the truncation error.
+//
 // Copyright (c) 2023, Sonali Mayani,
 // Paul Scherrer Institut, Villigen PSI, Switzerland
 // All rights reserved
@@ -29,6 +38,7 @@
 #include "Types/Vector.h"
 
 #include "Field/Field.h"
+#include "Particle/NeighborList.h"
 
 #include "Electrostatics.h"
 #include "FFT/FFT.h"
@@ -63,6 +73,9 @@ namespace ippl {
         // define type for field layout
         typedef FieldLayout<Dim> FieldLayout_t;
 
+        // define a type for the neighbor list of the short-range interactions
+        typedef NeighborList<Trhs, Dim> NeighborList_t;
+
         // constructor and destructor
         P3MSolver();
         P3MSolver(rhs_type& rhs, ParameterList& params);
@@ -77,6 +90,27 @@ namespace ippl {
         // more specifically, compute the scalar potential given a density field rho
         void solve() override;
 
+        /*!
+         * Compute the electric field at the particle positions, i.e. the mesh
+         * field plus the short-range pair correction. The LHS must be set and the
+         * output type must include GRAD; the RHS is overwritten with the charge density.
+         * @param bunch the particles; its layout must be a ParticleSpatialLayout
+         * @param Q the particle charges
+         * @param E the electric field at the particle positions (output)
+         */
+        template <class Bunch, class ChargeAttrib, class FieldAttrib>
+        void solve(Bunch& bunch, const ChargeAttrib& Q, FieldAttrib& E);
+
+        /*!
+         * Add the short-range field of all pairs within the interaction radius,
+         * including the ghosts of other ranks and periodic images
+         * @param bunch the particles; its layout must be a ParticleSpatialLayout
+         * @param Q the particle charges
+         * @param E the electric field at the particle positions (input/output)
+         */
+        template <class Bunch, class ChargeAttrib, class FieldAttrib>
+        void addPairForces(Bunch& bunch, const ChargeAttrib& Q, FieldAttrib& E);
+
         // function called in the constructor to initialize the fields
         void initializeFields();
 
@@ -112,6 +146,12 @@ namespace ippl {
         Vector_t hr_m;
         Vector<int, Dim> nr_m;
 
+        // the splitting parameter the Green's function was computed with
+        Trhs alpha_m;
+
+        // the neighbor list of the short-range interactions, built on first use
+        std::unique_ptr<NeighborList_t> neighborList_m;
+
     protected:
         virtual void setDefaultParameters() override {
             using heffteBackend       = typename FFT_t::heffteBackend;
@@ -121,6 +161,11 @@ namespace ippl {
             this->params_m.add("use_gpu_aware", opts.use_gpu_aware);
             this->params_m.add("r2c_direction", 0);
 
+            // splitting between the mesh and the particle-particle interactions
+            this->params_m.add("alpha", (Trhs)1e6);
+            this->params_m.add("interaction_radius", (Trhs)0);
+            this->params_m.add("skin", (Trhs)0);
+
             switch (opts.algorithm) {
                 case heffte::reshape_algorithm::alltoall:
                     this->params_m.add("comm", a2a);
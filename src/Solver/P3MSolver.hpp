@@ -219,6 +219,11 @@ namespace ippl {
             }
         }
 
+        // the splitting parameter may have been changed as well
+        if (alpha_m != this->params_m.template get<Trhs>("alpha")) {
+            green = true;
+        }
+
         // set mesh spacing on the other grids again
         meshComplex_m->setMeshSpacing(hr_m);
 
@@ -330,7 +335,8 @@ namespace ippl {
         // for the P3M collision modelling method, it indicates
         // the splitting between Particle-Particle interactions
         // and the Particle-Mesh computations).
-        Trhs alpha = 1e6;
+        const Trhs alpha = this->params_m.template get<Trhs>("alpha");
+        alpha_m          = alpha;
 
         // calculate square of the mesh spacing for each dimension
         Vector_t hrsq(hr_m * hr_m);
@@ -363,4 +369,97 @@ namespace ippl {
         fft_m->transform(+1, grn_m, grntr_m);
     };
 
+    /////////////////////////////////////////////////////////////////////////
+    // compute the electric field at the particle positions
+
+    template <typename FieldLHS, typename FieldRHS>
+    template <class Bunch, class ChargeAttrib, class FieldAttrib>
+    void P3MSolver<FieldLHS, FieldRHS>::solve(Bunch& bunch, const ChargeAttrib& Q,
+                                              FieldAttrib& E) {
+        const int out = this->params_m.template get<int>("output_type");
+        if ((out & Base::GRAD) == 0) {
+            throw IpplException("P3MSolver::solve",
+                                "The particle solve requires the output type to include GRAD.");
+        }
+
+        // charge density on the mesh
+        const Vector_t hr = this->rhs_mp->get_mesh().getMeshSpacing();
+        *(this->rhs_mp)   = 0.0;
+        Q.scatter(*(this->rhs_mp), bunch.R);
+        *(this->rhs_mp) = *(this->rhs_mp) / (hr[0] * hr[1] * hr[2]);
+
+        // long-range field on the mesh, interpolated to the particles
+        solve();
+        E.gather(*(this->lhs_mp), bunch.R);
+
+        addPairForces(bunch, Q, E);
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // add the short-range part of the pair interactions
+
+    template <typename FieldLHS, typename FieldRHS>
+    template <class Bunch, class ChargeAttrib, class FieldAttrib>
+    void P3MSolver<FieldLHS, FieldRHS>::addPairForces(Bunch& bunch, const ChargeAttrib& Q,
+                                                      FieldAttrib& E) {
+        const Trhs alpha  = this->params_m.template get<Trhs>("alpha");
+        const Trhs radius = this->params_m.template get<Trhs>("interaction_radius");
+        const Trhs skin   = this->params_m.template get<Trhs>("skin");
+        if (radius <= 0) {
+            throw IpplException("P3MSolver::addPairForces",
+                                "The interaction radius must be positive.");
+        }
+
+        static IpplTimings::TimerRef pairTimer = IpplTimings::getTimer("P3M pair forces");
+        IpplTimings::startTimer(pairTimer);
+
+        // copies of the particles of other ranks and of the periodic images
+        auto& layout = bunch.getLayout();
+        layout.updateGhosts(bunch, radius, skin);
+
+        typename Bunch::Layout_t::template ghost_view_type<ChargeAttrib> qGhosts;
+        layout.exchangeGhosts(Q, qGhosts);
+
+        // every rank computes the pairs of its own particles, so the full list
+        // lets each thread update one particle only and no atomics are needed
+        if (!neighborList_m || neighborList_m->getCutoff() != radius
+            || neighborList_m->getSkin() != skin) {
+            neighborList_m =
+                std::make_unique<NeighborList_t>(radius, skin, NeighborListType::Full);
+        }
+        neighborList_m->update(bunch);
+
+        const auto qView      = Q.getView();
+        auto eView            = E.getView();
+        const size_t nLocal   = bunch.getLocalNum();
+        const Trhs pi         = Kokkos::numbers::pi_v<Trhs>;
+        const Trhs ke         = 1.0 / (4.0 * pi);
+        const Trhs gaussCoeff = 2.0 * alpha / Kokkos::sqrt(pi);
+
+        neighborList_m->for_each_pair(
+            bunch, radius, KOKKOS_LAMBDA(const size_t i, const size_t j, const Vector_t& dist) {
+                Trhs r2 = 0;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    r2 += dist[d] * dist[d];
+                }
+                if (r2 == 0) {
+                    return;
+                }
+
+                const Trhs r  = Kokkos::sqrt(r2);
+                const Trhs qj = j < nLocal ? qView(j) : qGhosts(j - nLocal);
+
+                // the part of the Coulomb field not represented by erf(alpha * r) / r
+                const Trhs f = ke * qj
+                               * (Kokkos::erfc(alpha * r) / r2
+                                  + gaussCoeff * Kokkos::exp(-alpha * alpha * r2) / r)
+                               / r;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    eView(i)[d] += f * dist[d];
+                }
+            });
+
+        IpplTimings::stopTimer(pairTimer);
+    }
+
 }  // namespace ippl
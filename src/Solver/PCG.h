@@ -53,6 +53,7 @@ namespace ippl {
 
             iterations_m            = 0;
             const int maxIterations = params.get<int>("max_iterations");
+            const bool overlapHalo  = params.get<bool>("overlap_halo");
 
             // Variable names mostly based on description in
             // https://www.cs.cmu.edu/~quake-papers/painless-conjugate-gradient.pdf
@@ -92,7 +93,12 @@ namespace ippl {
             lhs_type q(mesh, layout);
 
             while (iterations_m < maxIterations && residueNorm > tolerance) {
-                q       = op_m(d);
+                if (overlapHalo) {
+                    // apply the operator to the interior while the halo of d is exchanged
+                    assignOverlapped(q, d, op_m);
+                } else {
+                    q = op_m(d);
+                }
                 T alpha = delta1 / innerProduct(d, q);
                 lhs     = lhs + alpha * d;
 
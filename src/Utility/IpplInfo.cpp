@@ -42,6 +42,8 @@ void IpplInfo::printHelp(char** argv) {
     std::cout << "   --timer-fences <on|off>     : Enable or disable timer fences (default enabled "
                  "if only "
                  "one accelerator present)\n";
+    std::cout << "   --halo-exchange <mode>      : Exchange halo cells with all neighbors at once "
+                 "(neighbor, default) or one dimension after the other (sweep)\n";
     std::cout << "   --help                      : Print IPPL help message\n";
     std::cout << "   --kokkos-help               : Print Kokkos help message\n";
 }
@@ -0,0 +1,169 @@
+//
+// Benchmark Halo
+//   Compares the halo exchange with all face, edge and vertex neighbors to the
+//   dimension-by-dimension sweep, which sends messages to the face neighbors only.
+//   Each global grid size is decomposed over all ranks, so that the local
+//   subdomain shrinks with the grid; fillHalo and accumulateHalo are timed in
+//   both modes. Finally, the halos of a scalar and a vector field are filled
+//   one after the other and in one batch (see ippl::fillHalo).
+//   Usage:
+//     srun ./benchmarkHalo 100 16 32 64 128 256 [periodic] --info 5
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Ippl.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+constexpr unsigned Dim = 3;
+
+using Mesh_t        = ippl::UniformCartesian<double, Dim>;
+using Centering_t   = Mesh_t::DefaultCentering;
+using FieldLayout_t = ippl::FieldLayout<Dim>;
+using Vector_t      = ippl::Vector<double, Dim>;
+using Field_t       = ippl::Field<double, Dim, Mesh_t, Centering_t>;
+using VField_t      = ippl::Field<Vector_t, Dim, Mesh_t, Centering_t>;
+
+/*!
+ * Time nt halo exchanges of one kind
+ * @return The elapsed time per exchange in seconds
+ */
+template <class Exchange>
+double timeExchange(Exchange&& exchange, unsigned nt) {
+    ippl::Comm->barrier();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (unsigned it = 0; it < nt; ++it) {
+        exchange();
+    }
+    Kokkos::fence();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double elapsed = std::chrono::duration<double>(end - start).count() / nt;
+    double maxElapsed;
+    MPI_Allreduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, ippl::Comm->getCommunicator());
+    return maxElapsed;
+}
+
+int main(int argc, char* argv[]) {
+    ippl::initialize(argc, argv);
+    {
+        Inform msg(argv[0]);
+
+        const unsigned nt = std::atoi(argv[1]);
+        std::vector<int> sizes;
+        bool periodic = false;
+        for (int i = 2; i < argc; ++i) {
+            if (std::strcmp(argv[i], "periodic") == 0) {
+                periodic = true;
+            } else if (argv[i][0] != '-') {
+                sizes.push_back(std::atoi(argv[i]));
+            } else {
+                // skip the IPPL and Kokkos options
+                break;
+            }
+        }
+
+        msg << "benchmarkHalo" << endl
+            << "nt " << nt << " ranks = " << ippl::Comm->size()
+            << " periodic = " << (periodic ? "yes" : "no") << endl;
+
+        for (int n : sizes) {
+            ippl::NDIndex<Dim> domain;
+            ippl::e_dim_tag decomp[Dim];
+            Vector_t hr;
+            for (unsigned d = 0; d < Dim; d++) {
+                domain[d] = ippl::Index(n);
+                decomp[d] = ippl::PARALLEL;
+                hr[d]     = 1.0 / n;
+            }
+            Vector_t origin = 0.0;
+
+            Mesh_t mesh(domain, hr, origin);
+            FieldLayout_t FL(domain, decomp, periodic);
+
+            Field_t neighbor(mesh, FL), sweep(mesh, FL);
+            neighbor.setHaloExchange(ippl::HaloExchange::NEIGHBOR);
+            sweep.setHaloExchange(ippl::HaloExchange::SWEEP);
+            neighbor = 1.0;
+            sweep    = 1.0;
+
+            size_t nNeighbors = 0;
+            for (const auto& ranks : FL.getNeighbors()) {
+                nNeighbors += ranks.size();
+            }
+            size_t nFaces = 0;
+            for (const auto& ranks : FL.getSweepNeighbors()) {
+                nFaces += ranks.size();
+            }
+
+            // the first exchange builds the communication schedules
+            neighbor.fillHalo();
+            sweep.fillHalo();
+
+            double fillNeighbor = timeExchange(
+                [&]() {
+                    neighbor.fillHalo();
+                },
+                nt);
+            double fillSweep = timeExchange(
+                [&]() {
+                    sweep.fillHalo();
+                },
+                nt);
+            double accumulateNeighbor = timeExchange(
+                [&]() {
+                    neighbor.accumulateHalo();
+                },
+                nt);
+            double accumulateSweep = timeExchange(
+                [&]() {
+                    sweep.accumulateHalo();
+                },
+                nt);
+
+            VField_t vector(mesh, FL);
+            vector = Vector_t(1.0);
+            vector.fillHalo();
+            ippl::fillHalo(neighbor, vector);
+            double fillSeparate = timeExchange(
+                [&]() {
+                    neighbor.fillHalo();
+                    vector.fillHalo();
+                },
+                nt);
+            double fillBatched = timeExchange(
+                [&]() {
+                    ippl::fillHalo(neighbor, vector);
+                },
+                nt);
+
+            msg << "grid " << n << "^3, local domain " << FL.getLocalNDIndex() << endl
+                << "  messages on rank 0: neighbor " << nNeighbors << ", sweep " << nFaces << endl
+                << "  fillHalo:       neighbor " << fillNeighbor << " s, sweep " << fillSweep
+                << " s, speedup " << fillNeighbor / fillSweep << endl
+                << "  accumulateHalo: neighbor " << accumulateNeighbor << " s, sweep "
+                << accumulateSweep << " s, speedup " << accumulateNeighbor / accumulateSweep
+                << endl
+                << "  scalar + vector fillHalo: separate " << fillSeparate << " s, batched "
+                << fillBatched << " s, speedup " << fillSeparate / fillBatched << endl;
+        }
+    }
+    ippl::finalize();
+
+    return 0;
+}
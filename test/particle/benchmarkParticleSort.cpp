@@ -0,0 +1,169 @@
+//
+// Benchmark ParticleSort
+//   Measures the effect of sorting the particles by mesh cell on the
+//   CIC scatter and gather. The particles are initialized uniformly at
+//   random, i.e. in the worst possible memory order; the scatter and gather
+//   are timed before and after sorting the bunch.
+//   Usage:
+//     srun ./benchmarkParticleSort 128 128 128 10000000 10 [morton] --info 10
+//
+// Copyright (c) 2020, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Ippl.h"
+
+#include <Kokkos_Random.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "Utility/IpplTimings.h"
+
+constexpr unsigned Dim = 3;
+
+using PLayout_t     = ippl::ParticleSpatialLayout<double, Dim>;
+using Mesh_t        = ippl::UniformCartesian<double, Dim>;
+using Centering_t   = Mesh_t::DefaultCentering;
+using FieldLayout_t = ippl::FieldLayout<Dim>;
+using Vector_t      = ippl::Vector<double, Dim>;
+using Field_t       = ippl::Field<double, Dim, Mesh_t, Centering_t>;
+
+template <class PLayout>
+struct Bunch : public ippl::ParticleBase<PLayout> {
+    Bunch(PLayout& playout)
+        : ippl::ParticleBase<PLayout>(playout) {
+        this->addAttribute(Q);
+        this->addAttribute(P);
+        this->addAttribute(phi);
+    }
+
+    ~Bunch() {}
+
+    ippl::ParticleAttrib<double> Q;
+    typename ippl::ParticleBase<PLayout>::particle_position_type P;
+    ippl::ParticleAttrib<double> phi;
+};
+
+/*!
+ * Time nt scatters and gathers
+ * @return The elapsed time in seconds
+ */
+template <class Bunch>
+double scatterGather(Bunch& bunch, Field_t& field, unsigned nt) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (unsigned it = 0; it < nt; ++it) {
+        field = 0.0;
+        scatter(bunch.Q, field, bunch.R);
+        gather(bunch.phi, field, bunch.R);
+    }
+    Kokkos::fence();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double elapsed = std::chrono::duration<double>(end - start).count();
+    double maxElapsed;
+    MPI_Allreduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, ippl::Comm->getCommunicator());
+    return maxElapsed;
+}
+
+int main(int argc, char* argv[]) {
+    ippl::initialize(argc, argv);
+    {
+        Inform msg(argv[0]);
+
+        ippl::Vector<int, Dim> nr = {std::atoi(argv[1]), std::atoi(argv[2]), std::atoi(argv[3])};
+        const size_t totalP       = std::atol(argv[4]);
+        const unsigned nt         = std::atoi(argv[5]);
+
+        ippl::SortOrder order = ippl::SortOrder::Lexicographic;
+        if (argc > 6 && std::string(argv[6]) == "morton") {
+            order = ippl::SortOrder::Morton;
+        }
+
+        msg << "benchmarkParticleSort" << endl
+            << "nt " << nt << " Np= " << totalP << " grid = " << nr
+            << " order = " << (order == ippl::SortOrder::Morton ? "Morton" : "lexicographic")
+            << endl;
+
+        ippl::NDIndex<Dim> domain;
+        ippl::e_dim_tag decomp[Dim];
+        Vector_t hr;
+        for (unsigned d = 0; d < Dim; d++) {
+            domain[d] = ippl::Index(nr[d]);
+            decomp[d] = ippl::PARALLEL;
+            hr[d]     = 1.0 / nr[d];
+        }
+        Vector_t origin = 0.0;
+
+        Mesh_t mesh(domain, hr, origin);
+        FieldLayout_t FL(domain, decomp);
+        PLayout_t PL(FL, mesh);
+
+        Field_t field(mesh, FL);
+
+        Bunch<PLayout_t> bunch(PL);
+        bunch.setParticleBC(ippl::BC::PERIODIC);
+
+        // place the particles uniformly in the local domain
+        const ippl::NDIndex<Dim>& lDom = FL.getLocalNDIndex();
+        Vector_t rmin, rmax;
+        for (unsigned d = 0; d < Dim; d++) {
+            rmin[d] = lDom[d].first() * hr[d];
+            rmax[d] = (lDom[d].last() + 1) * hr[d];
+        }
+
+        size_t nloc = totalP / ippl::Comm->size();
+        bunch.create(nloc);
+
+        Kokkos::Random_XorShift64_Pool<> pool(42 + ippl::Comm->rank());
+        auto R = bunch.R.getView();
+        Kokkos::parallel_for(
+            "Initialize positions", nloc, KOKKOS_LAMBDA(const size_t i) {
+                auto generator = pool.get_state();
+                for (unsigned d = 0; d < Dim; d++) {
+                    R(i)[d] = generator.drand(rmin[d], rmax[d]);
+                }
+                pool.free_state(generator);
+            });
+        Kokkos::fence();
+        bunch.Q   = 1.0 / totalP;
+        bunch.P   = 0.0;
+        bunch.phi = 0.0;
+
+        // warm up
+        scatterGather(bunch, field, 1);
+
+        double unsorted = scatterGather(bunch, field, nt);
+        msg << "disorder before sorting: " << bunch.sortDisorder(mesh, FL, order) << endl;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        bunch.sort(mesh, FL, order);
+        Kokkos::fence();
+        double sortTime =
+            std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start)
+                .count();
+
+        double sorted = scatterGather(bunch, field, nt);
+
+        msg << "scatter + gather unsorted: " << unsorted / nt << " s per step" << endl
+            << "scatter + gather sorted:   " << sorted / nt << " s per step" << endl
+            << "sort:                      " << sortTime << " s" << endl
+            << "speedup: " << unsorted / sorted << endl;
+
+        IpplTimings::print();
+        IpplTimings::print(std::string("timing.dat"));
+    }
+    ippl::finalize();
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+//
+// Benchmark Push
+//   Measures the throughput of the fused leapfrog push and of the drift
+//   with the particle momenta and positions stored as array of structs
+//   (ParticleAttrib<Vector>) and as structure of arrays (SoAParticleAttrib).
+//   Both bunches start from the same particles and their results are compared.
+//   Usage:
+//     srun ./benchmarkPush 128 128 128 10000000 10 --info 10
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Ippl.h"
+
+#include <Kokkos_Random.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "Utility/IpplTimings.h"
+
+constexpr unsigned Dim = 3;
+
+using PLayout_t     = ippl::ParticleSpatialLayout<double, Dim>;
+using Mesh_t        = ippl::UniformCartesian<double, Dim>;
+using Centering_t   = Mesh_t::DefaultCentering;
+using FieldLayout_t = ippl::FieldLayout<Dim>;
+using Vector_t      = ippl::Vector<double, Dim>;
+using VField_t      = ippl::Field<Vector_t, Dim, Mesh_t, Centering_t>;
+
+template <class PLayout>
+struct Bunch : public ippl::ParticleBase<PLayout> {
+    Bunch(PLayout& playout)
+        : ippl::ParticleBase<PLayout>(playout) {
+        this->addAttribute(P);
+        this->addAttribute(Rsoa);
+        this->addAttribute(Psoa);
+    }
+
+    ~Bunch() {}
+
+    // array of structs
+    ippl::ParticleAttrib<Vector_t> P;
+
+    // structure of arrays; the positions ParticleBase::R are always a
+    // ParticleAttrib because the layout relies on its view, so the copy in
+    // Rsoa is only pushed and never relocated
+    ippl::SoAParticleAttrib<double, Dim> Rsoa;
+    ippl::SoAParticleAttrib<double, Dim> Psoa;
+};
+
+/*!
+ * Time nt calls of a push and print the throughput
+ */
+template <typename Push>
+void benchmark(Inform& msg, const std::string& name, size_t totalP, unsigned nt, Push&& push) {
+    // warm up
+    push();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (unsigned it = 0; it < nt; ++it) {
+        push();
+    }
+    Kokkos::fence();
+    double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start)
+                         .count();
+
+    double maxElapsed;
+    MPI_Allreduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, ippl::Comm->getCommunicator());
+
+    msg << name << ": " << maxElapsed / nt << " s per push, " << totalP * nt / maxElapsed
+        << " particles/s" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    ippl::initialize(argc, argv);
+    {
+        Inform msg(argv[0]);
+
+        ippl::Vector<int, Dim> nr = {std::atoi(argv[1]), std::atoi(argv[2]), std::atoi(argv[3])};
+        const size_t totalP       = std::atol(argv[4]);
+        const unsigned nt         = std::atoi(argv[5]);
+
+        msg << "benchmarkPush" << endl
+            << "nt " << nt << " Np= " << totalP << " grid = " << nr << endl;
+
+        ippl::NDIndex<Dim> domain;
+        ippl::e_dim_tag decomp[Dim];
+        Vector_t hr;
+        for (unsigned d = 0; d < Dim; d++) {
+            domain[d] = ippl::Index(nr[d]);
+            decomp[d] = ippl::PARALLEL;
+            hr[d]     = 1.0 / nr[d];
+        }
+        Vector_t origin = 0.0;
+
+        Mesh_t mesh(domain, hr, origin);
+        FieldLayout_t FL(domain, decomp);
+        PLayout_t PL(FL, mesh);
+
+        VField_t E(mesh, FL);
+        E = Vector_t(1.0);
+
+        Bunch<PLayout_t> bunch(PL);
+
+        // place the particles uniformly in the local domain
+        const ippl::NDIndex<Dim>& lDom = FL.getLocalNDIndex();
+        Vector_t rmin, rmax;
+        for (unsigned d = 0; d < Dim; d++) {
+            rmin[d] = lDom[d].first() * hr[d];
+            rmax[d] = (lDom[d].last() + 1) * hr[d];
+        }
+
+        size_t nloc = totalP / ippl::Comm->size();
+        bunch.create(nloc);
+
+        Kokkos::Random_XorShift64_Pool<> pool(42 + ippl::Comm->rank());
+        auto R = bunch.R.getView();
+        Kokkos::parallel_for(
+            "Initialize positions", nloc, KOKKOS_LAMBDA(const size_t i) {
+                auto generator = pool.get_state();
+                for (unsigned d = 0; d < Dim; d++) {
+                    R(i)[d] = generator.drand(rmin[d], rmax[d]);
+                }
+                pool.free_state(generator);
+            });
+        Kokkos::fence();
+        bunch.P    = 0.0;
+        bunch.Rsoa = bunch.R;
+        bunch.Psoa = bunch.P;
+
+        // the particles hardly move, so that they stay within the local field
+        const double dt = 1e-9;
+
+        ippl::ParticlePusher<ippl::Leapfrog<>> pusher;
+
+        benchmark(msg, "kickDrift AoS", totalP, nt,
+                  [&]() { pusher.kickDrift(E, bunch.P, bunch.R, dt, dt); });
+        benchmark(msg, "kickDrift SoA", totalP, nt,
+                  [&]() { pusher.kickDrift(E, bunch.Psoa, bunch.Rsoa, dt, dt); });
+        benchmark(msg, "drift AoS    ", totalP, nt, [&]() { pusher.drift(bunch.P, bunch.R, dt); });
+        benchmark(msg, "drift SoA    ", totalP, nt,
+                  [&]() { pusher.drift(bunch.Psoa, bunch.Rsoa, dt); });
+
+        // both storage orders must give the same particles
+        bunch.Psoa = bunch.Psoa - bunch.P;
+        bunch.Rsoa = bunch.Rsoa - bunch.R;
+        const Vector_t dP = bunch.Psoa.max() - bunch.Psoa.min();
+        const Vector_t dR = bunch.Rsoa.max() - bunch.Rsoa.min();
+        msg << "difference of the momenta " << dP << ", of the positions " << dR << endl;
+
+        IpplTimings::print();
+        IpplTimings::print(std::string("timing.dat"));
+    }
+    ippl::finalize();
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+//
+// Benchmark Scatter
+//   Measures the throughput of the CIC scatter for every scatter strategy,
+//   once with the particles in random order and once after sorting them
+//   by cell. SortedScatter needs the sorted bunch; on the random order
+//   it falls back to atomics.
+//   Usage:
+//     srun ./benchmarkScatter 128 128 128 10000000 10 --info 10
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Ippl.h"
+
+#include <Kokkos_Random.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "Utility/IpplTimings.h"
+
+constexpr unsigned Dim = 3;
+
+using PLayout_t     = ippl::ParticleSpatialLayout<double, Dim>;
+using Mesh_t        = ippl::UniformCartesian<double, Dim>;
+using Centering_t   = Mesh_t::DefaultCentering;
+using FieldLayout_t = ippl::FieldLayout<Dim>;
+using Vector_t      = ippl::Vector<double, Dim>;
+using Field_t       = ippl::Field<double, Dim, Mesh_t, Centering_t>;
+
+template <class PLayout>
+struct Bunch : public ippl::ParticleBase<PLayout> {
+    Bunch(PLayout& playout)
+        : ippl::ParticleBase<PLayout>(playout) {
+        this->addAttribute(Q);
+    }
+
+    ~Bunch() {}
+
+    ippl::ParticleAttrib<double> Q;
+};
+
+/*!
+ * Time nt scatters with the given strategy and print the throughput
+ */
+template <class Bunch, typename Strategy>
+void benchmark(Inform& msg, const std::string& name, Bunch& bunch, Field_t& field,
+               size_t totalP, unsigned nt, const Strategy& strategy) {
+    // warm up
+    field = 0.0;
+    scatter(bunch.Q, field, bunch.R, strategy);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (unsigned it = 0; it < nt; ++it) {
+        field = 0.0;
+        scatter(bunch.Q, field, bunch.R, strategy);
+    }
+    Kokkos::fence();
+    double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start)
+                         .count();
+
+    double maxElapsed;
+    MPI_Allreduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, ippl::Comm->getCommunicator());
+
+    msg << name << ": " << maxElapsed / nt << " s per scatter, " << totalP * nt / maxElapsed
+        << " particles/s, total charge " << field.sum() << endl;
+}
+
+int main(int argc, char* argv[]) {
+    ippl::initialize(argc, argv);
+    {
+        Inform msg(argv[0]);
+
+        ippl::Vector<int, Dim> nr = {std::atoi(argv[1]), std::atoi(argv[2]), std::atoi(argv[3])};
+        const size_t totalP       = std::atol(argv[4]);
+        const unsigned nt         = std::atoi(argv[5]);
+
+        msg << "benchmarkScatter" << endl
+            << "nt " << nt << " Np= " << totalP << " grid = " << nr << endl;
+
+        ippl::NDIndex<Dim> domain;
+        ippl::e_dim_tag decomp[Dim];
+        Vector_t hr;
+        for (unsigned d = 0; d < Dim; d++) {
+            domain[d] = ippl::Index(nr[d]);
+            decomp[d] = ippl::PARALLEL;
+            hr[d]     = 1.0 / nr[d];
+        }
+        Vector_t origin = 0.0;
+
+        Mesh_t mesh(domain, hr, origin);
+        FieldLayout_t FL(domain, decomp);
+        PLayout_t PL(FL, mesh);
+
+        Field_t field(mesh, FL);
+
+        Bunch<PLayout_t> bunch(PL);
+
+        // place the particles uniformly in the local domain
+        const ippl::NDIndex<Dim>& lDom = FL.getLocalNDIndex();
+        Vector_t rmin, rmax;
+        for (unsigned d = 0; d < Dim; d++) {
+            rmin[d] = lDom[d].first() * hr[d];
+            rmax[d] = (lDom[d].last() + 1) * hr[d];
+        }
+
+        size_t nloc = totalP / ippl::Comm->size();
+        bunch.create(nloc);
+
+        Kokkos::Random_XorShift64_Pool<> pool(42 + ippl::Comm->rank());
+        auto R = bunch.R.getView();
+        Kokkos::parallel_for(
+            "Initialize positions", nloc, KOKKOS_LAMBDA(const size_t i) {
+                auto generator = pool.get_state();
+                for (unsigned d = 0; d < Dim; d++) {
+                    R(i)[d] = generator.drand(rmin[d], rmax[d]);
+                }
+                pool.free_state(generator);
+            });
+        Kokkos::fence();
+        bunch.Q = 1.0 / totalP;
+
+        for (bool sorted : {false, true}) {
+            if (sorted) {
+                bunch.sort(field);
+            }
+            msg << (sorted ? "sorted particles" : "random particles") << endl;
+
+            benchmark(msg, "  atomic    ", bunch, field, totalP, nt, ippl::AtomicScatter{});
+            benchmark(msg, "  duplicated", bunch, field, totalP, nt, ippl::DuplicatedScatter{});
+            benchmark(msg, "  sorted    ", bunch, field, totalP, nt, ippl::SortedScatter{});
+            benchmark(msg, "  tiled     ", bunch, field, totalP, nt, ippl::TiledScatter{});
+            benchmark(msg, "  default   ", bunch, field, totalP, nt, ippl::DefaultScatter{});
+        }
+
+        IpplTimings::print();
+        IpplTimings::print(std::string("timing.dat"));
+    }
+    ippl::finalize();
+
+    return 0;
+}
@@ -1,7 +1,9 @@
 // Tests the conjugate gradient solver for electrostatics problems
 // by checking the relative error from the exact solution
 // Usage:
-//      TestCGSolver [size [scaling_type]]
+//      TestCGSolver [size [scaling_type [overlap]]]
+//      overlap = 0 disables overlapping the halo exchange with the operator (default 1);
+//      comparing the "CG solve" timings of both runs on several ranks shows the gain
 
 #include "Ippl.h"
 
@@ -24,7 +26,8 @@ int main(int argc, char* argv[]) {
         using Centering_t          = Mesh_t::DefaultCentering;
 
         int pt = 4, ptY = 4;
-        bool isWeak = false;
+        bool isWeak  = false;
+        bool overlap = true;
 
         Inform info("Config");
         if (argc >= 2) {
@@ -42,8 +45,12 @@ int main(int argc, char* argv[]) {
                     info << "Performing weak scaling" << endl;
                     isWeak = true;
                 }
+                if (argc >= 4) {
+                    overlap = strtol(argv[3], NULL, 10) != 0;
+                }
             }
         }
+        info << "Halo exchange overlap " << (overlap ? "enabled" : "disabled") << endl;
 
         ippl::Index I(pt), Iy(ptY);
         ippl::NDIndex<dim> owned(I, Iy, I);
@@ -125,13 +132,17 @@ int main(int argc, char* argv[]) {
 
         ippl::ParameterList params;
         params.add("max_iterations", 2000);
+        params.add("overlap_halo", overlap);
         lapsolver.mergeParameters(params);
 
         lapsolver.setRhs(rhs);
         lapsolver.setLhs(lhs);
 
         lhs = 0;
+        static IpplTimings::TimerRef solveTimer = IpplTimings::getTimer("CG solve");
+        IpplTimings::startTimer(solveTimer);
         lapsolver.solve();
+        IpplTimings::stopTimer(solveTimer);
 
         const char* name = isWeak ? "Convergence (weak)" : "Convergence";
         Inform m(name);
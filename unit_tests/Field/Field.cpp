@@ -369,6 +369,89 @@ TYPED_TEST(FieldTest, Div) {
     this->apply(check, this->fields);
 }
 
+TYPED_TEST(FieldTest, OverlappedLaplace) {
+    auto check =
+        [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template field_type<Dim>>& field) {
+            using field_type  = typename TestFixture::template field_type<Dim>;
+            using view_type   = typename field_type::view_type;
+            using mirror_type = typename view_type::host_mirror_type;
+
+            const ippl::NDIndex<Dim> lDom = field->getLayout().getLocalNDIndex();
+            const int shift               = field->getNghost();
+
+            const ippl::Vector<TypeParam, Dim> dx = field->get_mesh().getMeshSpacing();
+            FieldVal<TypeParam, Dim> fv(field->getView(), lDom, dx, shift);
+            Kokkos::parallel_for(
+                "Set field",
+                field->template getFieldRangePolicy<typename FieldVal<TypeParam, Dim>::Integral>(),
+                fv);
+
+            field_type expected(field->get_mesh(), field->getLayout());
+            field_type result(field->get_mesh(), field->getLayout());
+            expected = laplace(*field);
+
+            // otherwise the halo cells are valid and nothing is overlapped
+            field->invalidateHalo();
+            ippl::assignOverlapped(result, *field, [](field_type& u) {
+                return laplace(u);
+            });
+            EXPECT_FALSE(field->isHaloPending());
+
+            mirror_type mirrorE = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                                      expected.getView());
+            mirror_type mirrorR = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                                      result.getView());
+
+            this->template nestedViewLoop(mirrorR, shift, [&]<typename... Idx>(const Idx... args) {
+                assertTypeParam<TypeParam>(mirrorR(args...), mirrorE(args...));
+            });
+        };
+
+    this->apply(check, this->fields);
+}
+
+TYPED_TEST(FieldTest, HaloValidity) {
+    auto check =
+        [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template field_type<Dim>>& field) {
+            using field_type  = typename TestFixture::template field_type<Dim>;
+            using vfield_type = typename TestFixture::template vfield_type<Dim>;
+
+            field_type result(field->get_mesh(), field->getLayout());
+            vfield_type vresult(field->get_mesh(), field->getLayout());
+
+            *field = 1.;
+            field->resetHaloCounters();
+            EXPECT_FALSE(field->isHaloValid());
+
+            // the halo cells are refreshed once for both operators
+            result  = laplace(*field);
+            vresult = grad(*field);
+            EXPECT_TRUE(field->isHaloValid());
+            EXPECT_EQ(field->getHaloRefreshCount(), 1u);
+            EXPECT_EQ(field->getSkippedHaloRefreshCount(), 1u);
+
+            // writing to the field invalidates them
+            *field = 2.;
+            EXPECT_FALSE(field->isHaloValid());
+            result = laplace(*field);
+            EXPECT_EQ(field->getHaloRefreshCount(), 2u);
+            EXPECT_EQ(field->getSkippedHaloRefreshCount(), 1u);
+
+            // so may any access to the view
+            field->getView();
+            EXPECT_FALSE(field->isHaloValid());
+
+            auto mirror =
+                Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), result.getView());
+            this->template nestedViewLoop(mirror, result.getNghost(),
+                                          [&]<typename... Idx>(const Idx... args) {
+                                              assertTypeParam<TypeParam>(mirror(args...), 0.);
+                                          });
+        };
+
+    this->apply(check, this->fields);
+}
+
 TYPED_TEST(FieldTest, Curl) {
     // Restrict to 3D case for now
     constexpr unsigned dim = 3;
@@ -68,6 +68,85 @@ public:
         std::get<Idx>(fields) = std::make_shared<field_type<Dim>>(mesh, layout);
     }
 
+    /*!
+     * A value for the cell with the given global index, which is exact in
+     * single precision and differs between the axes
+     */
+    template <unsigned Dim>
+    static T cellValue(const std::array<long, Dim>& index) {
+        T value = 1;
+        for (unsigned d = 0; d < Dim; d++) {
+            value += (d + 1) * (index[d] % 8);
+        }
+        return value;
+    }
+
+    static void expectCell(T actual, T expected) { assertTypeParam<T>(actual, expected); }
+
+    template <unsigned Dim>
+    static void expectCell(const ippl::Vector<T, Dim>& actual,
+                           const ippl::Vector<T, Dim>& expected) {
+        for (unsigned d = 0; d < Dim; d++) {
+            assertTypeParam<T>(actual[d], expected[d]);
+        }
+    }
+
+    /*!
+     * Call a function for every cell of a field, including the ghost cells,
+     * with the global index of the cell
+     * @param field the field
+     * @param view a host copy of the field view
+     * @param f function called with the cell, its global index, whether the
+     * cell is owned and whether it lies inside the global domain
+     */
+    template <class Field, class View, class Functor>
+    static void forCells(const Field& field, View& view, Functor&& f) {
+        constexpr unsigned Dim         = Field::dim;
+        const int nghost               = field.getNghost();
+        const ippl::NDIndex<Dim>& lDom = field.getLayout().getLocalNDIndex();
+        const ippl::NDIndex<Dim>& gDom = field.getLayout().getDomain();
+        nestedViewLoop(view, 0, [&]<typename... Idx>(const Idx... args) {
+            const std::array<long, Dim> local{static_cast<long>(args)...};
+            std::array<long, Dim> global;
+            bool owned = true, inside = true;
+            for (unsigned d = 0; d < Dim; d++) {
+                global[d] = lDom[d].first() - nghost + local[d];
+                owned     = owned && local[d] >= nghost && local[d] + nghost < long(view.extent(d));
+                inside    = inside && global[d] >= gDom[d].first() && global[d] <= gDom[d].last();
+            }
+            f(view(args...), global, owned, inside);
+        });
+    }
+
+    /*!
+     * Set the owned cells of a field to a value of their global index and the
+     * ghost cells to a sentinel, so that only an exchange can fill the halo
+     * @param value function of the global index giving the value of a cell
+     */
+    template <class Field, class Value>
+    static void initHalo(Field& field, Value&& value) {
+        auto mirror = field.getHostMirror();
+        forCells(field, mirror, [&](auto& cell, const auto& global, bool owned, bool) {
+            cell = owned ? value(global) : typename Field::value_type(-1);
+        });
+        Kokkos::deep_copy(field.getView(), mirror);
+    }
+
+    /*!
+     * Check that every cell inside the global domain, halo cells included,
+     * holds the value of its global index
+     * @param value function of the global index giving the value of a cell
+     */
+    template <class Field, class Value>
+    static void checkHalo(const Field& field, Value&& value) {
+        auto mirror = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), field.getView());
+        forCells(field, mirror, [&](const auto& cell, const auto& global, bool, bool inside) {
+            if (inside) {
+                expectCell(cell, value(global));
+            }
+        });
+    }
+
     Collection<mesh_type> meshes;
     Collection<layout_type> layouts;
     PtrCollection<std::shared_ptr, field_type> fields;
@@ -180,6 +259,211 @@ TYPED_TEST(HaloTest, FillHalo) {
     this->apply(check, this->fields);
 }
 
+TYPED_TEST(HaloTest, SplitPhaseFillHalo) {
+    auto check =
+        [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template field_type<Dim>>& field) {
+            auto value = [](const std::array<long, Dim>& g) {
+                return TestFixture::cellValue(g);
+            };
+            TestFixture::initHalo(*field, value);
+
+            field->beginFillHalo();
+            EXPECT_TRUE(field->isHaloPending());
+            field->endFillHalo();
+            EXPECT_FALSE(field->isHaloPending());
+
+            TestFixture::checkHalo(*field, value);
+        };
+
+    this->apply(check, this->fields);
+}
+
+TYPED_TEST(HaloTest, RepeatedFillHalo) {
+    auto check =
+        [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template field_type<Dim>>& field,
+                          typename TestFixture::template layout_type<Dim>& layout) {
+            using index_type = std::array<long, Dim>;
+
+            auto exchange = [&](int round) {
+                auto value = [&](const index_type& g) {
+                    return round * TestFixture::cellValue(g);
+                };
+                TestFixture::initHalo(*field, value);
+                field->fillHalo();
+                TestFixture::checkHalo(*field, value);
+            };
+
+            // the communication schedule built by the first exchange is reused
+            for (int round = 1; round <= 3; ++round) {
+                exchange(round);
+            }
+
+            // a new decomposition invalidates the schedule: the inner boundaries
+            // along the first axis move down by one cell
+            const unsigned long long version = layout.getVersion();
+            const ippl::Index& axis          = layout.getDomain()[0];
+            auto hostDomains                 = layout.getHostLocalDomains();
+            std::vector<ippl::NDIndex<Dim>> domains(hostDomains.extent(0));
+            for (size_t r = 0; r < domains.size(); ++r) {
+                domains[r] = hostDomains(r);
+                int first  = domains[r][0].first();
+                int last   = domains[r][0].last();
+                if (first > axis.first()) {
+                    --first;
+                }
+                if (last < axis.last()) {
+                    --last;
+                }
+                domains[r][0] = ippl::Index(first, last);
+            }
+            layout.updateLayout(domains);
+            EXPECT_NE(layout.getVersion(), version);
+
+            field->updateLayout(layout);
+            for (int round = 4; round <= 5; ++round) {
+                exchange(round);
+            }
+        };
+
+    this->apply(check, this->fields, this->layouts);
+}
+
+TYPED_TEST(HaloTest, SweepExchange) {
+    auto check = [&]<unsigned Dim>(
+                     std::shared_ptr<typename TestFixture::template field_type<Dim>>& field) {
+        using field_type  = typename TestFixture::template field_type<Dim>;
+        using layout_type = typename TestFixture::template layout_type<Dim>;
+
+        ippl::e_dim_tag domDec[Dim];
+        for (unsigned d = 0; d < Dim; d++) {
+            domDec[d] = ippl::PARALLEL;
+        }
+
+        for (bool periodic : {false, true}) {
+            layout_type layout(field->getDomain(), domDec, periodic);
+            field_type neighbor(field->get_mesh(), layout), sweep(field->get_mesh(), layout);
+            sweep.setHaloExchange(ippl::HaloExchange::SWEEP);
+
+            const unsigned int nghost     = neighbor.getNghost();
+            const ippl::NDIndex<Dim> lDom = layout.getLocalNDIndex();
+            int offset                    = 0;
+            for (unsigned d = 0; d < Dim; d++) {
+                offset += lDom[d].first();
+            }
+
+            // small integers, which are summed exactly in any order
+            auto mirror = neighbor.getHostMirror();
+            auto init   = [&](bool ghosts) {
+                this->template nestedViewLoop(mirror, 0, [&]<typename... Idx>(const Idx... args) {
+                    const std::array<size_t, Dim> index{static_cast<size_t>(args)...};
+                    bool owned = true;
+                    for (unsigned d = 0; d < Dim; d++) {
+                        owned = owned && index[d] >= nghost && index[d] < mirror.extent(d) - nghost;
+                    }
+                    mirror(args...) = owned || ghosts ? TypeParam((offset + (args + ...)) % 7 + 1)
+                                                      : TypeParam(-1);
+                });
+                Kokkos::deep_copy(neighbor.getView(), mirror);
+                Kokkos::deep_copy(sweep.getView(), mirror);
+            };
+            auto result = neighbor.getHostMirror();
+
+            // the edges and vertices are filled through the faces
+            init(false);
+            neighbor.fillHalo();
+            sweep.fillHalo();
+            Kokkos::deep_copy(mirror, neighbor.getView());
+            Kokkos::deep_copy(result, sweep.getView());
+            this->template nestedViewLoop(mirror, 0, [&]<typename... Idx>(const Idx... args) {
+                assertTypeParam<TypeParam>(result(args...), mirror(args...));
+            });
+
+            // the contributions of the edges and vertices reach their owners
+            init(true);
+            neighbor.accumulateHalo();
+            sweep.accumulateHalo();
+            Kokkos::deep_copy(mirror, neighbor.getView());
+            Kokkos::deep_copy(result, sweep.getView());
+            this->template nestedViewLoop(mirror, nghost, [&]<typename... Idx>(const Idx... args) {
+                assertTypeParam<TypeParam>(result(args...), mirror(args...));
+            });
+        }
+    };
+
+    this->apply(check, this->fields);
+}
+
+TYPED_TEST(HaloTest, BatchedFillHalo) {
+    auto check = [&]<unsigned Dim>(
+                     std::shared_ptr<typename TestFixture::template field_type<Dim>>& field) {
+        using field_type  = typename TestFixture::template field_type<Dim>;
+        using mesh_type   = typename TestFixture::template mesh_type<Dim>;
+        using layout_type = typename TestFixture::template layout_type<Dim>;
+        using vector_type = ippl::Vector<TypeParam, Dim>;
+        using vfield_type =
+            ippl::Field<vector_type, Dim, mesh_type, typename mesh_type::DefaultCentering>;
+        using index_type = std::array<long, Dim>;
+
+        // fields of different types travel in the same messages; each field and
+        // component gets other values, so that a wrong offset or stride shows
+        auto first  = [](const index_type& g) { return TestFixture::cellValue(g); };
+        auto second = [](const index_type& g) { return 200 + TestFixture::cellValue(g); };
+        auto third  = [](const index_type& g) {
+            vector_type v;
+            for (unsigned d = 0; d < Dim; d++) {
+                v[d] = 400 + 200 * d + TestFixture::cellValue(g);
+            }
+            return v;
+        };
+
+        ippl::e_dim_tag domDec[Dim];
+        for (unsigned d = 0; d < Dim; d++) {
+            domDec[d] = ippl::PARALLEL;
+        }
+
+        for (bool periodic : {false, true}) {
+            layout_type layout(field->getDomain(), domDec, periodic);
+            auto& mesh = field->get_mesh();
+            field_type a(mesh, layout), b(mesh, layout);
+            vfield_type c(mesh, layout);
+
+            auto init = [&]() {
+                TestFixture::initHalo(a, first);
+                TestFixture::initHalo(b, second);
+                TestFixture::initHalo(c, third);
+            };
+
+            init();
+            ippl::fillHalo(a, b, c);
+            if (!periodic) {
+                TestFixture::checkHalo(a, first);
+                TestFixture::checkHalo(b, second);
+                TestFixture::checkHalo(c, third);
+            }
+
+            // the batched exchange gives the same halos as one exchange per field
+            auto batchedA = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), a.getView());
+            auto batchedB = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), b.getView());
+            auto batchedC = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), c.getView());
+
+            init();
+            a.fillHalo();
+            b.fillHalo();
+            c.fillHalo();
+            auto viewA = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), a.getView());
+            auto viewB = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), b.getView());
+            auto viewC = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), c.getView());
+            this->template nestedViewLoop(viewA, 0, [&]<typename... Idx>(const Idx... args) {
+                TestFixture::expectCell(batchedA(args...), viewA(args...));
+                TestFixture::expectCell(batchedB(args...), viewB(args...));
+                TestFixture::expectCell(batchedC(args...), viewC(args...));
+            });
+        }
+    };
+
+    this->apply(check, this->fields);
+}
+
 TYPED_TEST(HaloTest, AccumulateHalo) {
     auto check = [&]<unsigned Dim>(
                      std::shared_ptr<typename TestFixture::template field_type<Dim>>& field,
@@ -167,13 +167,11 @@ public:
 TEST_F(ORBTest, Volume) {
     auto check = [&]<unsigned Dim>(playout_type<Dim>& pl, std::shared_ptr<bunch_type<Dim>>& bunch) {
         ippl::NDIndex<Dim> dom = getDomain<Dim>();
-        bunch_type<Dim> buffer(pl);
-
-        pl.update(*bunch, buffer);
+        pl.update(*bunch);
 
         repartition<Dim>();
 
-        pl.update(*bunch, buffer);
+        pl.update(*bunch);
 
         ippl::NDIndex<Dim> ndom = getDomain<Dim>();
 
@@ -186,17 +184,15 @@ TEST_F(ORBTest, Volume) {
 TEST_F(ORBTest, Charge) {
     auto check = [&]<unsigned Dim>(std::shared_ptr<field_type<Dim>>& field,
                                    std::shared_ptr<bunch_type<Dim>>& bunch, playout_type<Dim>& pl) {
-        bunch_type<Dim> buffer(pl);
-
         double charge = 0.5;
 
         bunch->Q = charge;
 
-        pl.update(*bunch, buffer);
+        pl.update(*bunch);
 
         repartition<Dim>();
 
-        pl.update(*bunch, buffer);
+        pl.update(*bunch);
 
         *field = 0.0;
         scatter(bunch->Q, *field, bunch->R);
@@ -33,6 +33,10 @@ public:
     template <unsigned Dim>
     using field_type = ippl::Field<double, Dim, mesh_type<Dim>, centering_type<Dim>>;
 
+    template <unsigned Dim>
+    using vfield_type =
+        ippl::Field<ippl::Vector<double, Dim>, Dim, mesh_type<Dim>, centering_type<Dim>>;
+
     template <unsigned Dim>
     using flayout_type = ippl::FieldLayout<Dim>;
 
@@ -44,12 +48,14 @@ public:
         Bunch(PLayout& playout)
             : ippl::ParticleBase<PLayout>(playout) {
             this->addAttribute(Q);
+            this->addAttribute(J);
         }
 
         ~Bunch() {}
 
         typedef ippl::ParticleAttrib<double> charge_container_type;
         charge_container_type Q;
+        ippl::SoAParticleAttrib<double, PLayout::dim> J;
     };
 
     template <unsigned Dim>
@@ -138,8 +144,7 @@ TEST_F(PICTest, Scatter) {
 
         bunch->Q = charge;
 
-        bunch_type<Dim> bunchBuffer(pl);
-        pl.update(*bunch, bunchBuffer);
+        pl.update(*bunch);
 
         scatter(bunch->Q, *field, bunch->R);
 
@@ -151,6 +156,162 @@ TEST_F(PICTest, Scatter) {
     apply(check, fields, bunches, playouts);
 }
 
+TEST_F(PICTest, SoAScatter) {
+    auto check = [&]<unsigned Dim>(std::shared_ptr<field_type<Dim>>& field,
+                                   std::shared_ptr<bunch_type<Dim>>& bunch, playout_type<Dim>& pl) {
+        vfield_type<Dim> vfield(field->get_mesh(), field->getLayout());
+        vfield = 0.0;
+        *field = 0.0;
+
+        ippl::Vector<double, Dim> current;
+        for (unsigned d = 0; d < Dim; d++) {
+            current[d] = 0.5 * (d + 1);
+        }
+        bunch->Q = 1.0;
+        bunch->J = current;
+
+        pl.update(*bunch);
+
+        // each component deposits like a scalar attribute scaled by the component
+        scatter(bunch->Q, *field, bunch->R);
+        scatter(bunch->J, vfield, bunch->R);
+
+        auto host  = field->getHostMirror();
+        auto vhost = vfield.getHostMirror();
+        Kokkos::deep_copy(host, field->getView());
+        Kokkos::deep_copy(vhost, vfield.getView());
+        for (size_t k = 0; k < host.size(); k++) {
+            for (unsigned d = 0; d < Dim; d++) {
+                ASSERT_NEAR(vhost.data()[k][d], current[d] * host.data()[k], 1e-13);
+            }
+        }
+    };
+
+    apply(check, fields, bunches, playouts);
+}
+
+TEST_F(PICTest, ScatterStrategies) {
+    auto check = [&]<unsigned Dim>(std::shared_ptr<field_type<Dim>>& field,
+                                   std::shared_ptr<bunch_type<Dim>>& bunch, playout_type<Dim>& pl) {
+        pl.update(*bunch);
+        bunch->sort(*field);
+
+        auto Q_host = bunch->Q.getHostMirror();
+        std::mt19937_64 eng(ippl::Comm->rank());
+        std::uniform_real_distribution<double> unif(0.5, 1.5);
+        for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+            Q_host(i) = unif(eng);
+        }
+        Kokkos::deep_copy(bunch->Q.getView(), Q_host);
+
+        *field = 0.0;
+        scatter(bunch->Q, *field, bunch->R, ippl::AtomicScatter{});
+        auto expected = field->getHostMirror();
+        Kokkos::deep_copy(expected, field->getView());
+
+        auto compare = [&](const auto& strategy) {
+            *field = 0.0;
+            scatter(bunch->Q, *field, bunch->R, strategy);
+            auto result = field->getHostMirror();
+            Kokkos::deep_copy(result, field->getView());
+
+            nestedViewLoop(result, 0, [&]<typename... Idx>(const Idx... args) {
+                ASSERT_NEAR(result(args...), expected(args...), 1e-13);
+            });
+        };
+
+        compare(ippl::DefaultScatter{});
+        compare(ippl::DuplicatedScatter{});
+        compare(ippl::SortedScatter{});
+        compare(ippl::TiledScatter{});
+
+        // tiles too small for any chunk fall back to atomics
+        ippl::TiledScatter tiny;
+        tiny.particlesPerTile = 3;
+        tiny.maxTileSize      = 1;
+        compare(tiny);
+    };
+
+    apply(check, fields, bunches, playouts);
+}
+
+TEST_F(PICTest, ShapeFunctions) {
+    auto check = [&]<unsigned Dim>(std::shared_ptr<field_type<Dim>>& field,
+                                   std::shared_ptr<bunch_type<Dim>>& bunch, playout_type<Dim>& pl) {
+        pl.update(*bunch);
+
+        // with periodic boundaries no stencil point is lost at the domain boundary
+        ippl::e_dim_tag domDec[Dim];
+        for (unsigned d = 0; d < Dim; d++) {
+            domDec[d] = ippl::PARALLEL;
+        }
+        flayout_type<Dim> layout(field->getLayout().getDomain(), domDec, true);
+        mesh_type<Dim> mesh = field->get_mesh();
+
+        auto test = [&]<typename Shape>(const Shape&) {
+            field_type<Dim> periodic(mesh, layout, Shape::nghost);
+
+            double charge = 0.5;
+            bunch->Q      = charge;
+            periodic      = 0.0;
+            scatter<Shape>(bunch->Q, periodic, bunch->R);
+
+            double totalcharge = periodic.sum();
+            ASSERT_NEAR((nParticles * charge - totalcharge) / (nParticles * charge), 0.0, 1e-13);
+
+            // the weights of every particle add up to one
+            periodic = 1.0;
+            bunch->Q = 0.0;
+            gather<Shape>(bunch->Q, periodic, bunch->R);
+            ASSERT_NEAR((nParticles - bunch->Q.sum()) / nParticles, 0.0, 1e-13);
+
+            // all strategies agree once the particles are sorted for the shape
+            bunch->template sort<Shape>(periodic);
+            bunch->Q = charge;
+            periodic = 0.0;
+            scatter<Shape>(bunch->Q, periodic, bunch->R, ippl::AtomicScatter{});
+            auto expected = periodic.getHostMirror();
+            Kokkos::deep_copy(expected, periodic.getView());
+
+            auto compare = [&](const auto& strategy) {
+                periodic = 0.0;
+                scatter<Shape>(bunch->Q, periodic, bunch->R, strategy);
+                auto result = periodic.getHostMirror();
+                Kokkos::deep_copy(result, periodic.getView());
+
+                nestedViewLoop(result, 0, [&]<typename... Idx>(const Idx... args) {
+                    ASSERT_NEAR(result(args...), expected(args...), 1e-13);
+                });
+            };
+
+            compare(ippl::DuplicatedScatter{});
+            compare(ippl::SortedScatter{});
+            compare(ippl::TiledScatter{});
+        };
+
+        // the stencils of the higher order shapes grow as width^Dim and are fully
+        // unrolled, so only the low dimensions are tested
+        if constexpr (Dim <= 3) {
+            test(ippl::CIC{});
+            test(ippl::TSC{});
+            // the halo exchange between ranks supports a single ghost layer
+            if (ippl::Comm->size() == 1) {
+                test(ippl::PCS{});
+            } else {
+                field_type<Dim> distributed(mesh, layout, ippl::PCS::nghost);
+                EXPECT_THROW(scatter<ippl::PCS>(bunch->Q, distributed, bunch->R), IpplException);
+            }
+
+            // the stencils do not fit into a single ghost layer
+            field_type<Dim> thin(mesh, layout, 1);
+            EXPECT_THROW(scatter<ippl::PCS>(bunch->Q, thin, bunch->R), IpplException);
+            EXPECT_THROW(gather<ippl::PCS>(bunch->Q, thin, bunch->R), IpplException);
+        }
+    };
+
+    apply(check, fields, bunches, playouts);
+}
+
 TEST_F(PICTest, Gather) {
     auto check = [&]<unsigned Dim>(std::shared_ptr<field_type<Dim>>& field,
                                    std::shared_ptr<bunch_type<Dim>>& bunch, playout_type<Dim>& pl) {
@@ -158,8 +319,7 @@ TEST_F(PICTest, Gather) {
 
         bunch->Q = 0.0;
 
-        bunch_type<Dim> bunchBuffer(pl);
-        pl.update(*bunch, bunchBuffer);
+        pl.update(*bunch);
 
         gather(bunch->Q, *field, bunch->R);
 
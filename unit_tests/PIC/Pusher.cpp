@@ -0,0 +1,242 @@
+//
+// Unit test PusherTest
+//   Test the fused field interpolation and particle push.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Ippl.h"
+
+#include <cmath>
+#include <random>
+
+#include "MultirankUtils.h"
+#include "gtest/gtest.h"
+
+/*!
+ * External field depending on the position and the time
+ */
+struct LinearField {
+    template <typename VectorType>
+    KOKKOS_INLINE_FUNCTION VectorType operator()(const VectorType& R, double time) const {
+        return time * R;
+    }
+};
+
+/*!
+ * Uniform magnetic field along z
+ */
+struct UniformField {
+    double b;
+
+    template <typename VectorType>
+    KOKKOS_INLINE_FUNCTION VectorType operator()(const VectorType& /*R*/, double /*time*/) const {
+        VectorType B(0);
+        B[2] = b;
+        return B;
+    }
+};
+
+class PusherTest : public ::testing::Test, public MultirankUtils<1, 2, 3> {
+public:
+    template <unsigned Dim>
+    using mesh_type = ippl::UniformCartesian<double, Dim>;
+
+    template <unsigned Dim>
+    using centering_type = typename mesh_type<Dim>::DefaultCentering;
+
+    template <unsigned Dim>
+    using vector_type = ippl::Vector<double, Dim>;
+
+    template <unsigned Dim>
+    using field_type = ippl::Field<vector_type<Dim>, Dim, mesh_type<Dim>, centering_type<Dim>>;
+
+    template <unsigned Dim>
+    using flayout_type = ippl::FieldLayout<Dim>;
+
+    template <unsigned Dim>
+    using playout_type = ippl::ParticleSpatialLayout<double, Dim>;
+
+    template <class PLayout>
+    struct Bunch : public ippl::ParticleBase<PLayout> {
+        Bunch(PLayout& playout)
+            : ippl::ParticleBase<PLayout>(playout) {
+            this->addAttribute(P);
+            this->addAttribute(E);
+        }
+
+        ~Bunch() {}
+
+        typename ippl::ParticleBase<PLayout>::particle_position_type P;
+        typename ippl::ParticleBase<PLayout>::particle_position_type E;
+    };
+
+    template <unsigned Dim>
+    using bunch_type = Bunch<playout_type<Dim>>;
+
+    PusherTest()
+        : nParticles(32) {
+        computeGridSizes(nPoints);
+        for (unsigned d = 0; d < MaxDim; d++) {
+            domain[d] = nPoints[d] / 16.;
+        }
+        setup(this);
+    }
+
+    template <unsigned Idx, unsigned Dim>
+    void setupDim() {
+        std::array<ippl::Index, Dim> args;
+        for (unsigned d = 0; d < Dim; d++) {
+            args[d] = ippl::Index(nPoints[d]);
+        }
+        auto owned = std::make_from_tuple<ippl::NDIndex<Dim>>(args);
+
+        vector_type<Dim> hx;
+        vector_type<Dim> origin;
+
+        ippl::e_dim_tag domDec[Dim];  // Specifies SERIAL, PARALLEL dims
+        for (unsigned int d = 0; d < Dim; d++) {
+            domDec[d] = ippl::PARALLEL;
+            hx[d]     = domain[d] / nPoints[d];
+            origin[d] = 0;
+        }
+
+        auto& layout = std::get<Idx>(layouts) = flayout_type<Dim>(owned, domDec);
+        auto& mesh = std::get<Idx>(meshes) = mesh_type<Dim>(owned, hx, origin);
+
+        std::get<Idx>(fields) = std::make_unique<field_type<Dim>>(mesh, layout);
+
+        auto& pl = std::get<Idx>(playouts) = playout_type<Dim>(layout, mesh);
+
+        auto& bunch = std::get<Idx>(bunches) = std::make_unique<bunch_type<Dim>>(pl);
+
+        size_t nloc = nParticles / ippl::Comm->size();
+        bunch->create(nloc);
+
+        std::mt19937_64 eng;
+        eng.seed(42);
+        eng.discard(nloc * ippl::Comm->rank());
+
+        auto R_host = bunch->R.getHostMirror();
+        for (size_t i = 0; i < nloc; ++i) {
+            for (unsigned d = 0; d < Dim; d++) {
+                std::uniform_real_distribution<double> unif(hx[0] / 2, domain[d] - (hx[0] / 2));
+                R_host(i)[d] = unif(eng);
+            }
+        }
+
+        Kokkos::deep_copy(bunch->R.getView(), R_host);
+        pl.update(*bunch);
+    }
+
+    PtrCollection<std::shared_ptr, field_type> fields;
+    PtrCollection<std::shared_ptr, bunch_type> bunches;
+    size_t nParticles;
+    size_t nPoints[MaxDim];
+    double domain[MaxDim];
+    Collection<playout_type> playouts;
+
+private:
+    Collection<flayout_type> layouts;
+    Collection<mesh_type> meshes;
+};
+
+TEST_F(PusherTest, LeapfrogKickDrift) {
+    auto check = [&]<unsigned Dim>(std::shared_ptr<field_type<Dim>>& field,
+                                   std::shared_ptr<bunch_type<Dim>>& bunch, playout_type<Dim>& pl) {
+        vector_type<Dim> E0, P0;
+        for (unsigned d = 0; d < Dim; d++) {
+            E0[d] = 1.0 + d;
+            P0[d] = 0.5 - d;
+        }
+        *field   = E0;
+        bunch->P = P0;
+
+        auto R0 = bunch->R.getHostMirror();
+        Kokkos::deep_copy(R0, bunch->R.getView());
+
+        const double chargeToMass = -2.0, dtKick = 0.25, dtDrift = 1e-3, time = 3.0;
+        ippl::ParticlePusher<ippl::Leapfrog<LinearField>> pusher({chargeToMass});
+        pusher.kickDrift(*field, bunch->P, bunch->R, dtKick, dtDrift, time);
+
+        auto R_host = bunch->R.getHostMirror();
+        auto P_host = bunch->P.getHostMirror();
+        Kokkos::deep_copy(R_host, bunch->R.getView());
+        Kokkos::deep_copy(P_host, bunch->P.getView());
+        for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+            for (unsigned d = 0; d < Dim; d++) {
+                double p = P0[d] + chargeToMass * dtKick * (E0[d] + time * R0(i)[d]);
+                ASSERT_NEAR(P_host(i)[d], p, 1e-12);
+                ASSERT_NEAR(R_host(i)[d], R0(i)[d] + dtDrift * p, 1e-12);
+            }
+        }
+
+        // the kick stores the total field only on request and leaves the positions alone
+        pl.update(*bunch);
+        Kokkos::deep_copy(R0, bunch->R.getView());
+
+        bunch->E = 0.0;
+        pusher.kick(*field, bunch->P, bunch->R, dtKick, time, bunch->E);
+
+        auto E_host = bunch->E.getHostMirror();
+        Kokkos::deep_copy(E_host, bunch->E.getView());
+        Kokkos::deep_copy(R_host, bunch->R.getView());
+        for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+            for (unsigned d = 0; d < Dim; d++) {
+                ASSERT_NEAR(E_host(i)[d], E0[d] + time * R0(i)[d], 1e-12);
+                ASSERT_DOUBLE_EQ(R_host(i)[d], R0(i)[d]);
+            }
+        }
+    };
+
+    apply(check, fields, bunches, playouts);
+}
+
+TEST_F(PusherTest, BorisRotation) {
+    auto check = [&]<unsigned Dim>(std::shared_ptr<field_type<Dim>>& field,
+                                   std::shared_ptr<bunch_type<Dim>>& bunch, playout_type<Dim>&) {
+        if constexpr (Dim == 3) {
+            *field   = 0.0;
+            bunch->P = vector_type<Dim>{1.0, 0.0, 0.5};
+
+            const double chargeToMass = 1.5, dt = 0.1, b = 2.0;
+            ippl::ParticlePusher<ippl::Boris<ippl::ZeroField, UniformField>> pusher(
+                {chargeToMass, ippl::ZeroField(), UniformField{b}});
+            pusher.kick(*field, bunch->P, bunch->R, dt);
+
+            // the Boris rotation conserves the speed and rotates by 2 atan(q/m dt B / 2)
+            const double angle = 2 * std::atan(0.5 * chargeToMass * dt * b);
+
+            auto P_host = bunch->P.getHostMirror();
+            Kokkos::deep_copy(P_host, bunch->P.getView());
+            for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+                ASSERT_NEAR(P_host(i)[0], std::cos(angle), 1e-14);
+                ASSERT_NEAR(P_host(i)[1], -std::sin(angle), 1e-14);
+                ASSERT_NEAR(P_host(i)[2], 0.5, 1e-14);
+            }
+        }
+    };
+
+    apply(check, fields, bunches, playouts);
+}
+
+int main(int argc, char* argv[]) {
+    int success = 1;
+    ippl::initialize(argc, argv);
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        success = RUN_ALL_TESTS();
+    }
+    ippl::finalize();
+    return success;
+}
@@ -0,0 +1,216 @@
+//
+// Unit test NeighborList
+//   Test the cell-linked and Verlet neighbor lists against a direct search.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Ippl.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+template <typename T>
+class NeighborListTest : public ::testing::Test {
+public:
+    static constexpr unsigned Dim = 3;
+
+    using mesh_type    = ippl::UniformCartesian<T, Dim>;
+    using flayout_type = ippl::FieldLayout<Dim>;
+    using playout_type = ippl::ParticleSpatialLayout<T, Dim>;
+    using bunch_type   = ippl::ParticleBase<playout_type>;
+    using vector_type  = ippl::Vector<T, Dim>;
+
+    NeighborListTest()
+        : nPoints(16)
+        , nParticles(512) {
+        ippl::Index I(nPoints);
+        ippl::NDIndex<Dim> owned(I, I, I);
+        ippl::e_dim_tag domDec[Dim] = {ippl::PARALLEL, ippl::PARALLEL, ippl::PARALLEL};
+
+        vector_type hx     = 1.0 / nPoints;
+        vector_type origin = 0;
+
+        layout  = flayout_type(owned, domDec);
+        mesh    = mesh_type(owned, hx, origin);
+        playout = playout_type(layout, mesh);
+        bunch   = std::make_shared<bunch_type>(playout);
+
+        typename bunch_type::bc_container_type bcs;
+        bcs.fill(ippl::BC::PERIODIC);
+        bunch->setParticleBC(bcs);
+
+        bunch->create(nParticles);
+        std::mt19937_64 eng(ippl::Comm->rank());
+        std::uniform_real_distribution<T> unif(0, 1);
+        auto R_host = bunch->R.getHostMirror();
+        for (size_t i = 0; i < nParticles; ++i) {
+            for (unsigned d = 0; d < Dim; ++d) {
+                R_host(i)[d] = unif(eng);
+            }
+        }
+        Kokkos::deep_copy(bunch->R.getView(), R_host);
+        bunch->update();
+    }
+
+    /*!
+     * Count the neighbors of every local particle within the cutoff by testing
+     * all particles of all ranks and their periodic images
+     * @param local the number of local neighbors of each particle (output)
+     * @param ghost the number of neighbors on other ranks or in images (output)
+     */
+    void directSearch(T cutoff, std::vector<size_t>& local, std::vector<size_t>& ghost) {
+        const int nRanks = ippl::Comm->size();
+        const int myRank = ippl::Comm->rank();
+
+        int localnum = bunch->getLocalNum();
+        std::vector<int> counts(nRanks), displs(nRanks, 0);
+        MPI_Allgather(&localnum, 1, MPI_INT, counts.data(), 1, MPI_INT,
+                      ippl::Comm->getCommunicator());
+        for (int rank = 0; rank < nRanks; ++rank) {
+            counts[rank] *= sizeof(vector_type);
+            if (rank > 0) {
+                displs[rank] = displs[rank - 1] + counts[rank - 1];
+            }
+        }
+        std::vector<vector_type> all((displs.back() + counts.back()) / sizeof(vector_type));
+        auto R_host = bunch->R.getHostMirror();
+        Kokkos::deep_copy(R_host, bunch->R.getView());
+        MPI_Allgatherv(R_host.data(), counts[myRank], MPI_BYTE, all.data(), counts.data(),
+                       displs.data(), MPI_BYTE, ippl::Comm->getCommunicator());
+
+        local.assign(localnum, 0);
+        ghost.assign(localnum, 0);
+        const size_t first = displs[myRank] / sizeof(vector_type);
+        for (size_t j = 0; j < all.size(); ++j) {
+            const bool owned = j >= first && j < first + localnum;
+            for (int c = 0; c < 27; ++c) {
+                vector_type y = all[j];
+                int code      = c;
+                for (unsigned d = 0; d < Dim; ++d, code /= 3) {
+                    y[d] += code % 3 - 1;
+                }
+                for (int i = 0; i < localnum; ++i) {
+                    T r2 = 0;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        r2 += (R_host(i)[d] - y[d]) * (R_host(i)[d] - y[d]);
+                    }
+                    if (r2 > cutoff * cutoff || (owned && c == 13 && j - first == size_t(i))) {
+                        continue;
+                    }
+                    if (owned && c == 13) {
+                        ++local[i];
+                    } else {
+                        ++ghost[i];
+                    }
+                }
+            }
+        }
+    }
+
+    const size_t nPoints;
+    const size_t nParticles;
+
+    flayout_type layout;
+    mesh_type mesh;
+    playout_type playout;
+    std::shared_ptr<bunch_type> bunch;
+};
+
+using Precisions = ::testing::Types<double, float>;
+
+TYPED_TEST_CASE(NeighborListTest, Precisions);
+
+TYPED_TEST(NeighborListTest, FullList) {
+    const TypeParam cutoff = 0.15, skin = 0.05;
+
+    this->playout.updateGhosts(*this->bunch, cutoff, skin);
+    ippl::NeighborList<TypeParam, 3> list(cutoff, skin, ippl::NeighborListType::Full);
+    ASSERT_TRUE(list.update(*this->bunch));
+
+    const size_t localnum = this->bunch->getLocalNum();
+    Kokkos::View<int*> counts("neighbor counts", localnum);
+    list.for_each_pair(*this->bunch, cutoff,
+                       KOKKOS_LAMBDA(const size_t i, const size_t, const auto&) { ++counts(i); });
+
+    std::vector<size_t> local, ghost;
+    this->directSearch(cutoff, local, ghost);
+
+    auto counts_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), counts);
+    for (size_t i = 0; i < localnum; ++i) {
+        EXPECT_EQ(size_t(counts_host(i)), local[i] + ghost[i]);
+    }
+}
+
+TYPED_TEST(NeighborListTest, HalfList) {
+    const TypeParam cutoff = 0.15, skin = 0.05;
+
+    this->playout.updateGhosts(*this->bunch, cutoff, skin);
+    ippl::NeighborList<TypeParam, 3> list(cutoff, skin);
+    list.build(*this->bunch);
+
+    const size_t localnum = this->bunch->getLocalNum();
+    Kokkos::View<int*> counts("neighbor counts", localnum);
+    list.for_each_pair(*this->bunch, cutoff,
+                       KOKKOS_LAMBDA(const size_t i, const size_t j, const auto&) {
+                           Kokkos::atomic_increment(&counts(i));
+                           if (j < localnum) {
+                               Kokkos::atomic_increment(&counts(j));
+                           }
+                       });
+
+    std::vector<size_t> local, ghost;
+    this->directSearch(cutoff, local, ghost);
+
+    // every local pair is visited once and updates both particles
+    auto counts_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), counts);
+    for (size_t i = 0; i < localnum; ++i) {
+        EXPECT_EQ(size_t(counts_host(i)), local[i] + ghost[i]);
+    }
+}
+
+TYPED_TEST(NeighborListTest, Rebuild) {
+    const TypeParam cutoff = 0.15, skin = 0.05;
+
+    this->playout.updateGhosts(*this->bunch, cutoff, skin);
+    ippl::NeighborList<TypeParam, 3> list(cutoff, skin);
+    ASSERT_TRUE(list.update(*this->bunch));
+    ASSERT_FALSE(list.update(*this->bunch));
+
+    // the list is kept until a particle has moved by half the skin
+    auto move = [&](TypeParam dx) {
+        auto positions = this->bunch->R.getView();
+        Kokkos::parallel_for(
+            "Displace particles", this->bunch->getLocalNum(),
+            KOKKOS_LAMBDA(const size_t i) { positions(i)[0] += dx; });
+        Kokkos::fence();
+    };
+
+    move(0.2 * skin);
+    ASSERT_FALSE(list.update(*this->bunch));
+    move(0.4 * skin);
+    ASSERT_TRUE(list.update(*this->bunch));
+    ASSERT_EQ(list.getBuildCount(), 2u);
+}
+
+int main(int argc, char* argv[]) {
+    int success = 1;
+    ippl::initialize(argc, argv);
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        success = RUN_ALL_TESTS();
+    }
+    ippl::finalize();
+    return success;
+}
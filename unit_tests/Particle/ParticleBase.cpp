@@ -94,6 +94,182 @@ TYPED_TEST(ParticleBaseTest, CreateAndDestroy) {
     this->apply(check, this->pbases);
 }
 
+TYPED_TEST(ParticleBaseTest, DestroyStable) {
+    size_t nParticles = 1000;
+
+    auto check =
+        [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& pbase) {
+            pbase->create(nParticles);
+
+            auto R_host = pbase->R.getHostMirror();
+            for (size_t i = 0; i < nParticles; ++i) {
+                for (unsigned d = 0; d < Dim; d++) {
+                    R_host(i)[d] = i + d;
+                }
+            }
+            Kokkos::deep_copy(pbase->R.getView(), R_host);
+
+            auto ID_host = pbase->ID.getHostMirror();
+            Kokkos::deep_copy(ID_host, pbase->ID.getView());
+            std::vector<int> ids(ID_host.data(), ID_host.data() + nParticles);
+
+            // Delete every third particle, starting with the second one
+            typedef typename ippl::detail::ViewType<bool, 1>::view_type bool_type;
+            bool_type invalid("invalid", nParticles);
+            auto invalid_host = Kokkos::create_mirror(invalid);
+            size_t destroyNum = 0;
+            for (size_t i = 0; i < nParticles; ++i) {
+                invalid_host(i) = i % 3 == 1;
+                destroyNum += invalid_host(i);
+            }
+            Kokkos::deep_copy(invalid, invalid_host);
+
+            pbase->setCompactionOrder(ippl::CompactionOrder::Stable);
+            pbase->destroy(invalid, destroyNum);
+
+            ASSERT_EQ(pbase->getLocalNum(), nParticles - destroyNum);
+
+            // The remaining particles keep their order
+            Kokkos::deep_copy(R_host, pbase->R.getView());
+            Kokkos::deep_copy(ID_host, pbase->ID.getView());
+            size_t k = 0;
+            for (size_t i = 0; i < nParticles; ++i) {
+                if (i % 3 == 1) {
+                    continue;
+                }
+                EXPECT_EQ(ID_host(k), ids[i]);
+                for (unsigned d = 0; d < Dim; d++) {
+                    EXPECT_EQ(R_host(k)[d], i + d);
+                }
+                ++k;
+            }
+        };
+
+    this->apply(check, this->pbases);
+}
+
+TYPED_TEST(ParticleBaseTest, DestroyTail) {
+    size_t nParticles = 1000;
+    size_t nKeep      = 600;
+
+    auto check =
+        [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& pbase) {
+            pbase->create(nParticles);
+
+            auto ID_host = pbase->ID.getHostMirror();
+            Kokkos::deep_copy(ID_host, pbase->ID.getView());
+            std::vector<int> ids(ID_host.data(), ID_host.data() + nParticles);
+
+            // Only particles behind the valid region are deleted, so nothing is moved
+            typedef typename ippl::detail::ViewType<bool, 1>::view_type bool_type;
+            bool_type invalid("invalid", nParticles);
+            auto invalid_host = Kokkos::create_mirror(invalid);
+            for (size_t i = 0; i < nParticles; ++i) {
+                invalid_host(i) = i >= nKeep;
+            }
+            Kokkos::deep_copy(invalid, invalid_host);
+
+            pbase->destroy(invalid, nParticles - nKeep);
+
+            ASSERT_EQ(pbase->getLocalNum(), nKeep);
+
+            Kokkos::deep_copy(ID_host, pbase->ID.getView());
+            for (size_t i = 0; i < nKeep; ++i) {
+                EXPECT_EQ(ID_host(i), ids[i]);
+            }
+        };
+
+    this->apply(check, this->pbases);
+}
+
+TYPED_TEST(ParticleBaseTest, DeferredDestroy) {
+    size_t nParticles = 1000;
+
+    auto check =
+        [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& pbase) {
+            using vector_type = typename TestFixture::template bunch_type<Dim>::vector_type;
+
+            pbase->create(nParticles);
+            pbase->enableDeferredDestroy(0.6);
+            pbase->R = vector_type(1.0);
+
+            // Delete every fourth particle, starting with the second one
+            typedef typename ippl::detail::ViewType<bool, 1>::view_type bool_type;
+            bool_type invalid("invalid", nParticles);
+            auto invalid_host = Kokkos::create_mirror(invalid);
+            for (size_t i = 0; i < nParticles; ++i) {
+                invalid_host(i) = i % 4 == 1;
+            }
+            Kokkos::deep_copy(invalid, invalid_host);
+            pbase->destroy(invalid, nParticles / 4);
+
+            // The particles are only marked
+            ASSERT_EQ(pbase->getLocalNum(), nParticles);
+            ASSERT_EQ(pbase->getDeadNum(), nParticles / 4);
+
+            // Dead particles are neither assigned nor reduced
+            pbase->R = vector_type(2.0);
+            auto R_host = pbase->R.getHostMirror();
+            Kokkos::deep_copy(R_host, pbase->R.getView());
+            for (size_t i = 0; i < nParticles; ++i) {
+                EXPECT_EQ(R_host(i)[0], i % 4 == 1 ? 1.0 : 2.0);
+            }
+
+            const int nRanks = ippl::Comm->size();
+            auto idSum       = [&](auto alive) {
+                typename TestFixture::template bunch_type<Dim>::index_type sum = 0;
+                for (int rank = 0; rank < nRanks; ++rank) {
+                    for (size_t i = 0; i < nParticles; ++i) {
+                        sum += alive(i) ? rank + nRanks * i : 0;
+                    }
+                }
+                return sum;
+            };
+            EXPECT_EQ(pbase->ID.sum(), idSum([](size_t i) { return i % 4 != 1; }));
+
+            // Marking dead particles again does not count them twice; the dead
+            // fraction stays below the threshold
+            for (size_t i = 0; i < nParticles; ++i) {
+                invalid_host(i) = i % 4 == 1 || i % 4 == 2;
+            }
+            Kokkos::deep_copy(invalid, invalid_host);
+            pbase->destroy(invalid, nParticles / 2);
+
+            ASSERT_EQ(pbase->getLocalNum(), nParticles);
+            ASSERT_EQ(pbase->getDeadNum(), nParticles / 2);
+
+            pbase->compact();
+
+            ASSERT_EQ(pbase->getLocalNum(), nParticles / 2);
+            ASSERT_EQ(pbase->getDeadNum(), size_t(0));
+            EXPECT_EQ(pbase->ID.sum(), idSum([](size_t i) { return i % 4 == 0 || i % 4 == 3; }));
+
+            Kokkos::deep_copy(R_host, pbase->R.getView());
+            for (size_t i = 0; i < pbase->getLocalNum(); ++i) {
+                EXPECT_EQ(R_host(i)[0], 2.0);
+            }
+
+            // New particles are alive; exceeding the threshold compacts the bunch
+            pbase->create(nParticles / 2);
+            pbase->R = vector_type(3.0);
+            Kokkos::deep_copy(R_host, pbase->R.getView());
+            for (size_t i = 0; i < nParticles; ++i) {
+                EXPECT_EQ(R_host(i)[0], 3.0);
+            }
+
+            for (size_t i = 0; i < nParticles; ++i) {
+                invalid_host(i) = i % 3 != 0;
+            }
+            Kokkos::deep_copy(invalid, invalid_host);
+            pbase->destroy(invalid, 666);
+
+            ASSERT_EQ(pbase->getLocalNum(), size_t(334));
+            ASSERT_EQ(pbase->getDeadNum(), size_t(0));
+        };
+
+    this->apply(check, this->pbases);
+}
+
 TYPED_TEST(ParticleBaseTest, AddAttribute) {
     auto check =
         [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& pbase) {
@@ -111,6 +287,196 @@ TYPED_TEST(ParticleBaseTest, AddAttribute) {
     this->apply(check, this->pbases);
 }
 
+TYPED_TEST(ParticleBaseTest, SoAAttribute) {
+    size_t nParticles = 1000;
+
+    auto check =
+        [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& pbase) {
+            using attrib_type = ippl::SoAParticleAttrib<TypeParam, Dim>;
+
+            attrib_type P;
+            pbase->addAttribute(P);
+            pbase->create(nParticles);
+
+            auto R_host = pbase->R.getHostMirror();
+            for (size_t i = 0; i < nParticles; ++i) {
+                for (unsigned d = 0; d < Dim; d++) {
+                    R_host(i)[d] = i + d;
+                }
+            }
+            Kokkos::deep_copy(pbase->R.getView(), R_host);
+
+            // expressions mix both storage orders
+            P = 2 * pbase->R + 1;
+            pbase->R = pbase->R + P;
+
+            // Delete all the particles with odd indices; all components move with them
+            typedef typename ippl::detail::ViewType<bool, 1>::view_type bool_type;
+            bool_type invalid("invalid", nParticles);
+            auto invalid_host = Kokkos::create_mirror(invalid);
+            for (size_t i = 0; i < nParticles; ++i) {
+                invalid_host(i) = i % 2 == 1;
+            }
+            Kokkos::deep_copy(invalid, invalid_host);
+            pbase->destroy(invalid, nParticles / 2);
+
+            auto P_host = P.getHostMirror();
+            Kokkos::deep_copy(P_host.getStorage(), P.getView().getStorage());
+            Kokkos::deep_copy(R_host, pbase->R.getView());
+            for (size_t i = 0; i < pbase->getLocalNum(); ++i) {
+                for (unsigned d = 0; d < Dim; d++) {
+                    EXPECT_EQ(R_host(i)[d], 3 * P_host(i)[d] / 2 - TypeParam(0.5));
+                }
+            }
+
+            // the components are reduced separately
+            const auto sum = P.sum();
+            for (unsigned d = 1; d < Dim; d++) {
+                EXPECT_EQ(sum[d] - sum[0], TypeParam(2 * d * nParticles / 2 * ippl::Comm->size()));
+            }
+        };
+
+    this->apply(check, this->pbases);
+}
+
+TYPED_TEST(ParticleBaseTest, FusedAssignment) {
+    size_t nParticles = 1000;
+
+    auto check =
+        [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& pbase) {
+            using vector_type = ippl::Vector<TypeParam, Dim>;
+
+            ippl::ParticleAttrib<vector_type> P;
+            ippl::SoAParticleAttrib<TypeParam, Dim> E;
+            ippl::ParticleAttrib<TypeParam> Q;
+            pbase->addAttribute(P);
+            pbase->addAttribute(E);
+            pbase->addAttribute(Q);
+            pbase->create(nParticles);
+
+            auto R_host = pbase->R.getHostMirror();
+            for (size_t i = 0; i < nParticles; ++i) {
+                for (unsigned d = 0; d < Dim; d++) {
+                    R_host(i)[d] = i + d;
+                }
+            }
+            Kokkos::deep_copy(pbase->R.getView(), R_host);
+            P = pbase->R;
+            E = 2 * pbase->R;
+
+            const TypeParam dt = 0.5;
+
+            // the second assignment sees the result of the first one
+            ippl::assign(ippl::deferred(P) = P + dt * E, ippl::deferred(E) = E + dt * P,
+                         ippl::deferred(Q) = 3);
+
+            auto P_host = P.getHostMirror();
+            auto E_host = E.getHostMirror();
+            auto Q_host = Q.getHostMirror();
+            Kokkos::deep_copy(P_host, P.getView());
+            Kokkos::deep_copy(E_host.getStorage(), E.getView().getStorage());
+            Kokkos::deep_copy(Q_host, Q.getView());
+            for (size_t i = 0; i < nParticles; ++i) {
+                for (unsigned d = 0; d < Dim; d++) {
+                    const TypeParam r = i + d;
+                    EXPECT_EQ(P_host(i)[d], 2 * r);
+                    EXPECT_EQ(E_host(i)[d], 3 * r);
+                }
+                EXPECT_EQ(Q_host(i), 3);
+            }
+
+            // attributes of different bunches cannot be assigned together, even if
+            // the bunches hold the same number of particles
+            ippl::ParticleAttrib<TypeParam> detached;
+            ippl::detail::size_type detachedNum = nParticles;
+            detached.setParticleCount(detachedNum);
+            EXPECT_THROW(ippl::assign(ippl::deferred(Q) = 1, ippl::deferred(detached) = 1),
+                         IpplException);
+        };
+
+    this->apply(check, this->pbases);
+}
+
+TYPED_TEST(ParticleBaseTest, Moments) {
+    size_t nParticles = 1000;
+
+    auto check =
+        [&]<unsigned Dim>(std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& pbase) {
+            ippl::SoAParticleAttrib<TypeParam, Dim> P;
+            ippl::ParticleAttrib<TypeParam> Q;
+            pbase->addAttribute(P);
+            pbase->addAttribute(Q);
+            pbase->create(nParticles);
+
+            auto R_host = pbase->R.getHostMirror();
+            for (size_t i = 0; i < nParticles; ++i) {
+                for (unsigned d = 0; d < Dim; d++) {
+                    R_host(i)[d] = i + d;
+                }
+            }
+            Kokkos::deep_copy(pbase->R.getView(), R_host);
+            P = 2 * pbase->R;
+            Q = 1;
+
+            // the last particle is deleted and must not contribute
+            pbase->enableDeferredDestroy(0.5);
+            typedef typename ippl::detail::ViewType<bool, 1>::view_type bool_type;
+            bool_type invalid("invalid", nParticles);
+            Kokkos::deep_copy(Kokkos::subview(invalid, std::make_pair(nParticles - 1, nParticles)),
+                              true);
+            pbase->destroy(invalid, 1);
+
+            const size_t nLive   = nParticles - 1;
+            const size_t nGlobal = nLive * ippl::Comm->size();
+
+            auto [count, sumQ, meanR, covRP, minR, maxP] = ippl::reduceMoments(
+                *pbase, ippl::moment::count(), ippl::moment::sum(Q), ippl::moment::mean(pbase->R),
+                ippl::moment::covariance(pbase->R, P), ippl::moment::min(pbase->R),
+                ippl::moment::max(P));
+
+            EXPECT_EQ(count, nGlobal);
+            EXPECT_EQ(sumQ, TypeParam(nGlobal));
+
+            // the coordinates are i + d with i uniform in [0, nLive)
+            const double variance = (double(nLive) * nLive - 1) / 12;
+            for (unsigned d = 0; d < Dim; d++) {
+                EXPECT_NEAR(meanR[d], TypeParam(nLive - 1) / 2 + d, 1e-3);
+                EXPECT_EQ(minR[d], TypeParam(d));
+                EXPECT_EQ(maxP[d], TypeParam(2 * (nLive - 1 + d)));
+                for (unsigned e = 0; e < Dim; e++) {
+                    EXPECT_NEAR(covRP[d][e], 2 * variance, 1e-3 * variance);
+                }
+            }
+
+            // the non-blocking variant gives the same result
+            auto request = ippl::reduceMomentsAsync(*pbase, ippl::moment::min(pbase->R),
+                                                    ippl::moment::secondMoment(Q, Q));
+
+            // single precision moments are still counted and summed in double precision
+            static_assert(std::is_same_v<typename decltype(request)::value_type, double>);
+            auto [minRAsync, sumQ2] = request.wait();
+            for (unsigned d = 0; d < Dim; d++) {
+                EXPECT_EQ(minRAsync[d], minR[d]);
+            }
+            EXPECT_EQ(sumQ2[0][0], 1);
+
+            // far from the origin the raw sums would lose the covariance to cancellation
+            const TypeParam offset = std::is_same_v<TypeParam, double> ? 1e9 : 1e6;
+            pbase->R               = pbase->R + offset;
+
+            auto [meanShifted, covRR] = ippl::reduceMoments(
+                *pbase, ippl::moment::mean(pbase->R), ippl::moment::covariance(pbase->R, pbase->R));
+            for (unsigned d = 0; d < Dim; d++) {
+                EXPECT_NEAR(meanShifted[d] - offset, TypeParam(nLive - 1) / 2 + d, 1e-3);
+                for (unsigned e = 0; e < Dim; e++) {
+                    EXPECT_NEAR(covRR[d][e], variance, 1e-3 * variance);
+                }
+            }
+        };
+
+    this->apply(check, this->pbases);
+}
+
 TEST(ParticleBase, Initialize1) {
     auto check_impl = [&]<typename T, unsigned Dim>() {
         typename ParticleBaseTest<T>::template playout_type<Dim> pl;
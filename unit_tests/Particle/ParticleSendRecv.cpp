@@ -158,8 +158,6 @@ public:
     size_t nPoints[MaxDim];
     T domain[MaxDim];
     Collection<playout_type> playouts;
-
-private:
     Collection<flayout_type> layouts;
     Collection<mesh_type> meshes;
 };
@@ -174,8 +172,7 @@ TYPED_TEST(ParticleSendRecv, SendAndRecieve) {
     auto check            = [&]<unsigned Dim>(
                      std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& bunch,
                      typename TestFixture::template playout_type<Dim>& pl) {
-        typename TestFixture::template bunch_type<Dim> bunchBuffer(pl);
-        pl.update(*bunch, bunchBuffer);
+        pl.update(*bunch);
         // bunch->update();
         typename TestFixture::rank_type::view_type::host_mirror_type ER_host =
             bunch->expectedRank.getHostMirror();
@@ -202,6 +199,321 @@ TYPED_TEST(ParticleSendRecv, SendAndRecieve) {
     this->apply(check, this->bunches, this->playouts);
 }
 
+TYPED_TEST(ParticleSendRecv, StableOrder) {
+    auto check = [&]<unsigned Dim>(
+                     std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& bunch,
+                     typename TestFixture::template playout_type<Dim>& pl) {
+        pl.update(*bunch);
+
+        // the particles from another rank arrive in the order they had there,
+        // and the IDs a rank assigns grow with the particle index
+        const int nRanks = ippl::Comm->size();
+        auto ID_host     = bunch->ID.getHostMirror();
+        Kokkos::deep_copy(ID_host, bunch->ID.getView());
+
+        std::vector<long> lastID(nRanks, -1);
+        for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+            const int source = ID_host(i) % nRanks;
+            if (source != ippl::Comm->rank()) {
+                ASSERT_GT(ID_host(i), lastID[source]);
+                lastID[source] = ID_host(i);
+            }
+        }
+    };
+
+    this->apply(check, this->bunches, this->playouts);
+}
+
+TYPED_TEST(ParticleSendRecv, SplitUpdate) {
+    const auto nParticles = this->nParticles;
+    auto check            = [&]<unsigned Dim>(
+                     std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& bunch,
+                     typename TestFixture::template playout_type<Dim>& pl) {
+        pl.beginUpdate(*bunch);
+
+        // only the particles staying on this rank are left while messages are in flight
+        auto ER_host = bunch->expectedRank.getHostMirror();
+        Kokkos::deep_copy(ER_host, bunch->expectedRank.getView());
+        for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+            ASSERT_EQ(ER_host(i), ippl::Comm->rank());
+        }
+
+        pl.finishUpdate(*bunch);
+
+        Kokkos::resize(ER_host, bunch->expectedRank.size());
+        Kokkos::deep_copy(ER_host, bunch->expectedRank.getView());
+        for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+            ASSERT_EQ(ER_host(i), ippl::Comm->rank());
+        }
+
+        unsigned int Total_particles = 0;
+        unsigned int local_particles = bunch->getLocalNum();
+
+        MPI_Allreduce(&local_particles, &Total_particles, 1, MPI_UNSIGNED, MPI_SUM,
+                      ippl::Comm->getCommunicator());
+
+        ASSERT_EQ(nParticles, Total_particles);
+    };
+
+    this->apply(check, this->bunches, this->playouts);
+}
+
+TYPED_TEST(ParticleSendRecv, LocateParticles) {
+    auto check = [&]<unsigned Dim>(
+                     std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& bunch,
+                     typename TestFixture::template playout_type<Dim>& pl) {
+        using playout_type = typename TestFixture::template playout_type<Dim>;
+
+        ASSERT_TRUE(pl.getRegionLayout().hasPartitionTree());
+
+        size_t localnum = bunch->getLocalNum();
+        typename playout_type::locate_type ranks("ranks", localnum);
+        typename playout_type::bool_type invalid("invalid", localnum);
+
+        size_t invalidCount = pl.locateParticles(*bunch, ranks, invalid);
+
+        auto ranks_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), ranks);
+        auto ER_host    = bunch->expectedRank.getHostMirror();
+        Kokkos::deep_copy(ER_host, bunch->expectedRank.getView());
+
+        size_t expectedInvalid = 0;
+        for (size_t i = 0; i < localnum; ++i) {
+            ASSERT_EQ(ranks_host(i), ER_host(i));
+            expectedInvalid += (ER_host(i) != ippl::Comm->rank());
+        }
+        ASSERT_EQ(invalidCount, expectedInvalid);
+    };
+
+    this->apply(check, this->bunches, this->playouts);
+}
+
+TYPED_TEST(ParticleSendRecv, DisplacementBound) {
+    const auto nParticles = this->nParticles;
+    auto check            = [&]<unsigned Dim>(
+                     std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& bunch,
+                     typename TestFixture::template playout_type<Dim>& pl) {
+        pl.update(*bunch);
+
+        // move every particle by a fraction of a cell; the periodic boundaries
+        // wrap the particles leaving the domain
+        const TypeParam dx = 0.25 / 16.;
+        auto positions     = bunch->R.getView();
+        Kokkos::parallel_for(
+            "Displace particles", bunch->getLocalNum(), KOKKOS_LAMBDA(const size_t i) {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    positions(i)[d] += (d % 2 ? -dx : dx);
+                }
+            });
+        Kokkos::fence();
+
+        size_t localnum = bunch->getLocalNum();
+        pl.setDisplacementBound(dx, 3);
+        pl.resetLocateCounters();
+        pl.update(*bunch);
+
+        if (ippl::Comm->size() > 1) {
+            ASSERT_EQ(pl.getTestedCount() + pl.getSkippedCount(), localnum);
+        }
+
+        const auto local = pl.getRegionLayout().gethLocalRegions()(ippl::Comm->rank());
+        auto checkLocal  = [&]() {
+            auto R_host = bunch->R.getHostMirror();
+            Kokkos::deep_copy(R_host, bunch->R.getView());
+            for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    ASSERT_GE(R_host(i)[d], local[d].min());
+                    ASSERT_LE(R_host(i)[d], local[d].max());
+                }
+            }
+        };
+        checkLocal();
+
+        auto checkTotal = [&]() {
+            unsigned int Total_particles = 0;
+            unsigned int local_particles = bunch->getLocalNum();
+
+            MPI_Allreduce(&local_particles, &Total_particles, 1, MPI_UNSIGNED, MPI_SUM,
+                          ippl::Comm->getCommunicator());
+
+            ASSERT_EQ(nParticles, Total_particles);
+        };
+
+        // particles moving further than the bound on one rank stay there until
+        // the third bounded update checks the bound on all ranks
+        if (ippl::Comm->rank() == 0) {
+            const TypeParam jump = 0.5 * pl.getRegionLayout().getDomain()[0].length();
+            auto moved           = bunch->R.getView();
+            Kokkos::parallel_for(
+                "Move particles far", bunch->getLocalNum(),
+                KOKKOS_LAMBDA(const size_t i) { moved(i)[0] += jump; });
+            Kokkos::fence();
+        }
+        pl.update(*bunch);
+        checkTotal();
+
+        // the check locates every particle on all ranks
+        pl.update(*bunch);
+        checkLocal();
+        checkTotal();
+    };
+
+    this->apply(check, this->bunches, this->playouts);
+}
+
+TYPED_TEST(ParticleSendRecv, Ghosts) {
+    const auto nParticles = this->nParticles;
+    auto check            = [&]<unsigned Dim>(
+                     std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& bunch,
+                     typename TestFixture::template playout_type<Dim>& pl) {
+        using vector_type = ippl::Vector<TypeParam, Dim>;
+
+        pl.update(*bunch);
+
+        const auto& domain = pl.getRegionLayout().getDomain();
+        TypeParam cutoff   = domain[0].length();
+        for (unsigned d = 1; d < Dim; ++d) {
+            cutoff = std::min(cutoff, domain[d].length());
+        }
+        cutoff *= 0.1;
+
+        pl.updateGhosts(*bunch, cutoff);
+
+        // gather all particles on every rank to count the expected ghosts
+        const int nRanks = ippl::Comm->size();
+        const int myRank = ippl::Comm->rank();
+        int localnum     = bunch->getLocalNum();
+        std::vector<int> counts(nRanks), displs(nRanks, 0);
+        MPI_Allgather(&localnum, 1, MPI_INT, counts.data(), 1, MPI_INT,
+                      ippl::Comm->getCommunicator());
+        for (int rank = 0; rank < nRanks; ++rank) {
+            counts[rank] *= sizeof(vector_type);
+            if (rank > 0) {
+                displs[rank] = displs[rank - 1] + counts[rank - 1];
+            }
+        }
+        std::vector<vector_type> all((displs.back() + counts.back()) / sizeof(vector_type));
+        auto R_host = bunch->R.getHostMirror();
+        Kokkos::deep_copy(R_host, bunch->R.getView());
+        MPI_Allgatherv(R_host.data(), counts[myRank], MPI_BYTE, all.data(), counts.data(),
+                       displs.data(), MPI_BYTE, ippl::Comm->getCommunicator());
+
+        const auto local = pl.getRegionLayout().gethLocalRegions()(myRank);
+        auto nearLocal   = [&](const vector_type& x) {
+            bool near = true;
+            for (unsigned d = 0; d < Dim; ++d) {
+                near &= x[d] >= local[d].min() - cutoff && x[d] <= local[d].max() + cutoff;
+            }
+            return near;
+        };
+
+        int nImages = 1;
+        for (unsigned d = 0; d < Dim; ++d) {
+            nImages *= 3;
+        }
+
+        size_t expected = 0;
+        for (int rank = 0; rank < nRanks; ++rank) {
+            for (int j = 0; j < counts[rank] / int(sizeof(vector_type)); ++j) {
+                const vector_type& x = all[displs[rank] / sizeof(vector_type) + j];
+                for (int c = 0; c < nImages; ++c) {
+                    vector_type y = x;
+                    int code      = c;
+                    for (unsigned d = 0; d < Dim; ++d, code /= 3) {
+                        y[d] += (code % 3 - 1) * domain[d].length();
+                    }
+                    if ((c != nImages / 2 || rank != myRank) && nearLocal(y)) {
+                        ++expected;
+                    }
+                }
+            }
+        }
+        ASSERT_EQ(pl.getGhostNum(), expected);
+
+        auto ghostR_host =
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), pl.getGhostPositions());
+        for (size_t i = 0; i < pl.getGhostNum(); ++i) {
+            ASSERT_TRUE(nearLocal(ghostR_host(i)));
+        }
+
+        // send the charges to the ghosts and return them to their owners
+        using playout_type = typename TestFixture::template playout_type<Dim>;
+        typename playout_type::template ghost_view_type<decltype(bunch->Q)> ghostQ;
+        pl.exchangeGhosts(bunch->Q, ghostQ);
+        ASSERT_EQ(ghostQ.extent(0), expected);
+        pl.accumulateGhosts(bunch->Q, ghostQ);
+
+        unsigned long ghosts = expected, totalGhosts = 0;
+        MPI_Allreduce(&ghosts, &totalGhosts, 1, MPI_UNSIGNED_LONG, MPI_SUM,
+                      ippl::Comm->getCommunicator());
+        ASSERT_EQ(bunch->Q.sum(), TypeParam(nParticles + totalGhosts));
+
+        // without an update in between, the schedule is reused
+        pl.updateGhosts(*bunch, cutoff);
+        ASSERT_EQ(pl.getGhostScheduleBuilds(), 1u);
+        ASSERT_EQ(pl.getGhostNum(), expected);
+    };
+
+    this->apply(check, this->bunches, this->playouts);
+}
+
+TYPED_TEST(ParticleSendRecv, Sort) {
+    auto check = [&]<unsigned Dim>(
+                     std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& bunch,
+                     typename TestFixture::template flayout_type<Dim>& layout,
+                     typename TestFixture::template mesh_type<Dim>& mesh) {
+        // tag every particle with its position to verify that all attributes move together
+        auto positions = bunch->R.getView();
+        auto Q         = bunch->Q.getView();
+        Kokkos::parallel_for(
+            "Tag particles", bunch->getLocalNum(),
+            KOKKOS_LAMBDA(const size_t i) { Q(i) = positions(i)[0]; });
+        Kokkos::fence();
+
+        size_t localnum = bunch->getLocalNum();
+        for (auto order : {ippl::SortOrder::Lexicographic, ippl::SortOrder::Morton}) {
+            bunch->sort(mesh, layout, order);
+
+            ASSERT_EQ(bunch->getLocalNum(), localnum);
+            ASSERT_EQ(bunch->sortDisorder(mesh, layout, order), 0);
+
+            auto R_host = bunch->R.getHostMirror();
+            auto Q_host = bunch->Q.getHostMirror();
+            Kokkos::deep_copy(R_host, bunch->R.getView());
+            Kokkos::deep_copy(Q_host, bunch->Q.getView());
+            for (size_t i = 0; i < localnum; ++i) {
+                ASSERT_EQ(Q_host(i), R_host(i)[0]);
+            }
+        }
+    };
+
+    this->apply(check, this->bunches, this->layouts, this->meshes);
+}
+
+TYPED_TEST(ParticleSendRecv, SortPolicy) {
+    auto check = [&]<unsigned Dim>(
+                     std::shared_ptr<typename TestFixture::template bunch_type<Dim>>& bunch,
+                     typename TestFixture::template playout_type<Dim>& pl,
+                     typename TestFixture::template flayout_type<Dim>& layout,
+                     typename TestFixture::template mesh_type<Dim>& mesh) {
+        ippl::ParticleSortPolicy policy;
+        policy.order       = ippl::SortOrder::Morton;
+        policy.maxDisorder = 0;
+        pl.setSortPolicy(policy);
+
+        pl.update(*bunch);
+
+        ASSERT_EQ(bunch->sortDisorder(mesh, layout, policy.order), 0);
+
+        auto ER_host = bunch->expectedRank.getHostMirror();
+        Kokkos::deep_copy(ER_host, bunch->expectedRank.getView());
+        for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+            ASSERT_EQ(ER_host(i), ippl::Comm->rank());
+        }
+    };
+
+    this->apply(check, this->bunches, this->playouts, this->layouts, this->meshes);
+}
+
 int main(int argc, char* argv[]) {
     int success = 1;
     ippl::initialize(argc, argv);
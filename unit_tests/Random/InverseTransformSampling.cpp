@@ -0,0 +1,170 @@
+//
+// Unit test InverseTransformSampling
+//   Test the distributions and the sampling of particle attributes.
+//
+// Copyright (c) 2023, Paul Scherrer Institut, Villigen PSI, Switzerland
+// All rights reserved
+//
+// This file is part of IPPL.
+//
+// IPPL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// You should have received a copy of the GNU General Public License
+// along with IPPL. If not, see <https://www.gnu.org/licenses/>.
+//
+#include "Ippl.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+class InverseTransformSamplingTest : public ::testing::Test {
+public:
+    static constexpr unsigned Dim = 2;
+
+    using vector_type  = ippl::Vector<double, Dim>;
+    using playout_type = ippl::detail::ParticleLayout<double, Dim>;
+    using bunch_type   = ippl::ParticleBase<playout_type>;
+    using dist_type    = ippl::random::CosinePerturbation<double>;
+    using sampler_type = ippl::random::InverseTransformSampling<double, Dim, dist_type>;
+
+    InverseTransformSamplingTest()
+        : pi(Kokkos::numbers::pi_v<double>) {
+        for (unsigned d = 0; d < Dim; ++d) {
+            dist[d] = {0.5, 2 * pi};
+        }
+    }
+
+    const double pi;
+    Kokkos::Array<dist_type, Dim> dist;
+    playout_type playout;
+};
+
+TEST_F(InverseTransformSamplingTest, NormalInverse) {
+    ippl::random::Normal<double> normal{1.0, 2.0};
+    for (double u : {1e-12, 1e-3, 0.02, 0.3, 0.5, 0.7, 0.99, 1 - 1e-9}) {
+        EXPECT_NEAR(normal.cdf(normal.inverse(u)) / u, 1.0, 1e-10);
+    }
+    EXPECT_TRUE(std::isfinite(normal.inverse(0.0)));
+    EXPECT_TRUE(std::isfinite(normal.inverse(1.0)));
+}
+
+TEST_F(InverseTransformSamplingTest, TabulatedInverse) {
+    std::vector<double> pdf = {0.0, 1.0, 3.0, 3.0, 0.5};
+    ippl::random::Tabulated<double, Kokkos::HostSpace> table(pdf, -1.0, 1.0);
+
+    EXPECT_DOUBLE_EQ(table.cdf(-2.0), 0.0);
+    EXPECT_DOUBLE_EQ(table.cdf(1.0), 0.5 * 0.5 * (0.0 + 2 * 1.0 + 2 * 3.0 + 2 * 3.0 + 0.5));
+    for (double x = -0.95; x < 1.0; x += 0.1) {
+        EXPECT_NEAR(table.inverse(table.cdf(x)), x, 1e-12);
+    }
+}
+
+TEST_F(InverseTransformSamplingTest, Distribution) {
+    const size_t n = 100000;
+    sampler_type sampler(dist, vector_type(0.0), vector_type(1.0), 42);
+
+    bunch_type bunch(playout);
+    bunch.create(n);
+    sampler.generate(bunch.R, n);
+
+    // for the density 1 + alpha * cos(k * x) on one period, <cos(k * x)> = alpha / 2
+    auto view = bunch.R.getView();
+    for (unsigned d = 0; d < Dim; ++d) {
+        double mean = 0;
+        Kokkos::parallel_reduce(
+            "mean cos", n,
+            KOKKOS_LAMBDA(const size_t i, double& sum) {
+                sum += Kokkos::cos(2 * Kokkos::numbers::pi_v<double> * view(i)[d]);
+            },
+            mean);
+        EXPECT_NEAR(mean / n, 0.25, 0.01);
+    }
+
+    auto R_host = bunch.R.getHostMirror();
+    Kokkos::deep_copy(R_host, view);
+    for (size_t i = 0; i < n; ++i) {
+        for (unsigned d = 0; d < Dim; ++d) {
+            ASSERT_GE(R_host(i)[d], 0.0);
+            ASSERT_LE(R_host(i)[d], 1.0);
+        }
+    }
+}
+
+TEST_F(InverseTransformSamplingTest, Reproducible) {
+    const size_t n = 1000;
+    sampler_type sampler(dist, vector_type(0.0), vector_type(1.0), 7);
+
+    // a single call and two calls for the two halves give the same samples
+    bunch_type A(playout), B(playout);
+    A.create(n);
+    B.create(n);
+    sampler.generate(A.R, n);
+    sampler.generate(B.R, n / 2);
+    sampler.generate(B.R, n - n / 2, n / 2);
+
+    auto A_host = A.R.getHostMirror();
+    auto B_host = B.R.getHostMirror();
+    Kokkos::deep_copy(A_host, A.R.getView());
+    Kokkos::deep_copy(B_host, B.R.getView());
+    for (size_t i = 0; i < n; ++i) {
+        for (unsigned d = 0; d < Dim; ++d) {
+            ASSERT_EQ(A_host(i)[d], B_host(i)[d]);
+        }
+    }
+}
+
+TEST_F(InverseTransformSamplingTest, LocalRegion) {
+    const size_t totalNum = 12345;
+    const int nRanks      = ippl::Comm->size();
+    const int rank        = ippl::Comm->rank();
+
+    // every rank owns a slab in the first dimension
+    sampler_type sampler(dist, vector_type(0.0), vector_type(1.0), 42);
+    vector_type locrmin = 0.0, locrmax = 1.0;
+    locrmin[0] = double(rank) / nRanks;
+    locrmax[0] = double(rank + 1) / nRanks;
+
+    size_t nloc = sampler.setLocalRegion(locrmin, locrmax, totalNum);
+    size_t nsum = 0;
+    MPI_Allreduce(&nloc, &nsum, 1, MPI_UNSIGNED_LONG, MPI_SUM, ippl::Comm->getCommunicator());
+    EXPECT_EQ(nsum, totalNum);
+
+    bunch_type bunch(playout);
+    bunch.create(nloc);
+    sampler.generate(bunch.R, nloc);
+
+    auto R_host = bunch.R.getHostMirror();
+    Kokkos::deep_copy(R_host, bunch.R.getView());
+    for (size_t i = 0; i < nloc; ++i) {
+        ASSERT_GE(R_host(i)[0], locrmin[0]);
+        ASSERT_LE(R_host(i)[0], locrmax[0]);
+    }
+}
+
+TEST_F(InverseTransformSamplingTest, LocalRegionSurplus) {
+    const size_t totalNum = 12345;
+
+    // overlapping regions claim more particles than there are; the surplus is
+    // taken away so that the total is still exact
+    sampler_type sampler(dist, vector_type(0.0), vector_type(1.0), 42);
+    size_t nloc = sampler.setLocalRegion(vector_type(0.0), vector_type(1.0), totalNum);
+    size_t nsum = 0;
+    MPI_Allreduce(&nloc, &nsum, 1, MPI_UNSIGNED_LONG, MPI_SUM, ippl::Comm->getCommunicator());
+    EXPECT_EQ(nsum, totalNum);
+    EXPECT_EQ(nloc, ippl::Comm->rank() == 0 ? totalNum : 0);
+}
+
+int main(int argc, char* argv[]) {
+    int success = 1;
+    ippl::initialize(argc, argv);
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        success = RUN_ALL_TESTS();
+    }
+    ippl::finalize();
+    return success;
+}